@@ -17,6 +17,9 @@
 #include "Drivers/delay_ms/delay_ms.h"
 #include "Drivers/rng/rng.h"
 #include "Drivers/uart/uart.h"
+#include "stse_platform_bench.h"
+#include "stse_platform_drbg.h"
+#include "stse_platform_ecc.h"
 #include "stselib.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -52,6 +55,9 @@ static void apps_print_hex_buffer(const uint8_t *buffer, uint16_t buffer_size);
 static uint32_t apps_generate_random_number(void);
 static void apps_randomize_buffer(uint8_t *pBuffer, uint16_t buffer_length);
 static uint8_t apps_compare_buffers(const uint8_t *pBuffer1, const uint8_t *pBuffer2, uint16_t buffers_length);
+#ifdef STSE_CONF_PLATFORM_BENCHMARK
+static void apps_print_benchmark(void);
+#endif
 
 /* --- Static Function Definitions --- */
 
@@ -95,8 +101,9 @@ static uint32_t apps_generate_random_number(void) {
  * @param  buffer_length: Number of bytes to fill
  */
 static void apps_randomize_buffer(uint8_t *pBuffer, uint16_t buffer_length) {
-    for (uint16_t i = 0; i < buffer_length; i++) {
-        pBuffer[i] = (uint8_t)(rng_generate_random_number() & 0xFF);
+    if (stse_platform_drbg_generate(STSE_PLATFORM_DRBG_PAYLOAD, pBuffer, buffer_length) != STSE_OK) {
+        /* Fall back on the hardware RNG */
+        rng_fill(pBuffer, buffer_length);
     }
 }
 
@@ -116,6 +123,42 @@ static uint8_t apps_compare_buffers(const uint8_t *pBuffer1, const uint8_t *pBuf
     return 0;
 }
 
+#ifdef STSE_CONF_PLATFORM_BENCHMARK
+/**
+ * @brief  Run the crypto platform benchmark and print one line per primitive.
+ */
+static void apps_print_benchmark(void) {
+    static stse_platform_bench_result_t results[STSE_PLATFORM_BENCH_MAX_RESULTS];
+    uint16_t count = stse_platform_bench_run(results, STSE_PLATFORM_BENCH_MAX_RESULTS);
+    uint8_t stack_overflow = 0;
+
+    printf("\n\r ## Crypto platform benchmark (%u iterations)", (unsigned)STSE_PLATFORM_BENCH_ITERATIONS);
+    printf("\n\r %-28s %-16s %10s %12s %10s %8s %8s", "primitive", "variant", "cycles/op", "bytes/kcycle", "cycles/B", "stack", "heap");
+    for (uint16_t i = 0; i < count; i++) {
+        if (results[i].status != STSE_OK) {
+            printf("\n\r %-28s %-16s ERROR 0x%04X", results[i].pName, results[i].pVariant, results[i].status);
+            continue;
+        }
+        stack_overflow |= results[i].stack_overflow;
+        printf("\n\r %-28s %-16s %10lu %12lu %8lu.%01lu %s%7lu %8lu",
+               results[i].pName,
+               results[i].pVariant,
+               (unsigned long)results[i].cycles,
+               (unsigned long)((results[i].cycles != 0) ? ((uint64_t)results[i].bytes * 1000U) / results[i].cycles : 0),
+               (unsigned long)((results[i].bytes != 0) ? results[i].cycles / results[i].bytes : 0),
+               (unsigned long)((results[i].bytes != 0) ? ((results[i].cycles * 10U) / results[i].bytes) % 10U : 0),
+               results[i].stack_overflow ? ">" : " ",
+               (unsigned long)results[i].stack_peak,
+               (unsigned long)results[i].heap_peak);
+    }
+    if (stack_overflow) {
+        printf("\n\r (>) stack use reached the %u bytes painted area : overflow, peak not measured",
+               (unsigned)STSE_PLATFORM_BENCH_STACK_PAINT_SIZE);
+    }
+    printf("\n\r");
+}
+#endif /* STSE_CONF_PLATFORM_BENCHMARK */
+
 void apps_process_error(uint32_t err)
 {
 	if (err == STSE_PLATFORM_BUS_ACK_ERROR) {
@@ -166,7 +209,16 @@ int main(void) {
         apps_process_error(stse_ret);
     }
 
+#ifdef STSE_CONF_PLATFORM_BENCHMARK
+    apps_print_benchmark();
+#endif
+
     while (1) {
+#ifdef STSE_CONF_PLATFORM_ECC_KEY_POOL
+        /* Refill ephemeral key pool in idle time */
+        stse_platform_ecc_pool_refill(STSE_PLATFORM_ECC_POOL_SIZE);
+#endif
+
         /* Wait for press key */
         printf("\n\n\r Press key to run echo example !!!\n\r");
         getchar();
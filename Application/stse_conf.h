@@ -92,6 +92,42 @@ extern "C" {
 
 #endif /* STSE_CONF_STSAFE_L_SUPPORT */
 
+/*********************************************************
+ *                PLATFORM CRYPTO SETTINGS
+ *********************************************************/
+
+/* ECC implementation : LOWMEM curves with small math functions (default) or
+ * HIGHMEM curves with fast math functions (faster, larger math buffer) */
+//#define STSE_CONF_PLATFORM_ECC_FAST
+
+/* Crypto platform benchmark : cycles per operation, peak stack and heap growth of
+ * each enabled stse_platform_* primitive, printed at start-up */
+//#define STSE_CONF_PLATFORM_BENCHMARK
+
+/* ECC ephemeral key pool : key pairs generated ahead of time by
+ * stse_platform_ecc_pool_refill (see stse_platform_ecc.h) */
+//#define STSE_CONF_PLATFORM_ECC_KEY_POOL
+
+/* ECC verified signature cache : positive verifications kept in a bounded LRU table */
+//#define STSE_CONF_PLATFORM_ECC_VERIFY_CACHE
+
+/* Crypto scratch arena : ECC math buffers, nonces and HMAC midstates borrowed per
+ * operation (see stse_platform_arena.h), optionally placed in SRAM2 */
+//#define STSE_CONF_PLATFORM_CRYPTO_ARENA
+//#define STSE_CONF_PLATFORM_ARENA_IN_SRAM2
+
+/* AES key cache : session keys expanded once per bound host session. The
+ * application binds the cache after opening its host session
+ * (stse_platform_aes_key_cache_open) and unbinds it when erasing the session
+ * (stse_platform_aes_key_cache_close, see stse_platform_aes.h). The echo example
+ * opens no session : the cache stays unbound and keys are expanded per call */
+//#define STSE_CONF_PLATFORM_AES_KEY_CACHE
+
+/* Response CRC check in the I2C PAL (exclusive) : accumulated by the receive
+ * copies (FUSED_RECEIVE) or by the I2C driver receive loop (I2C_RECEIVE_CRC) */
+//#define STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE
+//#define STSE_CONF_PLATFORM_I2C_RECEIVE_CRC
+
 /*********************************************************
  *                COMMUNICATION SETTINGS
  *********************************************************/
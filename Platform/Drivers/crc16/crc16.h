@@ -19,16 +19,54 @@
 #define CRC16_H_
 
 #include "stm32l4xx.h"
+#include <stddef.h>
 
 //#define CRC16_HW_IMP
 
+/* Hardware CRC16 DMA feed (when CRC16_HW_IMP is defined) : aligned words of
+ * buffers longer than CRC16_HW_DMA_THRESHOLD words are pushed to CRC->DR by a
+ * memory to memory DMA1 transfer */
+//#define CRC16_HW_DMA
+#define CRC16_HW_DMA_CHANNEL DMA1_Channel1
+#define CRC16_HW_DMA_THRESHOLD 32
+
+/* Software CRC16 engine (when CRC16_HW_IMP is not defined) :
+ *  1 : byte per byte, 256 entries table (512 bytes)
+ *  4 : slicing-by-4, one 32-bit word per iteration (2 Kbytes of tables)
+ *  8 : slicing-by-8, two 32-bit words per iteration (4 Kbytes of tables) */
+#ifndef CRC16_SW_SLICING
+#define CRC16_SW_SLICING 1
+#endif
+#if (CRC16_SW_SLICING != 1) && (CRC16_SW_SLICING != 4) && (CRC16_SW_SLICING != 8)
+#error "CRC16_SW_SLICING shall be 1, 4 or 8"
+#endif
+
 #define CRC16_POLY 0x1021
 #define CRC_INITVALUE 0xFFFF
 #define CRC16_REV_IN 1
 #define CRC16_REV_OUT 1
 
+/* CRC16 stream context (caller owned, one per concurrent frame) */
+typedef struct {
+    uint16_t crc; /* Running CRC state */
+} crc16_ctx_t;
+
 void crc16_Init(void);
+
+/* - Context API : independent streams may be interleaved (and updated from
+ *   interrupts) ; the hardware engine saves/restores the CRC unit state, a
+ *   context preempting a running feed is computed in software.
+ *   crc16_ctx_update returns -1 on DMA transfer error (context state invalid,
+ *   the single stream API computes the chunk again in software) */
+void crc16_ctx_init(crc16_ctx_t *pCtx);
+int8_t crc16_ctx_update(crc16_ctx_t *pCtx, uint8_t *address, uint16_t length);
+void crc16_ctx_copy_update(crc16_ctx_t *pCtx, uint8_t *destination, uint8_t *source, uint16_t length);
+uint16_t crc16_ctx_final(crc16_ctx_t *pCtx);
+
+/* - Single stream API (default context) */
 uint16_t crc16_Calculate(uint8_t *address, uint16_t length);
 uint16_t crc16_Accumulate(uint8_t *address, uint16_t length);
+uint16_t crc16_Copy_Calculate(uint8_t *destination, uint8_t *source, uint16_t length);
+uint16_t crc16_Copy_Accumulate(uint8_t *destination, uint8_t *source, uint16_t length);
 
 #endif /* CRC16_H_ */
@@ -0,0 +1,30 @@
+/******************************************************************************
+ * \file	cycle_counter.c
+ * \brief   Core cycle counter driver for STM32L452 (DWT)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#include "Drivers/cycle_counter/cycle_counter.h"
+
+void cycle_counter_init(void) {
+    /* - Enable trace and debug blocks */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+    /* - Reset and start DWT cycle counter */
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t cycle_counter_get(void) {
+    return DWT->CYCCNT;
+}
@@ -0,0 +1,26 @@
+/******************************************************************************
+ * \file	cycle_counter.h
+ * \brief   Core cycle counter driver for STM32L452 (DWT)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef CYCLE_COUNTER_H_
+#define CYCLE_COUNTER_H_
+
+#include "stm32l4xx.h"
+
+void cycle_counter_init(void);
+uint32_t cycle_counter_get(void);
+
+#endif /* CYCLE_COUNTER_H_ */
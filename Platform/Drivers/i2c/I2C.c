@@ -20,6 +20,15 @@
 
 static uint16_t i2c_speed = 100;
 
+static struct {
+    I2C_TypeDef *pI2C;
+    uint8_t *pbuffer;
+    uint16_t size;
+    uint16_t pending;         /* Bytes not yet programmed in NBYTES */
+    volatile uint16_t count;  /* Bytes received */
+    volatile i2c_xfer_status_t status;
+} i2c_it_rx;
+
 void i2c_deinit(I2C_TypeDef *pI2C) {
     // Do nothing
     (void)pI2C;
@@ -105,7 +114,7 @@ int8_t i2c_write(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8
                     return -1;
                 }
             }
-            pI2C->TXDR = (uint8_t)*(pbuffer + (i + offset));
+            WRITE_REG(pI2C->TXDR, *(pbuffer + (i + offset)));
         }
         xfer_length = (xfer_length - xfer_size);
         if (xfer_length > 0) {
@@ -130,9 +139,38 @@ int8_t i2c_write(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8
 }
 
 int8_t i2c_read(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size) {
+    return i2c_read_crc(pI2C, slave_address, speed, pbuffer, size, NULL);
+}
+
+void i2c_crc_feed(i2c_crc_window_t *pWindow, uint8_t *pbuffer, uint16_t from, uint16_t to) {
+    uint16_t skip_end = pWindow->skip_offset + pWindow->skip_length;
+    uint16_t run_end;
+
+    if (to > pWindow->end) {
+        to = pWindow->end;
+    }
+    /* - Covered bytes before the skipped range */
+    if (from < pWindow->skip_offset) {
+        run_end = (to < pWindow->skip_offset) ? to : pWindow->skip_offset;
+        if (from < run_end) {
+            crc16_ctx_update(pWindow->pCtx, pbuffer + from, run_end - from);
+        }
+    }
+    /* - Covered bytes after the skipped range */
+    if (from < skip_end) {
+        from = skip_end;
+    }
+    if (from < to) {
+        crc16_ctx_update(pWindow->pCtx, pbuffer + from, to - from);
+    }
+}
+
+int8_t i2c_read_crc(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size, i2c_crc_window_t *pWindow) {
     uint32_t i = 0;
     uint16_t xfer_length;
     uint16_t xfer_size;
+    uint16_t index = 0;
+    uint16_t fed = 0;
 
     (void)(speed);
 
@@ -170,7 +208,12 @@ int8_t i2c_read(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_
             while (!(pI2C->ISR & I2C_ISR_RXNE))
                 ;
             /*- Store data  */
-            *(pbuffer++) = (uint8_t)pI2C->RXDR;
+            pbuffer[index++] = (uint8_t)READ_REG(pI2C->RXDR);
+            /*- Accumulate CRC by chunks while the next bytes are shifted in */
+            if ((pWindow != NULL) && ((uint16_t)(index - fed) >= I2C_CRC_CHUNK_SIZE)) {
+                i2c_crc_feed(pWindow, pbuffer, fed, index);
+                fed = index;
+            }
         }
         xfer_length = (xfer_length - xfer_size);
         if (xfer_length > 0) {
@@ -190,9 +233,117 @@ int8_t i2c_read(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_
         }
     }
 
+    /*- Last chunk */
+    if (pWindow != NULL) {
+        i2c_crc_feed(pWindow, pbuffer, fed, index);
+    }
+
     return 0;
 }
 
+static void _i2c_read_it_end(i2c_xfer_status_t status) {
+    i2c_it_rx.pI2C->CR1 &= ~(I2C_CR1_RXIE | I2C_CR1_TCIE | I2C_CR1_NACKIE | I2C_CR1_STOPIE | I2C_CR1_ERRIE);
+    i2c_it_rx.status = status;
+}
+
+int8_t i2c_read_it_start(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size) {
+    uint16_t xfer_size;
+
+    (void)(speed);
+
+    if ((pI2C != I2C1) || (size == 0) || (i2c_it_rx.status == I2C_XFER_BUSY)) {
+        return -1;
+    }
+
+    i2c_it_rx.pI2C = pI2C;
+    i2c_it_rx.pbuffer = pbuffer;
+    i2c_it_rx.size = size;
+    i2c_it_rx.count = 0;
+    i2c_it_rx.status = I2C_XFER_BUSY;
+
+    xfer_size = (size > 0xFF) ? 0xFF : size;
+    i2c_it_rx.pending = size - xfer_size;
+
+    /* - Enable reception events */
+    pI2C->ICR = I2C_ICR_NACKCF | I2C_ICR_STOPCF | I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF;
+    NVIC_SetPriority(I2C1_EV_IRQn, I2C_IRQ_PRIORITY);
+    NVIC_SetPriority(I2C1_ER_IRQn, I2C_IRQ_PRIORITY);
+    NVIC_EnableIRQ(I2C1_EV_IRQn);
+    NVIC_EnableIRQ(I2C1_ER_IRQn);
+    pI2C->CR1 |= I2C_CR1_RXIE | I2C_CR1_TCIE | I2C_CR1_NACKIE | I2C_CR1_STOPIE | I2C_CR1_ERRIE;
+
+    /* - Xfer Configuration  */
+    pI2C->CR2 = (0x00 << I2C_CR2_ADD10_Pos) |
+                (0x01 << I2C_CR2_RD_WRN_Pos) |
+                (xfer_size << I2C_CR2_NBYTES_Pos) |
+                (0x01 << I2C_CR2_AUTOEND_Pos) |
+                (slave_address << (I2C_CR2_SADD_Pos + 1));
+    if (i2c_it_rx.pending > 0) {
+        pI2C->CR2 |= I2C_CR2_RELOAD;
+    }
+
+    /* - Start Xfer */
+    pI2C->CR2 |= I2C_CR2_START;
+
+    return 0;
+}
+
+uint16_t i2c_read_it_progress(void) {
+    return i2c_it_rx.count;
+}
+
+i2c_xfer_status_t i2c_read_it_status(void) {
+    return i2c_it_rx.status;
+}
+
+void i2c_read_it_abort(void) {
+    if (i2c_it_rx.status == I2C_XFER_BUSY) {
+        _i2c_read_it_end(I2C_XFER_ERROR);
+        /* - Release the bus */
+        i2c_it_rx.pI2C->CR2 |= I2C_CR2_STOP;
+    }
+}
+
+void I2C1_EV_IRQHandler(void) {
+    I2C_TypeDef *pI2C = I2C1;
+    uint16_t xfer_size;
+
+    /*- Store received data */
+    while ((pI2C->ISR & I2C_ISR_RXNE) && (i2c_it_rx.count < i2c_it_rx.size)) {
+        i2c_it_rx.pbuffer[i2c_it_rx.count] = (uint8_t)READ_REG(pI2C->RXDR);
+        i2c_it_rx.count++;
+    }
+
+    /*- Program next chunk */
+    if (pI2C->ISR & I2C_ISR_TCR) {
+        xfer_size = (i2c_it_rx.pending > 0xFF) ? 0xFF : i2c_it_rx.pending;
+        i2c_it_rx.pending -= xfer_size;
+        if (i2c_it_rx.pending == 0) {
+            pI2C->CR2 &= ~(I2C_CR2_RELOAD);
+        }
+        pI2C->CR2 &= ~(I2C_CR2_NBYTES_Msk);
+        pI2C->CR2 |= (xfer_size << I2C_CR2_NBYTES_Pos);
+    }
+
+    /*- End of transfer (AUTOEND) */
+    if (pI2C->ISR & I2C_ISR_STOPF) {
+        if (pI2C->ISR & I2C_ISR_NACKF) {
+            pI2C->ICR = I2C_ICR_NACKCF | I2C_ICR_STOPCF;
+            _i2c_read_it_end(I2C_XFER_ERROR);
+        } else {
+            pI2C->ICR = I2C_ICR_STOPCF;
+            _i2c_read_it_end((i2c_it_rx.count == i2c_it_rx.size) ? I2C_XFER_DONE : I2C_XFER_ERROR);
+        }
+    }
+}
+
+void I2C1_ER_IRQHandler(void) {
+    I2C1->ICR = I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF;
+    if (i2c_it_rx.status == I2C_XFER_BUSY) {
+        _i2c_read_it_end(I2C_XFER_ERROR);
+    }
+}
+
 void i2c_wake(I2C_TypeDef *pI2C, uint8_t slave_address) {
 
     /* - Xfer Configuration  */
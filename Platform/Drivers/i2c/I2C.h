@@ -17,12 +17,42 @@
 #ifndef DRIVERS_I2C_I2C_H_
 #define DRIVERS_I2C_I2C_H_
 
+#include "Drivers/crc16/crc16.h"
 #include "stm32l4xx.h"
 
+/* CRC16 accumulated on the fly by i2c_read_crc (bytes [0, end) except the
+ * [skip_offset, skip_offset + skip_length) range), I2C_CRC_CHUNK_SIZE received
+ * bytes at a time while the next bytes are shifted in. i2c_crc_feed adds the
+ * covered bytes of [from, to) for the interrupt driven receive */
+#define I2C_CRC_CHUNK_SIZE 16U
+
+typedef struct {
+    crc16_ctx_t *pCtx;
+    uint16_t skip_offset;
+    uint16_t skip_length;
+    uint16_t end;
+} i2c_crc_window_t;
+
+/* Interrupt driven receive (I2C1 event / error interrupts) */
+#define I2C_IRQ_PRIORITY 2U
+
+typedef enum {
+    I2C_XFER_IDLE = 0,
+    I2C_XFER_BUSY,
+    I2C_XFER_DONE,
+    I2C_XFER_ERROR
+} i2c_xfer_status_t;
+
 uint8_t i2c_init(I2C_TypeDef *pI2C);
 void i2c_deinit(I2C_TypeDef *pI2C);
 int8_t i2c_write(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size);
 int8_t i2c_read(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size);
+void i2c_crc_feed(i2c_crc_window_t *pWindow, uint8_t *pbuffer, uint16_t from, uint16_t to);
+int8_t i2c_read_crc(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size, i2c_crc_window_t *pWindow);
+int8_t i2c_read_it_start(I2C_TypeDef *pI2C, uint8_t slave_address, uint16_t speed, uint8_t *pbuffer, uint16_t size);
+uint16_t i2c_read_it_progress(void);
+i2c_xfer_status_t i2c_read_it_status(void);
+void i2c_read_it_abort(void);
 void i2c_wake(I2C_TypeDef *pI2C, uint8_t slave_address);
 
 #endif /* DRIVERS_I2C_I2C_H_ */
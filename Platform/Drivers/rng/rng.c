@@ -17,16 +17,149 @@
 
 #include "Drivers/rng/rng.h"
 
+#if (RNG_POOL_SIZE & (RNG_POOL_SIZE - 1U)) != 0U
+#error "RNG_POOL_SIZE shall be a power of 2"
+#endif
+
+/* Single producer (RNG interrupt) ring, consumers serialized by rng_try_get */
+static uint32_t rng_pool[RNG_POOL_SIZE];
+static volatile uint32_t rng_pool_head;
+static volatile uint32_t rng_pool_tail;
+static volatile rng_stats_t rng_stats;
+
+static void _rng_health_recover(void) {
+    /* - Seed error : discard pending word and restart the generator */
+    if (RNG->SR & RNG_SR_SEIS) {
+        RNG->SR &= ~(RNG_SR_SEIS);
+        RNG->CR &= ~(RNG_CR_RNGEN);
+        RNG->CR |= RNG_CR_RNGEN;
+    }
+    /* - Clock error : generator restarts by itself once the clock is back */
+    if (RNG->SR & RNG_SR_CEIS) {
+        RNG->SR &= ~(RNG_SR_CEIS);
+    }
+    rng_stats.health_errors++;
+}
+
+static uint32_t _rng_read_blocking(void) {
+    uint32_t primask = __get_PRIMASK();
+    uint32_t ie;
+    uint32_t value;
+
+    /* - Generator polled with interrupts masked (one word : ~42 RNG clocks) :
+     *   a preempting consumer can't take the word between DRDY and DR */
+    __disable_irq();
+    ie = RNG->CR & RNG_CR_IE;
+    RNG->CR &= ~(RNG_CR_IE);
+    do {
+        while (!(RNG->SR & (RNG_SR_DRDY | RNG_SR_SEIS | RNG_SR_CEIS)))
+            ;
+        if (RNG->SR & (RNG_SR_SEIS | RNG_SR_CEIS)) {
+            _rng_health_recover();
+            continue;
+        }
+        value = RNG->DR;
+        break;
+    } while (1);
+    rng_stats.underflows++;
+    RNG->CR |= ie;
+    __set_PRIMASK(primask);
+
+    return value;
+}
+
+void RNG_IRQHandler(void) {
+    uint32_t head;
+
+    if (RNG->SR & (RNG_SR_SEIS | RNG_SR_CEIS)) {
+        _rng_health_recover();
+        return;
+    }
+
+    /* - Move every ready word to the pool */
+    while (RNG->SR & RNG_SR_DRDY) {
+        head = rng_pool_head;
+        if ((head - rng_pool_tail) >= RNG_POOL_SIZE) {
+            /* - Pool full : refill resumes on next consumption */
+            RNG->CR &= ~(RNG_CR_IE);
+            return;
+        }
+        rng_pool[head & (RNG_POOL_SIZE - 1U)] = RNG->DR;
+        rng_pool_head = head + 1U;
+        rng_stats.refills++;
+    }
+}
+
 void rng_start(void) {
-    RNG->CR |= (RNG_CR_RNGEN | 1 << 5);
+    rng_pool_head = 0;
+    rng_pool_tail = 0;
+    NVIC_SetPriority(RNG_IRQn, RNG_IRQ_PRIORITY);
+    NVIC_EnableIRQ(RNG_IRQn);
+    RNG->CR |= (RNG_CR_RNGEN | RNG_CR_IE | 1 << 5);
+}
+
+uint8_t rng_try_get(uint32_t *pValue) {
+    uint32_t primask = __get_PRIMASK();
+    uint32_t tail;
+
+    /* - Slot read and consumer index update with interrupts masked : callers
+     *   from several tasks / interrupts never get the same word, and the CR
+     *   read-modify-write does not race with the refill interrupt */
+    __disable_irq();
+    tail = rng_pool_tail;
+    if (rng_pool_head == tail) {
+        __set_PRIMASK(primask);
+        return 0;
+    }
+    *pValue = rng_pool[tail & (RNG_POOL_SIZE - 1U)];
+    rng_pool_tail = tail + 1U;
+
+    /* - Room available : resume refill */
+    if (RNG->CR & RNG_CR_RNGEN) {
+        RNG->CR |= RNG_CR_IE;
+    }
+    __set_PRIMASK(primask);
+
+    return 1;
 }
 
 uint32_t rng_generate_random_number(void) {
-    while (!(RNG->SR & RNG_SR_DRDY))
-        ;
-    return RNG->DR;
+    uint32_t value;
+
+    if (!rng_try_get(&value)) {
+        value = _rng_read_blocking();
+    }
+    return value;
+}
+
+void rng_fill(uint8_t *pBuffer, uint32_t length) {
+    uint32_t value;
+
+    /* - Use the four bytes of each word */
+    while (length >= 4U) {
+        value = rng_generate_random_number();
+        *pBuffer++ = (uint8_t)value;
+        *pBuffer++ = (uint8_t)(value >> 8);
+        *pBuffer++ = (uint8_t)(value >> 16);
+        *pBuffer++ = (uint8_t)(value >> 24);
+        length -= 4U;
+    }
+    if (length > 0U) {
+        value = rng_generate_random_number();
+        while (length-- > 0U) {
+            *pBuffer++ = (uint8_t)value;
+            value >>= 8;
+        }
+    }
+}
+
+void rng_get_stats(rng_stats_t *pStats) {
+    pStats->refills = rng_stats.refills;
+    pStats->underflows = rng_stats.underflows;
+    pStats->health_errors = rng_stats.health_errors;
 }
 
 void rng_stop(void) {
-    RNG->CR &= ~(RNG_CR_RNGEN);
+    RNG->CR &= ~(RNG_CR_RNGEN | RNG_CR_IE);
+    NVIC_DisableIRQ(RNG_IRQn);
 }
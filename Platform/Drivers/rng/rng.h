@@ -20,8 +20,23 @@
 
 #include "stm32l4xx.h"
 
+/* Entropy pool : ring of RNG words refilled from the RNG interrupt (power of 2).
+ * Consumers (rng_try_get, rng_generate_random_number, rng_fill) may run from
+ * several tasks or interrupts : each word is taken with interrupts masked */
+#define RNG_POOL_SIZE 32U
+#define RNG_IRQ_PRIORITY 3U
+
+typedef struct {
+    uint32_t refills;       /* Words pushed in the pool by the RNG interrupt */
+    uint32_t underflows;    /* Words read from the RNG with an empty pool */
+    uint32_t health_errors; /* Seed / clock error events */
+} rng_stats_t;
+
 void rng_start(void);
 uint32_t rng_generate_random_number(void);
+uint8_t rng_try_get(uint32_t *pValue);
+void rng_fill(uint8_t *pBuffer, uint32_t length);
+void rng_get_stats(rng_stats_t *pStats);
 void rng_stop(void);
 
 #endif /* RNG_H_ */
@@ -18,12 +18,20 @@
 
 /* Platform configuration parameters */
 #include "st1wire.h"
+#include "st1wire_async.h"
 
+#ifndef ST1WIRE_ASYNC_ENGINE
 /* ---------- Static functions Definition ---------- */
-static int8_t _st1wire_SendByte(uint8_t bus_addr, uint8_t speed, uint8_t byte);
-static int8_t _st1wire_ReceiveByte(uint8_t bus_addr, uint8_t speed, uint8_t *rcv_byte);
+static ST1WIRE_RAMFUNC int8_t _st1wire_SendByte(uint8_t bus_addr, const st1wire_timing_t *pTiming, uint8_t byte);
+static ST1WIRE_RAMFUNC int8_t _st1wire_ReceiveByte(uint8_t bus_addr, const st1wire_timing_t *pTiming, uint8_t *rcv_byte);
 static int8_t _st1wire_Idle_detection(uint8_t bus_addr);
-static int8_t _st1wire_SendStart(uint8_t bus_addr, uint8_t speed);
+static int8_t _st1wire_SendStart(uint8_t bus_addr, uint8_t speed, const st1wire_timing_t *pTiming);
+
+/* Frame streamed through the Start/Continue/Stop functions */
+static struct {
+    const st1wire_timing_t *pTiming;
+    uint16_t remaining;
+} st1wire_stream;
 
 /* ---------- Static functions Declarations ---------- */
 static int8_t _st1wire_Idle_detection(uint8_t bus_addr) {
@@ -36,13 +44,8 @@ static int8_t _st1wire_Idle_detection(uint8_t bus_addr) {
     return ST1WIRE_OK;
 }
 
-static int8_t _st1wire_SendStart(uint8_t bus_addr, uint8_t speed) {
+static int8_t _st1wire_SendStart(uint8_t bus_addr, uint8_t speed, const st1wire_timing_t *pTiming) {
     uint8_t ret = ST1WIRE_OK;
-    uint16_t start_t = ST1WIRE_3C_START_PULSE;
-
-    if (speed == 0) {
-        start_t = ST1WIRE_2C_START_PULSE;
-    }
 
     st1wire_platform_io_in(bus_addr);
     while (!_st1wire_Idle_detection(bus_addr))
@@ -53,57 +56,57 @@ static int8_t _st1wire_SendStart(uint8_t bus_addr, uint8_t speed) {
     /* - Set bus to low level */
     st1wire_platform_io_out(bus_addr);
     st1wire_platform_io_clear(bus_addr);
-    st1wire_platform_delay(start_t);
+    st1wire_platform_delay(pTiming->start_pulse);
     st1wire_platform_io_set(bus_addr);
     if (speed == 0) {
-        st1wire_platform_delay(ST1WIRE_2C_INTER_BYTE_DELAY);
+        st1wire_platform_delay(pTiming->inter_byte_delay);
     }
 
     return ret;
 }
 
-static int8_t _st1wire_ReceiveByte(uint8_t bus_addr, uint8_t speed, uint8_t *rcv_byte) {
+static ST1WIRE_RAMFUNC int8_t _st1wire_ReceiveByte(uint8_t bus_addr, const st1wire_timing_t *pTiming, uint8_t *rcv_byte) {
     uint32_t i, DelayHigh, DelayLow, byteReceived = 0;
 
-    uint16_t long_t = ST1WIRE_3C_LONG_PULSE;
-    uint16_t ack_t = ST1WIRE_3C_ACK_PULSE;
-    uint16_t receive_timout_t = ST1WIRE_RECEIVE_TIMEOUT;
+    uint16_t long_t = pTiming->long_pulse;
+    uint16_t ack_t = pTiming->ack_pulse;
+    st1wire_platform_line_t line;
 
-    if (speed == 0) {
-        long_t = ST1WIRE_2C_LONG_PULSE;
-        ack_t = ST1WIRE_2C_ACK_PULSE;
-    }
+    /* - Resolve bus line once for the whole byte */
+    st1wire_platform_line_get(bus_addr, &line);
 
     ST1WIRE_START_CRITICAL_SECTION
     i = 0;
 
     /* - Send sync bit('1') */
-    st1wire_platform_io_out(bus_addr);
-    st1wire_platform_io_set(bus_addr);
+    st1wire_platform_line_out(&line);
+    st1wire_platform_line_set(&line);
     st1wire_platform_delay(long_t);
-    st1wire_platform_io_clear(bus_addr);
+    st1wire_platform_line_clear(&line);
     st1wire_platform_delay(long_t);
-    st1wire_platform_io_set(bus_addr);
+    st1wire_platform_line_set(&line);
     // Handle byte reception
-    st1wire_platform_io_in(bus_addr);
+    st1wire_platform_line_in(&line);
     for (i = 0; i < 8; i++) {
         // - Clear SW counters
         DelayHigh = 0;
         DelayLow = 0;
-        // - Count High level duration
-        while (st1wire_platform_io_get(bus_addr)) /* while line value is high*/
+        // - Count High level duration (timeout on the us timer, not on the loop count)
+        st1wire_platform_start_timeout(ST1WIRE_RECEIVE_TIMEOUT);
+        while (st1wire_platform_line_get_level(&line)) /* while line value is high*/
         {
             DelayHigh++;
-            if (DelayHigh >= receive_timout_t) {
+            if (st1wire_platform_is_timeout_exceeded()) {
                 ST1WIRE_END_CRITICAL_SECTION
                 return ST1WIRE_BUS_RECEIVE_TIMEOUT;
             }
         }
         // - Count Low level duration
-        while (!(st1wire_platform_io_get(bus_addr))) /* while line value is low */
+        st1wire_platform_start_timeout(ST1WIRE_RECEIVE_TIMEOUT);
+        while (!(st1wire_platform_line_get_level(&line))) /* while line value is low */
         {
             DelayLow++;
-            if (DelayLow >= receive_timout_t) {
+            if (st1wire_platform_is_timeout_exceeded()) {
                 ST1WIRE_END_CRITICAL_SECTION
                 return ST1WIRE_BUS_RECEIVE_TIMEOUT;
             }
@@ -116,68 +119,65 @@ static int8_t _st1wire_ReceiveByte(uint8_t bus_addr, uint8_t speed, uint8_t *rcv
     }
     byteReceived >>= 1; // don't do the last shift
     // - Acknowledge the byte reception
-    st1wire_platform_io_out(bus_addr);
-    st1wire_platform_io_clear(bus_addr);
+    st1wire_platform_line_out(&line);
+    st1wire_platform_line_clear(&line);
     st1wire_platform_delay(ack_t);
-    st1wire_platform_io_set(bus_addr);
+    st1wire_platform_line_set(&line);
     ST1WIRE_END_CRITICAL_SECTION
     *rcv_byte = (uint8_t)byteReceived;
 
     return ST1WIRE_OK;
 }
 
-static int8_t _st1wire_SendByte(uint8_t bus_addr, uint8_t speed, uint8_t byte) {
+static ST1WIRE_RAMFUNC int8_t _st1wire_SendByte(uint8_t bus_addr, const st1wire_timing_t *pTiming, uint8_t byte) {
     volatile uint32_t i = 0;
-    uint16_t long_t = ST1WIRE_3C_LONG_PULSE;
-    uint16_t short_t = ST1WIRE_3C_SHORT_PULSE;
+    uint16_t long_t = pTiming->long_pulse;
+    uint16_t short_t = pTiming->short_pulse;
+    st1wire_platform_line_t line;
 
-    if (speed == 0) {
-        long_t = ST1WIRE_2C_LONG_PULSE;
-        short_t = ST1WIRE_2C_SHORT_PULSE;
-    }
+    /* - Resolve bus line once for the whole byte */
+    st1wire_platform_line_get(bus_addr, &line);
 
     ST1WIRE_START_CRITICAL_SECTION
-    st1wire_platform_io_out(bus_addr);
+    st1wire_platform_line_out(&line);
     /* - Send sync bit('1') */
-    st1wire_platform_io_set(bus_addr);
+    st1wire_platform_line_set(&line);
     st1wire_platform_delay(short_t);
-    st1wire_platform_io_clear(bus_addr);
+    st1wire_platform_line_clear(&line);
     st1wire_platform_delay(long_t);
     // - Send Byte
     for (i = 0; i < 8; i++) {
         /* Mask each bit value*/
         if (byte & (1 << (7 - i))) {
             /* - Send '1' */
-            st1wire_platform_io_set(bus_addr);
+            st1wire_platform_line_set(&line);
             st1wire_platform_delay(long_t);
-            st1wire_platform_io_clear(bus_addr);
+            st1wire_platform_line_clear(&line);
             st1wire_platform_delay(short_t);
         } else {
             /* - Send '0' */
-            st1wire_platform_io_set(bus_addr);
+            st1wire_platform_line_set(&line);
             st1wire_platform_delay(short_t);
-            st1wire_platform_io_clear(bus_addr);
+            st1wire_platform_line_clear(&line);
             st1wire_platform_delay(long_t);
         }
     }
     /* - Release the STWire line*/
-    st1wire_platform_io_set(bus_addr);
-    st1wire_platform_io_in(bus_addr);
+    st1wire_platform_line_set(&line);
+    st1wire_platform_line_in(&line);
 
-    /* - Wait for a low level on STWire*/
-    i = 0;
-    while (st1wire_platform_io_get(bus_addr)) {
-        i++;
-        if (i >= 0xFF) {
+    /* - Wait for a low level on STWire (timeout on the us timer, not on the loop count) */
+    st1wire_platform_start_timeout(ST1WIRE_ACK_TIMEOUT);
+    while (st1wire_platform_line_get_level(&line)) {
+        if (st1wire_platform_is_timeout_exceeded()) {
             ST1WIRE_END_CRITICAL_SECTION
             return ST1WIRE_BUS_ACK_ERROR;
         }
     }
     // - Wait for a high level on STWire
-    i = 0;
-    while (!(st1wire_platform_io_get(bus_addr))) {
-        i++;
-        if (i >= 0xFF) {
+    st1wire_platform_start_timeout(ST1WIRE_ACK_TIMEOUT);
+    while (!(st1wire_platform_line_get_level(&line))) {
+        if (st1wire_platform_is_timeout_exceeded()) {
             ST1WIRE_END_CRITICAL_SECTION
             return ST1WIRE_BUS_ACK_ERROR;
         }
@@ -186,11 +186,420 @@ static int8_t _st1wire_SendByte(uint8_t bus_addr, uint8_t speed, uint8_t byte) {
 
     return ST1WIRE_OK;
 }
+#else
+/* ---------- Static functions Definition ---------- */
+static void _st1wire_sync_callback(st1wire_ReturnCode_t status, void *pCtx);
+static st1wire_ReturnCode_t _st1wire_sync_wait(void);
+
+static volatile uint8_t st1wire_sync_done;
+static volatile st1wire_ReturnCode_t st1wire_sync_status;
+
+/* ---------- Static functions Declarations ---------- */
+static void _st1wire_sync_callback(st1wire_ReturnCode_t status, void *pCtx) {
+    (void)pCtx;
+    st1wire_sync_status = status;
+    st1wire_sync_done = 1;
+}
+
+static st1wire_ReturnCode_t _st1wire_sync_wait(void) {
+    ST1WIRE_ASYNC_WAIT(st1wire_sync_done)
+    return st1wire_sync_status;
+}
+#endif /* ST1WIRE_ASYNC_ENGINE */
+
+/* ---------- Timing profiles ---------- */
+typedef struct {
+    uint8_t valid;
+    uint8_t bus_addr;
+    uint8_t dev_addr;
+    uint8_t speed;
+    st1wire_timing_t timing;
+} st1wire_timing_profile_t;
+
+static const st1wire_timing_t st1wire_default_timing[2] = {
+    /* Slow (ST1Wire 2-Contact) */
+    {
+        .long_pulse = ST1WIRE_2C_LONG_PULSE,
+        .short_pulse = ST1WIRE_2C_SHORT_PULSE,
+        .ack_pulse = ST1WIRE_2C_ACK_PULSE,
+        .start_pulse = ST1WIRE_2C_START_PULSE,
+        .inter_byte_delay = ST1WIRE_2C_INTER_BYTE_DELAY,
+        .inter_frame_delay = ST1WIRE_2C_INTER_FRAME_DELAY,
+    },
+    /* Fast (ST1Wire 3-Contact) */
+    {
+        .long_pulse = ST1WIRE_3C_LONG_PULSE,
+        .short_pulse = ST1WIRE_3C_SHORT_PULSE,
+        .ack_pulse = ST1WIRE_3C_ACK_PULSE,
+        .start_pulse = ST1WIRE_3C_START_PULSE,
+        .inter_byte_delay = ST1WIRE_3C_INTER_BYTE_DELAY,
+        .inter_frame_delay = ST1WIRE_3C_INTER_BYTE_DELAY,
+    },
+};
+
+static st1wire_timing_profile_t st1wire_timing_profiles[ST1WIRE_TIMING_PROFILE_COUNT];
+
+static st1wire_timing_profile_t *_st1wire_timing_find(uint8_t bus_addr, uint8_t dev_addr, uint8_t speed) {
+    uint8_t i;
+
+    for (i = 0; i < ST1WIRE_TIMING_PROFILE_COUNT; i++) {
+        if ((st1wire_timing_profiles[i].valid) &&
+            (st1wire_timing_profiles[i].bus_addr == bus_addr) &&
+            (st1wire_timing_profiles[i].dev_addr == dev_addr) &&
+            (st1wire_timing_profiles[i].speed == speed)) {
+            return &st1wire_timing_profiles[i];
+        }
+    }
+    return NULL;
+}
+
+static uint16_t _st1wire_timing_add_margin(uint16_t value, uint16_t max) {
+    uint32_t margin = ((uint32_t)value * ST1WIRE_CALIBRATION_MARGIN_PERCENT + 99) / 100;
+
+    if ((value + margin) > max) {
+        return max;
+    }
+    return (uint16_t)(value + margin);
+}
+
+static uint8_t _st1wire_calibration_probe(uint8_t bus_addr, uint8_t dev_addr, uint8_t speed,
+                                          st1wire_probe_t probe, void *pCtx,
+                                          const st1wire_timing_t *pCandidate) {
+    uint8_t i;
+
+    st1wire_timing_set(bus_addr, dev_addr, speed, pCandidate);
+    for (i = 0; i < ST1WIRE_CALIBRATION_PROBE_COUNT; i++) {
+        if (probe(bus_addr, dev_addr, speed, pCtx) != ST1WIRE_OK) {
+            /* - Bring the device back to a known state with default timings */
+            st1wire_timing_set(bus_addr, dev_addr, speed, NULL);
+            st1wire_recovery(bus_addr, speed);
+            st1wire_wake(bus_addr);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ---------- Broadcast (lockstep multi-bus) ---------- */
+static int8_t _st1wire_group_SendStart(st1wire_platform_group_t *pGroup, uint8_t speed, const st1wire_timing_t *pTiming) {
+    int8_t ret = ST1WIRE_OK;
+
+    /* - Wait for ST1WIRE_IDLE us of idle level on all lines */
+    st1wire_platform_group_in(pGroup);
+    st1wire_platform_start_timeout(ST1WIRE_IDLE);
+    while (!st1wire_platform_is_timeout_exceeded()) {
+        if (st1wire_platform_group_get(pGroup) != pGroup->bus_mask) {
+            st1wire_platform_start_timeout(ST1WIRE_IDLE);
+        }
+    }
+    if (st1wire_platform_group_get(pGroup) != pGroup->bus_mask) {
+        ret = ST1WIRE_BUS_ARBITRATION_FAULT;
+    }
+    /* - Set all lines to low level */
+    st1wire_platform_group_out(pGroup);
+    st1wire_platform_group_clear(pGroup);
+    st1wire_platform_delay(pTiming->start_pulse);
+    st1wire_platform_group_set(pGroup);
+    if (speed == 0) {
+        st1wire_platform_delay(pTiming->inter_byte_delay);
+    }
+
+    return ret;
+}
+
+static ST1WIRE_RAMFUNC void _st1wire_group_SendByte(st1wire_platform_group_t *pGroup, const st1wire_timing_t *pTiming, uint8_t byte) {
+    volatile uint32_t i = 0;
+    uint32_t wait_low, wait_high, level;
+    uint16_t long_t = pTiming->long_pulse;
+    uint16_t short_t = pTiming->short_pulse;
+
+    ST1WIRE_START_CRITICAL_SECTION
+    st1wire_platform_group_out(pGroup);
+    /* - Send sync bit('1') */
+    st1wire_platform_group_set(pGroup);
+    st1wire_platform_delay(short_t);
+    st1wire_platform_group_clear(pGroup);
+    st1wire_platform_delay(long_t);
+    /* - Send Byte (one BSRR write per edge for all the lines) */
+    for (i = 0; i < 8; i++) {
+        st1wire_platform_group_set(pGroup);
+        st1wire_platform_delay((byte & (1 << (7 - i))) ? long_t : short_t);
+        st1wire_platform_group_clear(pGroup);
+        st1wire_platform_delay((byte & (1 << (7 - i))) ? short_t : long_t);
+    }
+    /* - Release the STWire lines */
+    st1wire_platform_group_set(pGroup);
+    st1wire_platform_group_in(pGroup);
+
+    /* - Wait for low then high level on each line */
+    wait_low = pGroup->bus_mask;
+    wait_high = 0;
+    st1wire_platform_start_timeout(2 * ST1WIRE_ACK_TIMEOUT);
+    while ((wait_low | wait_high) != 0) {
+        level = st1wire_platform_group_get(pGroup);
+        wait_high = (wait_high | (wait_low & ~level)) & ~(wait_high & level);
+        wait_low &= level;
+        if (st1wire_platform_is_timeout_exceeded()) {
+            break;
+        }
+    }
+    ST1WIRE_END_CRITICAL_SECTION
+
+    /* - Drop lines without acknowledge from the group */
+    if ((wait_low | wait_high) != 0) {
+        st1wire_platform_group_init(pGroup->bus_mask & ~(wait_low | wait_high), pGroup);
+    }
+}
+
+static ST1WIRE_RAMFUNC void _st1wire_group_ReceiveByte(st1wire_platform_group_t *pGroup, const st1wire_timing_t *pTiming, uint8_t *rcv_bytes) {
+    uint32_t delay_high[ST1WIRE_PLATFORM_BUS_COUNT] = {0};
+    uint32_t delay_low[ST1WIRE_PLATFORM_BUS_COUNT] = {0};
+    uint8_t bit_count[ST1WIRE_PLATFORM_BUS_COUNT] = {0};
+    uint32_t pending = pGroup->bus_mask;
+    uint32_t failed = 0;
+    uint32_t level, previous, line;
+    uint8_t i;
+
+    ST1WIRE_START_CRITICAL_SECTION
+    /* - Send sync bit('1') */
+    st1wire_platform_group_out(pGroup);
+    st1wire_platform_group_set(pGroup);
+    st1wire_platform_delay(pTiming->long_pulse);
+    st1wire_platform_group_clear(pGroup);
+    st1wire_platform_delay(pTiming->long_pulse);
+    st1wire_platform_group_set(pGroup);
+    st1wire_platform_group_in(pGroup);
+
+    /* - Measure each line high/low durations from the same IDR samples */
+    previous = st1wire_platform_group_get(pGroup);
+    st1wire_platform_start_timeout(ST1WIRE_RECEIVE_TIMEOUT);
+    while (pending != 0) {
+        level = st1wire_platform_group_get(pGroup);
+        /* - Lines without edge for ST1WIRE_RECEIVE_TIMEOUT us are dropped */
+        if (((level ^ previous) & pending) != 0) {
+            st1wire_platform_start_timeout(ST1WIRE_RECEIVE_TIMEOUT);
+        } else if (st1wire_platform_is_timeout_exceeded()) {
+            failed |= pending;
+            break;
+        }
+        previous = level;
+        for (i = 0; i < ST1WIRE_PLATFORM_BUS_COUNT; i++) {
+            line = 1UL << i;
+            if ((pending & line) == 0) {
+                continue;
+            }
+            if (level & line) {
+                if (delay_low[i] != 0) {
+                    /* - Rising edge : store bit value */
+                    rcv_bytes[i] = (uint8_t)(rcv_bytes[i] << 1) | ((delay_high[i] > delay_low[i]) ? 1 : 0);
+                    delay_high[i] = 0;
+                    delay_low[i] = 0;
+                    if (++bit_count[i] == 8) {
+                        pending &= ~line;
+                        continue;
+                    }
+                }
+                delay_high[i]++;
+            } else {
+                delay_low[i]++;
+            }
+        }
+    }
+
+    /* - Acknowledge the byte reception on all the lines */
+    st1wire_platform_group_out(pGroup);
+    st1wire_platform_group_clear(pGroup);
+    st1wire_platform_delay(pTiming->ack_pulse);
+    st1wire_platform_group_set(pGroup);
+    ST1WIRE_END_CRITICAL_SECTION
+
+    if (failed != 0) {
+        st1wire_platform_group_init(pGroup->bus_mask & ~failed, pGroup);
+    }
+}
 
 /* ---------- Exported functions Declarations ---------- */
 
+const st1wire_timing_t *st1wire_timing_get(uint8_t bus_addr, uint8_t dev_addr, uint8_t speed) {
+    st1wire_timing_profile_t *pProfile = _st1wire_timing_find(bus_addr, dev_addr, speed);
+
+    if (pProfile != NULL) {
+        return &pProfile->timing;
+    }
+    return &st1wire_default_timing[(speed == 0) ? 0 : 1];
+}
+
+st1wire_ReturnCode_t st1wire_timing_set(uint8_t bus_addr, uint8_t dev_addr, uint8_t speed, const st1wire_timing_t *pTiming) {
+    st1wire_timing_profile_t *pProfile = _st1wire_timing_find(bus_addr, dev_addr, speed);
+    uint8_t i;
+
+    if (pTiming == NULL) {
+        if (pProfile != NULL) {
+            pProfile->valid = 0;
+        }
+        return ST1WIRE_OK;
+    }
+
+    for (i = 0; (pProfile == NULL) && (i < ST1WIRE_TIMING_PROFILE_COUNT); i++) {
+        if (!st1wire_timing_profiles[i].valid) {
+            pProfile = &st1wire_timing_profiles[i];
+        }
+    }
+    if (pProfile == NULL) {
+        return ST1WIRE_INVALID_PARAMETER;
+    }
+
+    pProfile->bus_addr = bus_addr;
+    pProfile->dev_addr = dev_addr;
+    pProfile->speed = speed;
+    pProfile->timing = *pTiming;
+    pProfile->valid = 1;
+
+    return ST1WIRE_OK;
+}
+
+st1wire_ReturnCode_t st1wire_calibrate(uint8_t bus_addr,
+                                       uint8_t dev_addr,
+                                       uint8_t speed,
+                                       st1wire_probe_t probe,
+                                       void *pCtx,
+                                       st1wire_timing_t *pTiming) {
+    const st1wire_timing_t *pDefault = &st1wire_default_timing[(speed == 0) ? 0 : 1];
+    st1wire_timing_t best = *pDefault;
+    st1wire_timing_t candidate = *pDefault;
+
+    if (probe == NULL) {
+        return ST1WIRE_INVALID_PARAMETER;
+    }
+
+    /* - Reserve a profile slot for the device */
+    if (st1wire_timing_set(bus_addr, dev_addr, speed, &candidate) != ST1WIRE_OK) {
+        return ST1WIRE_INVALID_PARAMETER;
+    }
+
+    /* - Check the device answers with default timings */
+    if (!_st1wire_calibration_probe(bus_addr, dev_addr, speed, probe, pCtx, &candidate)) {
+        return ST1WIRE_CALIBRATION_ERROR;
+    }
+
+    /* - Long pulse width (kept distinguishable from the short pulse) */
+    while (candidate.long_pulse > (candidate.short_pulse + ST1WIRE_CALIBRATION_PULSE_STEP)) {
+        candidate.long_pulse -= ST1WIRE_CALIBRATION_PULSE_STEP;
+        if (!_st1wire_calibration_probe(bus_addr, dev_addr, speed, probe, pCtx, &candidate)) {
+            break;
+        }
+        best.long_pulse = candidate.long_pulse;
+    }
+    best.long_pulse = _st1wire_timing_add_margin(best.long_pulse, pDefault->long_pulse);
+    candidate = best;
+
+    /* - Inter-byte delay */
+    while (candidate.inter_byte_delay >= ST1WIRE_CALIBRATION_INTER_BYTE_STEP) {
+        candidate.inter_byte_delay -= ST1WIRE_CALIBRATION_INTER_BYTE_STEP;
+        if (!_st1wire_calibration_probe(bus_addr, dev_addr, speed, probe, pCtx, &candidate)) {
+            break;
+        }
+        best.inter_byte_delay = candidate.inter_byte_delay;
+    }
+    best.inter_byte_delay = _st1wire_timing_add_margin(best.inter_byte_delay, pDefault->inter_byte_delay);
+    candidate = best;
+
+    /* - Inter-frame delay */
+    while (candidate.inter_frame_delay >= ST1WIRE_CALIBRATION_INTER_FRAME_STEP) {
+        candidate.inter_frame_delay -= ST1WIRE_CALIBRATION_INTER_FRAME_STEP;
+        if (!_st1wire_calibration_probe(bus_addr, dev_addr, speed, probe, pCtx, &candidate)) {
+            break;
+        }
+        best.inter_frame_delay = candidate.inter_frame_delay;
+    }
+    best.inter_frame_delay = _st1wire_timing_add_margin(best.inter_frame_delay, pDefault->inter_frame_delay);
+
+    /* - Validate and store the tuned profile */
+    if (!_st1wire_calibration_probe(bus_addr, dev_addr, speed, probe, pCtx, &best)) {
+        best = *pDefault;
+        st1wire_timing_set(bus_addr, dev_addr, speed, NULL);
+    }
+
+    if (pTiming != NULL) {
+        *pTiming = best;
+    }
+
+    return ST1WIRE_OK;
+}
+
+st1wire_ReturnCode_t st1wire_SendFrameBroadcast(uint32_t bus_mask,
+                                                uint8_t dev_addr,
+                                                uint8_t speed,
+                                                uint8_t *frame,
+                                                uint16_t frame_length,
+                                                uint32_t *pAck_mask) {
+    const st1wire_timing_t *pTiming = st1wire_timing_get(ST1WIRE_BROADCAST_TIMING_BUS, dev_addr, speed);
+    st1wire_platform_group_t group;
+    uint8_t rcv_bytes[ST1WIRE_PLATFORM_BUS_COUNT] = {0};
+    uint32_t ack_mask = 0;
+    int8_t ret;
+    uint16_t i;
+
+    if (pAck_mask != NULL) {
+        *pAck_mask = 0;
+    }
+    if (!st1wire_platform_group_init(bus_mask, &group)) {
+        return ST1WIRE_INVALID_PARAMETER;
+    }
+
+    /* - Get bus Arbitration and send Start of frame on all the lines */
+    ret = _st1wire_group_SendStart(&group, speed, pTiming);
+    if (ret == ST1WIRE_OK) {
+        if (dev_addr != 0) {
+            /* - Send device Address */
+            _st1wire_group_SendByte(&group, pTiming, dev_addr);
+            st1wire_platform_delay(pTiming->inter_byte_delay);
+        }
+        /* - Send Frame length */
+#ifndef ST1WIRE_NO_LEN_FIX
+        if (group.bus_mask != 0) {
+            _st1wire_group_SendByte(&group, pTiming, ((frame_length >> 8) & 0b111));
+            st1wire_platform_delay(pTiming->inter_byte_delay);
+        }
+#endif
+        if (group.bus_mask != 0) {
+            _st1wire_group_SendByte(&group, pTiming, (frame_length & 0xFF));
+        }
+        /* - Send Frame content */
+        for (i = 0; (i < frame_length) && (group.bus_mask != 0); i++) {
+            st1wire_platform_delay(pTiming->inter_byte_delay);
+            _st1wire_group_SendByte(&group, pTiming, frame[i]);
+        }
+        /* - Get Frame Ack */
+        if (group.bus_mask != 0) {
+            st1wire_platform_delay(pTiming->inter_byte_delay);
+            _st1wire_group_ReceiveByte(&group, pTiming, rcv_bytes);
+            for (i = 0; i < ST1WIRE_PLATFORM_BUS_COUNT; i++) {
+                if ((group.bus_mask & (1UL << i)) && (rcv_bytes[i] == 0x20)) {
+                    ack_mask |= 1UL << i;
+                }
+            }
+        }
+        if (ack_mask != bus_mask) {
+            ret = ST1WIRE_BUS_ACK_ERROR;
+        }
+    }
+
+    // Delay in ST1Wire slow to allow STICK Vcc to stabilize
+    st1wire_platform_delay(pTiming->inter_frame_delay);
+
+    if (pAck_mask != NULL) {
+        *pAck_mask = ack_mask;
+    }
+
+    return (st1wire_ReturnCode_t)ret;
+}
+
 st1wire_ReturnCode_t st1wire_init(void) {
     st1wire_platform_init();
+#ifdef ST1WIRE_ASYNC_ENGINE
+    st1wire_platform_async_init();
+#endif
     return ST1WIRE_OK;
 }
 
@@ -199,114 +608,172 @@ st1wire_ReturnCode_t st1wire_deinit(void) {
     return ST1WIRE_OK;
 }
 
+#ifdef ST1WIRE_ASYNC_ENGINE
 st1wire_ReturnCode_t st1wire_SendFrame(uint8_t bus_addr,
                                        uint8_t dev_addr,
                                        uint8_t speed,
                                        uint8_t *frame,
                                        uint16_t frame_length) {
-    uint8_t recv_byte;
+    st1wire_ReturnCode_t ret;
+
+    st1wire_sync_done = 0;
+    ret = st1wire_async_SendFrame(bus_addr, dev_addr, speed, frame, frame_length, _st1wire_sync_callback, NULL);
+    if (ret != ST1WIRE_OK) {
+        return ret;
+    }
+
+    return _st1wire_sync_wait();
+}
+
+st1wire_ReturnCode_t st1wire_ReceiveFrame(uint8_t bus_addr, uint8_t dev_addr, uint8_t speed, uint8_t *frame, uint16_t max_length, uint16_t *pframe_length) {
+    st1wire_ReturnCode_t ret;
+
+    st1wire_sync_done = 0;
+    ret = st1wire_async_ReceiveFrame(bus_addr, dev_addr, speed, frame, max_length, pframe_length, _st1wire_sync_callback, NULL);
+    if (ret != ST1WIRE_OK) {
+        return ret;
+    }
+
+    return _st1wire_sync_wait();
+}
+#else
+st1wire_ReturnCode_t st1wire_SendFrameStart(uint8_t bus_addr,
+                                            uint8_t dev_addr,
+                                            uint8_t speed,
+                                            uint16_t frame_length) {
+    const st1wire_timing_t *pTiming = st1wire_timing_get(bus_addr, dev_addr, speed);
     int8_t ret;
-    uint16_t i;
 
 #ifdef ST1WIRE_ENABLE_DEBUG_LOG
     ST1WIRE_DEBUG_PRINTF("\n\r; ST1Wire %d >", bus_addr);
 #endif
 
     /* - Get bus Arbitration and send Start of frame */
-    ret = _st1wire_SendStart(bus_addr, speed);
+    ret = _st1wire_SendStart(bus_addr, speed, pTiming);
     if (ret == ST1WIRE_OK) {
         if (dev_addr != 0) {
             /* - Send device Address */
-            ret = _st1wire_SendByte(bus_addr, speed, dev_addr);
+            ret = _st1wire_SendByte(bus_addr, pTiming, dev_addr);
             if (ret != ST1WIRE_OK) {
 #ifdef ST1WIRE_ENABLE_DEBUG_LOG
                 ST1WIRE_DEBUG_PRINTF(" ADDR ACK ERROR ");
 #endif
                 return ST1WIRE_BUS_ACK_ERROR;
             }
-            if (speed == 0) {
-                st1wire_platform_delay(ST1WIRE_2C_INTER_BYTE_DELAY);
-            } else {
-                st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
-            }
+            st1wire_platform_delay(pTiming->inter_byte_delay);
         }
         /* - Send Frame length */
 #ifndef ST1WIRE_NO_LEN_FIX
-        ret = _st1wire_SendByte(bus_addr, speed, ((frame_length >> 8) & 0b111));
+        ret = _st1wire_SendByte(bus_addr, pTiming, ((frame_length >> 8) & 0b111));
         if (ret == ST1WIRE_OK) {
-            if (speed == 0) {
-                st1wire_platform_delay(ST1WIRE_2C_INTER_BYTE_DELAY);
-            } else {
-                st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
-            }
+            st1wire_platform_delay(pTiming->inter_byte_delay);
 #endif
-            ret = _st1wire_SendByte(bus_addr, speed, (frame_length & 0xFF));
+            ret = _st1wire_SendByte(bus_addr, pTiming, (frame_length & 0xFF));
 #ifndef ST1WIRE_NO_LEN_FIX
         }
 #endif
-        if (ret == ST1WIRE_OK) {
-            /* - Send Frame content */
-            for (i = 0; i < frame_length; i++) {
-                if (speed == 0) {
-                    st1wire_platform_delay(ST1WIRE_2C_INTER_BYTE_DELAY);
-                } else {
-                    st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
-                }
-                ret = _st1wire_SendByte(bus_addr, speed, frame[i]);
-                if (ret == ST1WIRE_BUS_ACK_ERROR) {
+    }
+
+    if (ret != ST1WIRE_OK) {
+        // Delay in ST1Wire slow to allow STICK Vcc to stabilize
+        st1wire_platform_delay(pTiming->inter_frame_delay);
+        return (st1wire_ReturnCode_t)ret;
+    }
+
+    st1wire_stream.pTiming = pTiming;
+    st1wire_stream.remaining = frame_length;
+
+    return ST1WIRE_OK;
+}
+
+st1wire_ReturnCode_t st1wire_SendFrameContinue(uint8_t bus_addr, uint8_t *pData, uint16_t length) {
+    int8_t ret = ST1WIRE_OK;
+    uint16_t i;
+
+    if (length > st1wire_stream.remaining) {
+        return ST1WIRE_INVALID_PARAMETER;
+    }
+
+    /* - Send Frame content */
+    for (i = 0; i < length; i++) {
+        st1wire_platform_delay(st1wire_stream.pTiming->inter_byte_delay);
+        ret = _st1wire_SendByte(bus_addr, st1wire_stream.pTiming, (pData == NULL) ? 0x00 : pData[i]);
+        if (ret == ST1WIRE_BUS_ACK_ERROR) {
 #ifdef ST1WIRE_ENABLE_DEBUG_LOG
-                    ST1WIRE_DEBUG_PRINTF(" DATA %d ACK ERROR ", i);
+            ST1WIRE_DEBUG_PRINTF(" DATA %d ACK ERROR ", i);
 #endif
-                    break;
-                }
-            }
-            /* - Get Frame Ack */
-            if (ret == ST1WIRE_OK) {
-                if (speed == 0) {
-                    st1wire_platform_delay(ST1WIRE_2C_INTER_BYTE_DELAY);
-                } else {
-                    st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
-                }
-                ret = _st1wire_ReceiveByte(bus_addr, speed, &recv_byte);
-                if ((ret == ST1WIRE_OK) && (recv_byte != 0x20)) {
+            st1wire_platform_delay(st1wire_stream.pTiming->inter_frame_delay);
+            st1wire_stream.remaining = 0;
+            return ST1WIRE_BUS_ACK_ERROR;
+        }
 #ifdef ST1WIRE_ENABLE_DEBUG_LOG
-                    ST1WIRE_DEBUG_PRINTF(" Frame ACK ERROR ");
+        ST1WIRE_DEBUG_PRINTF(" %02X", (pData == NULL) ? 0x00 : pData[i]);
 #endif
-                    ret = ST1WIRE_BUS_ACK_ERROR;
-                }
-            }
-        }
     }
+    st1wire_stream.remaining -= length;
 
-#ifdef ST1WIRE_ENABLE_DEBUG_LOG
-    for (i = 0; i < frame_length; i++) {
-        ST1WIRE_DEBUG_PRINTF(" %02X", *(frame + i));
+    return ST1WIRE_OK;
+}
+
+st1wire_ReturnCode_t st1wire_SendFrameStop(uint8_t bus_addr) {
+    uint8_t recv_byte;
+    int8_t ret;
+
+    if (st1wire_stream.remaining != 0) {
+        return ST1WIRE_INVALID_PARAMETER;
     }
+
+    /* - Get Frame Ack */
+    st1wire_platform_delay(st1wire_stream.pTiming->inter_byte_delay);
+    ret = _st1wire_ReceiveByte(bus_addr, st1wire_stream.pTiming, &recv_byte);
+    if ((ret == ST1WIRE_OK) && (recv_byte != 0x20)) {
+#ifdef ST1WIRE_ENABLE_DEBUG_LOG
+        ST1WIRE_DEBUG_PRINTF(" Frame ACK ERROR ");
 #endif
+        ret = ST1WIRE_BUS_ACK_ERROR;
+    }
 
     // Delay in ST1Wire slow to allow STICK Vcc to stabilize
-    if (speed == 0) {
-        st1wire_platform_delay(ST1WIRE_2C_INTER_FRAME_DELAY);
-    } else {
-        st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
-    }
+    st1wire_platform_delay(st1wire_stream.pTiming->inter_frame_delay);
 
     return (st1wire_ReturnCode_t)ret;
 }
 
-st1wire_ReturnCode_t st1wire_ReceiveFrame(uint8_t bus_addr, uint8_t dev_addr, uint8_t speed, uint8_t *frame, uint16_t *pframe_length) {
+st1wire_ReturnCode_t st1wire_SendFrame(uint8_t bus_addr,
+                                       uint8_t dev_addr,
+                                       uint8_t speed,
+                                       uint8_t *frame,
+                                       uint16_t frame_length) {
+    st1wire_ReturnCode_t ret;
+
+    ret = st1wire_SendFrameStart(bus_addr, dev_addr, speed, frame_length);
+    if (ret == ST1WIRE_OK) {
+        ret = st1wire_SendFrameContinue(bus_addr, frame, frame_length);
+    }
+    if (ret == ST1WIRE_OK) {
+        ret = st1wire_SendFrameStop(bus_addr);
+    }
+
+    return ret;
+}
+
+st1wire_ReturnCode_t st1wire_ReceiveFrameStart(uint8_t bus_addr,
+                                               uint8_t dev_addr,
+                                               uint8_t speed,
+                                               uint16_t max_length,
+                                               uint16_t *pframe_length) {
+    const st1wire_timing_t *pTiming = st1wire_timing_get(bus_addr, dev_addr, speed);
     volatile uint8_t ret = ST1WIRE_BUS_ACK_ERROR;
-    volatile uint16_t i;
     uint8_t rcv_byte;
 
     /* - Get bus Arbitration and send Start of frame */
-    ret = _st1wire_SendStart(bus_addr, speed);
+    ret = _st1wire_SendStart(bus_addr, speed, pTiming);
     /* - Request Frame reception (frame length = 0x00) */
     if (ret == ST1WIRE_OK) {
 
         if (dev_addr != 0) {
             /* - Send device Address */
-            ret = _st1wire_SendByte(bus_addr, speed, dev_addr);
+            ret = _st1wire_SendByte(bus_addr, pTiming, dev_addr);
             if (ret != ST1WIRE_OK) // Target STICK Addr)
             {
 #ifdef ST1WIRE_ENABLE_DEBUG_LOG
@@ -314,21 +781,13 @@ st1wire_ReturnCode_t st1wire_ReceiveFrame(uint8_t bus_addr, uint8_t dev_addr, ui
 #endif
                 return ST1WIRE_BUS_ACK_ERROR;
             }
-            if (speed == 0) {
-                st1wire_platform_delay(ST1WIRE_2C_INTER_FRAME_DELAY);
-            } else {
-                st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
-            }
+            st1wire_platform_delay(pTiming->inter_frame_delay);
         }
-        ret = _st1wire_SendByte(bus_addr, speed, 0x00);
+        ret = _st1wire_SendByte(bus_addr, pTiming, 0x00);
 #ifndef ST1WIRE_NO_LEN_FIX
         if (ret == ST1WIRE_OK) {
-            if (speed == 0) {
-                st1wire_platform_delay(ST1WIRE_2C_INTER_FRAME_DELAY);
-            } else {
-                st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
-            }
-            ret = _st1wire_SendByte(bus_addr, speed, 0x00);
+            st1wire_platform_delay(pTiming->inter_frame_delay);
+            ret = _st1wire_SendByte(bus_addr, pTiming, 0x00);
         }
 #endif
     }
@@ -341,70 +800,113 @@ st1wire_ReturnCode_t st1wire_ReceiveFrame(uint8_t bus_addr, uint8_t dev_addr, ui
     }
 
     /* - Get Request ACK */
-    if (speed == 0) {
-        st1wire_platform_delay(ST1WIRE_2C_INTER_BYTE_DELAY);
-    } else {
-        st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
+    st1wire_platform_delay(pTiming->inter_byte_delay);
+    ret = _st1wire_ReceiveByte(bus_addr, pTiming, &rcv_byte);
+    if ((ret != ST1WIRE_OK) || (rcv_byte != 0x20)) {
+#ifdef ST1WIRE_ENABLE_DEBUG_LOG
+        ST1WIRE_DEBUG_PRINTF("\n\r; ST1Wire %d < BYTE ACK ERROR", bus_addr);
+#endif
+        return ST1WIRE_BUS_ACK_ERROR;
     }
+
+    /* - Get Frame length */
+    *pframe_length = 0;
+    st1wire_platform_delay(pTiming->inter_byte_delay);
+    ret = _st1wire_ReceiveByte(bus_addr, pTiming, &rcv_byte);
+#ifndef ST1WIRE_NO_LEN_FIX
     if (ret == ST1WIRE_OK) {
-        ret = _st1wire_ReceiveByte(bus_addr, speed, &rcv_byte);
+        *pframe_length = rcv_byte << 8;
+        st1wire_platform_delay(pTiming->inter_byte_delay);
+        ret = _st1wire_ReceiveByte(bus_addr, pTiming, &rcv_byte);
     }
-    if ((ret == ST1WIRE_OK) && (rcv_byte == 0x20)) {
-        if (speed == 0) {
-            st1wire_platform_delay(ST1WIRE_2C_INTER_BYTE_DELAY);
-        } else {
-            st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
-        }
-        /* - Get Frame length */
-        ret = _st1wire_ReceiveByte(bus_addr, speed, &rcv_byte);
-#ifndef ST1WIRE_NO_LEN_FIX
-        if (ret == ST1WIRE_OK) {
-            *pframe_length = rcv_byte << 8;
-            if (speed == 0) {
-                st1wire_platform_delay(ST1WIRE_2C_INTER_BYTE_DELAY);
-            } else {
-                st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
-            }
-            ret = _st1wire_ReceiveByte(bus_addr, speed, &rcv_byte);
-        }
 #endif
-        if (ret == ST1WIRE_OK) {
-            *pframe_length += rcv_byte;
-            for (i = 0; i < *pframe_length; i++) {
-                if (speed == 0) {
-                    st1wire_platform_delay(ST1WIRE_2C_INTER_BYTE_DELAY);
-                } else {
-                    st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
-                }
-                ret = _st1wire_ReceiveByte(bus_addr, speed, frame + i);
-                if (ret != ST1WIRE_OK) {
-                    break;
-                }
-            }
-        }
-    } else {
+    if (ret != ST1WIRE_OK) {
+        st1wire_platform_delay(pTiming->inter_frame_delay);
+        return (st1wire_ReturnCode_t)ret;
+    }
+    *pframe_length += rcv_byte;
+
+    /* - Abort before the payload if it can't fit the applicative buffers */
+    if (*pframe_length > max_length) {
 #ifdef ST1WIRE_ENABLE_DEBUG_LOG
-        ST1WIRE_DEBUG_PRINTF("\n\r; ST1Wire %d < BYTE ACK ERROR", bus_addr);
+        ST1WIRE_DEBUG_PRINTF("\n\r; ST1Wire %d < FRAME LENGTH %d OVERFLOW", bus_addr, *pframe_length);
 #endif
-        return ST1WIRE_BUS_ACK_ERROR;
+        st1wire_recovery(bus_addr, speed);
+        st1wire_platform_delay(pTiming->inter_frame_delay);
+        return ST1WIRE_FRAME_OVERFLOW;
     }
 
-    // Delay in ST1Wire slow to allow STICK Vcc to stabilize
-    if (speed == 0) {
-        st1wire_platform_delay(ST1WIRE_2C_INTER_FRAME_DELAY);
-    } else {
-        st1wire_platform_delay(ST1WIRE_3C_INTER_BYTE_DELAY);
-    }
+    st1wire_stream.pTiming = pTiming;
+    st1wire_stream.remaining = *pframe_length;
 
 #ifdef ST1WIRE_ENABLE_DEBUG_LOG
     ST1WIRE_DEBUG_PRINTF("\n\r; ST1Wire %d <", bus_addr);
-    for (i = 0; i < *pframe_length; i++) {
-        ST1WIRE_DEBUG_PRINTF(" %02X", *(frame + i));
+#endif
+
+    return ST1WIRE_OK;
+}
+
+st1wire_ReturnCode_t st1wire_ReceiveFrameContinue(uint8_t bus_addr, uint8_t *pData, uint16_t length) {
+    int8_t ret;
+    uint8_t rcv_byte;
+    uint16_t i;
+
+    if (length > st1wire_stream.remaining) {
+        return ST1WIRE_INVALID_PARAMETER;
     }
+
+    /* - Receive bytes straight into the applicative fragment (discarded if NULL) */
+    for (i = 0; i < length; i++) {
+        st1wire_platform_delay(st1wire_stream.pTiming->inter_byte_delay);
+        ret = _st1wire_ReceiveByte(bus_addr, st1wire_stream.pTiming, &rcv_byte);
+        if (ret != ST1WIRE_OK) {
+            st1wire_platform_delay(st1wire_stream.pTiming->inter_frame_delay);
+            st1wire_stream.remaining = 0;
+            return (st1wire_ReturnCode_t)ret;
+        }
+        if (pData != NULL) {
+            pData[i] = rcv_byte;
+        }
+#ifdef ST1WIRE_ENABLE_DEBUG_LOG
+        ST1WIRE_DEBUG_PRINTF(" %02X", rcv_byte);
 #endif
+    }
+    st1wire_stream.remaining -= length;
 
-    return (st1wire_ReturnCode_t)ret;
+    return ST1WIRE_OK;
+}
+
+st1wire_ReturnCode_t st1wire_ReceiveFrameStop(uint8_t bus_addr) {
+    st1wire_ReturnCode_t ret = ST1WIRE_OK;
+
+    /* - Drain bytes not claimed by the application */
+    if (st1wire_stream.remaining != 0) {
+        ret = st1wire_ReceiveFrameContinue(bus_addr, NULL, st1wire_stream.remaining);
+        if (ret != ST1WIRE_OK) {
+            return ret;
+        }
+    }
+
+    // Delay in ST1Wire slow to allow STICK Vcc to stabilize
+    st1wire_platform_delay(st1wire_stream.pTiming->inter_frame_delay);
+
+    return ret;
+}
+
+st1wire_ReturnCode_t st1wire_ReceiveFrame(uint8_t bus_addr, uint8_t dev_addr, uint8_t speed, uint8_t *frame, uint16_t max_length, uint16_t *pframe_length) {
+    st1wire_ReturnCode_t ret;
+
+    ret = st1wire_ReceiveFrameStart(bus_addr, dev_addr, speed, max_length, pframe_length);
+    if (ret == ST1WIRE_OK) {
+        ret = st1wire_ReceiveFrameContinue(bus_addr, frame, *pframe_length);
+    }
+    if (ret == ST1WIRE_OK) {
+        ret = st1wire_ReceiveFrameStop(bus_addr);
+    }
+
+    return ret;
 }
+#endif /* ST1WIRE_ASYNC_ENGINE */
 
 void st1wire_wake(uint8_t bus_addr) {
     st1wire_platform_wake(bus_addr);
@@ -20,12 +20,14 @@
 
 #include "st1wire_platform.h"
 #include "stm32l4xx.h"
+#include <stddef.h>
 
 /******************************* TIMINGS DEFINITIONS ***************************************/
 
 /* - ST1Wire timings configuration (in us) */
 #define ST1WIRE_IDLE 100
 #define ST1WIRE_RECEIVE_TIMEOUT 34464
+#define ST1WIRE_ACK_TIMEOUT 50
 
 /* ST1Wire 3-Contact configuration  */
 #define ST1WIRE_3C_LONG_PULSE 5
@@ -45,6 +47,24 @@
 
 //#define ST1WIRE_NO_LEN_FIX
 
+/* ST1Wire timing profiles (see st1wire_timing_set / st1wire_calibrate) */
+#define ST1WIRE_TIMING_PROFILE_COUNT 4
+
+/* ST1Wire calibration settings */
+#define ST1WIRE_CALIBRATION_PROBE_COUNT 4     /* Consecutive successful probes required per candidate */
+#define ST1WIRE_CALIBRATION_MARGIN_PERCENT 25 /* Safety margin added to the reliable minimum */
+#define ST1WIRE_CALIBRATION_INTER_BYTE_STEP 8
+#define ST1WIRE_CALIBRATION_INTER_FRAME_STEP 50
+#define ST1WIRE_CALIBRATION_PULSE_STEP 1
+
+/* Timing profile used by broadcast frames (profile of this bus index) */
+#define ST1WIRE_BROADCAST_TIMING_BUS 0
+
+/* Event driven engine (see st1wire_async.h) : frames are sent/received from
+ * timer and line edge interrupts, st1wire_SendFrame/st1wire_ReceiveFrame
+ * become blocking wrappers waiting for the transfer completion */
+//#define ST1WIRE_ASYNC_ENGINE
+
 /*********************** Exported functions ***************************************/
 
 /** \defgroup st1wire ST1Wire Layer
@@ -56,9 +76,32 @@ typedef enum {
     ST1WIRE_OK = 0x00,
     ST1WIRE_BUS_ARBITRATION_FAULT,
     ST1WIRE_BUS_ACK_ERROR,
-    ST1WIRE_BUS_RECEIVE_TIMEOUT
+    ST1WIRE_BUS_RECEIVE_TIMEOUT,
+    ST1WIRE_BUS_BUSY,
+    ST1WIRE_INVALID_PARAMETER,
+    ST1WIRE_CALIBRATION_ERROR,
+    ST1WIRE_FRAME_OVERFLOW
 } st1wire_ReturnCode_t;
 
+typedef struct {
+    uint16_t long_pulse;
+    uint16_t short_pulse;
+    uint16_t ack_pulse;
+    uint16_t start_pulse;
+    uint16_t inter_byte_delay;
+    uint16_t inter_frame_delay;
+} st1wire_timing_t;
+
+/*!
+ * \brief	Calibration probe (i.e. echo command round trip with the target device)
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \param[in] dev_addr		Target device address
+ * \param[in] speed			Communication speed (0 : slow	1: fast)
+ * \param[in] pCtx			Applicative context
+ * \result  ST1WIRE_OK when the probe round trip succeeds ; error code otherwise
+ */
+typedef st1wire_ReturnCode_t (*st1wire_probe_t)(uint8_t bus_addr, uint8_t dev_addr, uint8_t speed, void *pCtx);
+
 /*!
  * \brief	Initialize ST1Wire bus
  * \result  ST1WIRE_OK on success ; st1wire_ReturnCode_t error code otherwise
@@ -89,14 +132,152 @@ extern st1wire_ReturnCode_t st1wire_SendFrame(uint8_t bus_addr,
  * \param[in] bus_addr		Index of the ST1Wire bus
  * \param[in] speed			Communication speed (0 : slow	1: fast)
  * \param[in] *frame		Pointer to the applicative receive buffer
+ * \param[in] max_length	Size of the applicative receive buffer
  * \parame[in] frame_length	Pointer to the applicative receive frame length variable
+ * \result  ST1WIRE_OK on success ; ST1WIRE_FRAME_OVERFLOW if the frame exceeds max_length ;
+ *          st1wire_ReturnCode_t error code otherwise
  */
 extern st1wire_ReturnCode_t st1wire_ReceiveFrame(uint8_t bus_addr,
                                                  uint8_t dev_addr,
                                                  uint8_t speed,
                                                  uint8_t *frame,
+                                                 uint16_t max_length,
                                                  uint16_t *pframe_length);
 
+#ifndef ST1WIRE_ASYNC_ENGINE
+/*!
+ * \brief					Start streamed frame transmission (start, address and length header)
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \param[in] dev_addr		Target device address (0 : no address byte)
+ * \param[in] speed			Communication speed (0 : slow	1: fast)
+ * \param[in] frame_length	Length of the Frame to be sent
+ * \result  ST1WIRE_OK on success ; st1wire_ReturnCode_t error code otherwise
+ */
+extern st1wire_ReturnCode_t st1wire_SendFrameStart(uint8_t bus_addr,
+                                                   uint8_t dev_addr,
+                                                   uint8_t speed,
+                                                   uint16_t frame_length);
+
+/*!
+ * \brief					Send next fragment of a streamed frame
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \param[in] *pData		Fragment to be sent (NULL : send zeros)
+ * \param[in] length		Fragment length
+ * \result  ST1WIRE_OK on success ; st1wire_ReturnCode_t error code otherwise
+ */
+extern st1wire_ReturnCode_t st1wire_SendFrameContinue(uint8_t bus_addr,
+                                                      uint8_t *pData,
+                                                      uint16_t length);
+
+/*!
+ * \brief					Complete streamed frame transmission (frame acknowledge)
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \result  ST1WIRE_OK on success ; st1wire_ReturnCode_t error code otherwise
+ */
+extern st1wire_ReturnCode_t st1wire_SendFrameStop(uint8_t bus_addr);
+
+/*!
+ * \brief					Start streamed frame reception (request and length header)
+ * \details					The frame length is checked before any payload byte is clocked :
+ *							an oversized frame is aborted with the bus recovery sequence
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \param[in] dev_addr		Target device address (0 : no address byte)
+ * \param[in] speed			Communication speed (0 : slow	1: fast)
+ * \param[in] max_length	Maximum accepted frame length
+ * \param[out] pframe_length	Received frame length
+ * \result  ST1WIRE_OK on success ; ST1WIRE_FRAME_OVERFLOW if the frame exceeds max_length ;
+ *			st1wire_ReturnCode_t error code otherwise
+ */
+extern st1wire_ReturnCode_t st1wire_ReceiveFrameStart(uint8_t bus_addr,
+                                                      uint8_t dev_addr,
+                                                      uint8_t speed,
+                                                      uint16_t max_length,
+                                                      uint16_t *pframe_length);
+
+/*!
+ * \brief					Receive next fragment of a streamed frame
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \param[out] *pData		Fragment destination (NULL : bytes are discarded)
+ * \param[in] length		Fragment length
+ * \result  ST1WIRE_OK on success ; st1wire_ReturnCode_t error code otherwise
+ */
+extern st1wire_ReturnCode_t st1wire_ReceiveFrameContinue(uint8_t bus_addr,
+                                                         uint8_t *pData,
+                                                         uint16_t length);
+
+/*!
+ * \brief					Complete streamed frame reception (remaining bytes are discarded)
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \result  ST1WIRE_OK on success ; st1wire_ReturnCode_t error code otherwise
+ */
+extern st1wire_ReturnCode_t st1wire_ReceiveFrameStop(uint8_t bus_addr);
+#endif /* ST1WIRE_ASYNC_ENGINE */
+
+/*!
+ * \brief					Send the same frame on several ST1Wire buses in lockstep
+ * \details					All the lines are driven with a single GPIO write per edge and
+ *							acknowledges are sampled in parallel. A line missing an acknowledge
+ *							is released and dropped for the rest of the frame.
+ * \param[in] bus_mask		Bit n set : frame sent on bus n (buses shall share a GPIO port)
+ * \param[in] dev_addr		Target device address (0 : no address byte)
+ * \param[in] speed			Communication speed (0 : slow	1: fast)
+ * \param[in] *frame		Pointer to the applicative transmit buffer
+ * \param[in] frame_length	Length of the Frame to be sent
+ * \param[out] pAck_mask	Buses which acknowledged the whole frame (optional)
+ * \result  ST1WIRE_OK if all the buses acknowledged ; ST1WIRE_BUS_ACK_ERROR if some did not ;
+ *			ST1WIRE_INVALID_PARAMETER if the buses can't be driven in lockstep
+ */
+extern st1wire_ReturnCode_t st1wire_SendFrameBroadcast(uint32_t bus_mask,
+                                                       uint8_t dev_addr,
+                                                       uint8_t speed,
+                                                       uint8_t *frame,
+                                                       uint16_t frame_length,
+                                                       uint32_t *pAck_mask);
+
+/*!
+ * \brief					Get timing profile used for a device
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \param[in] dev_addr		Target device address
+ * \param[in] speed			Communication speed (0 : slow	1: fast)
+ * \result  Stored device profile if any ; default profile of the speed otherwise
+ */
+extern const st1wire_timing_t *st1wire_timing_get(uint8_t bus_addr,
+                                                  uint8_t dev_addr,
+                                                  uint8_t speed);
+
+/*!
+ * \brief					Store timing profile used for all the traffic with a device
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \param[in] dev_addr		Target device address
+ * \param[in] speed			Communication speed (0 : slow	1: fast)
+ * \param[in] pTiming		Timing profile (NULL : restore default profile)
+ * \result  ST1WIRE_OK on success ; ST1WIRE_INVALID_PARAMETER if the profile table is full
+ */
+extern st1wire_ReturnCode_t st1wire_timing_set(uint8_t bus_addr,
+                                               uint8_t dev_addr,
+                                               uint8_t speed,
+                                               const st1wire_timing_t *pTiming);
+
+/*!
+ * \brief					Calibrate device timings
+ * \details					Probe the device while shortening pulse widths and delays from
+ *							their default values, keep the reliable minimum of each one plus
+ *							ST1WIRE_CALIBRATION_MARGIN_PERCENT and store the resulting profile
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \param[in] dev_addr		Target device address
+ * \param[in] speed			Communication speed (0 : slow	1: fast)
+ * \param[in] probe			Probe function (i.e. echo command)
+ * \param[in] pCtx			Applicative context passed to the probe
+ * \param[out] pTiming		Calibrated timing profile (optional)
+ * \result  ST1WIRE_OK on success ; ST1WIRE_CALIBRATION_ERROR if the default profile itself fails
+ */
+extern st1wire_ReturnCode_t st1wire_calibrate(uint8_t bus_addr,
+                                              uint8_t dev_addr,
+                                              uint8_t speed,
+                                              st1wire_probe_t probe,
+                                              void *pCtx,
+                                              st1wire_timing_t *pTiming);
+
 /*!
  * \brief					Wake ST1Wire device
  * \param[in] bus_addr		Index of the ST1Wire bus
@@ -0,0 +1,448 @@
+/**
+ ******************************************************************************
+ * \file    st1wire_async.c
+ * \brief	st1wire event driven driver (sources)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "st1wire_async.h"
+
+#ifdef ST1WIRE_ASYNC_ENGINE
+
+/* ---------- Static types Definition ---------- */
+
+typedef enum {
+    ST1WIRE_ASYNC_STATE_IDLE = 0,
+    ST1WIRE_ASYNC_STATE_ARBITRATION, /* Wait for ST1WIRE_IDLE us of idle line */
+    ST1WIRE_ASYNC_STATE_START,       /* Start pulse (line low) */
+    ST1WIRE_ASYNC_STATE_GAP,         /* Inter-byte delay */
+    ST1WIRE_ASYNC_STATE_TX_BIT,      /* Drive sync + data bits edges */
+    ST1WIRE_ASYNC_STATE_TX_ACK_LOW,  /* Wait for device acknowledge low level */
+    ST1WIRE_ASYNC_STATE_TX_ACK_HIGH, /* Wait for device acknowledge release */
+    ST1WIRE_ASYNC_STATE_RX_SYNC,     /* Drive sync bit edges */
+    ST1WIRE_ASYNC_STATE_RX_BIT,      /* Measure device data bits edges */
+    ST1WIRE_ASYNC_STATE_RX_ACK,      /* Drive byte acknowledge pulse */
+    ST1WIRE_ASYNC_STATE_END          /* Inter-frame delay */
+} st1wire_async_state_t;
+
+typedef enum {
+    ST1WIRE_ASYNC_PHASE_ADDR = 0,
+    ST1WIRE_ASYNC_PHASE_LEN_MSB,
+    ST1WIRE_ASYNC_PHASE_LEN_LSB,
+    ST1WIRE_ASYNC_PHASE_DATA,
+    ST1WIRE_ASYNC_PHASE_ACK,
+    ST1WIRE_ASYNC_PHASE_RSP_LEN_MSB,
+    ST1WIRE_ASYNC_PHASE_RSP_LEN_LSB,
+    ST1WIRE_ASYNC_PHASE_RSP_DATA
+} st1wire_async_phase_t;
+
+typedef struct {
+    volatile st1wire_async_state_t state;
+    st1wire_async_phase_t phase;
+    uint8_t receive; /* 0 : send frame ; 1 : receive frame */
+    uint8_t bus_addr;
+    uint8_t dev_addr;
+    uint8_t speed;
+    const st1wire_timing_t *pTiming;
+    uint8_t *frame;
+    uint16_t frame_length;
+    uint16_t max_length;
+    uint16_t *pframe_length;
+    uint16_t index;
+    uint8_t byte;
+    uint8_t edge;
+    uint32_t delay_high;
+    st1wire_async_callback_t callback;
+    void *pCtx;
+} st1wire_async_t;
+
+static st1wire_async_t st1wire_async;
+
+/* ---------- Static functions Definition ---------- */
+static void _st1wire_async_complete(st1wire_ReturnCode_t status);
+static void _st1wire_async_begin_byte(void);
+static void _st1wire_async_schedule(st1wire_async_phase_t phase, uint32_t gap);
+static void _st1wire_async_byte_done(void);
+static st1wire_ReturnCode_t _st1wire_async_start(void);
+
+/* ---------- Static functions Declarations ---------- */
+static void _st1wire_async_complete(st1wire_ReturnCode_t status) {
+    st1wire_platform_timer_stop();
+    st1wire_platform_edge_irq_disable(st1wire_async.bus_addr);
+    st1wire_platform_io_set(st1wire_async.bus_addr);
+    st1wire_platform_io_in(st1wire_async.bus_addr);
+
+    st1wire_async.state = ST1WIRE_ASYNC_STATE_IDLE;
+    if (st1wire_async.callback != NULL) {
+        st1wire_async.callback(status, st1wire_async.pCtx);
+    }
+}
+
+static void _st1wire_async_begin_byte(void) {
+    st1wire_async.edge = 0;
+    st1wire_platform_io_out(st1wire_async.bus_addr);
+    st1wire_platform_io_set(st1wire_async.bus_addr);
+
+    switch (st1wire_async.phase) {
+    case ST1WIRE_ASYNC_PHASE_ACK:
+    case ST1WIRE_ASYNC_PHASE_RSP_LEN_MSB:
+    case ST1WIRE_ASYNC_PHASE_RSP_LEN_LSB:
+    case ST1WIRE_ASYNC_PHASE_RSP_DATA:
+        /* - Send sync bit('1') : high level first */
+        st1wire_async.byte = 0;
+        st1wire_async.state = ST1WIRE_ASYNC_STATE_RX_SYNC;
+        st1wire_platform_timer_start(st1wire_async.pTiming->long_pulse);
+        break;
+    default:
+        switch (st1wire_async.phase) {
+        case ST1WIRE_ASYNC_PHASE_ADDR:
+            st1wire_async.byte = st1wire_async.dev_addr;
+            break;
+        case ST1WIRE_ASYNC_PHASE_LEN_MSB:
+            st1wire_async.byte = (uint8_t)((st1wire_async.frame_length >> 8) & 0b111);
+            break;
+        case ST1WIRE_ASYNC_PHASE_LEN_LSB:
+            st1wire_async.byte = (uint8_t)(st1wire_async.frame_length & 0xFF);
+            break;
+        default:
+            st1wire_async.byte = st1wire_async.frame[st1wire_async.index];
+            break;
+        }
+        /* - Send sync bit('1') : short high level first */
+        st1wire_async.state = ST1WIRE_ASYNC_STATE_TX_BIT;
+        st1wire_platform_timer_start(st1wire_async.pTiming->short_pulse);
+        break;
+    }
+}
+
+static void _st1wire_async_schedule(st1wire_async_phase_t phase, uint32_t gap) {
+    st1wire_async.phase = phase;
+    if (gap == 0) {
+        _st1wire_async_begin_byte();
+    } else {
+        st1wire_async.state = ST1WIRE_ASYNC_STATE_GAP;
+        st1wire_platform_timer_start(gap);
+    }
+}
+
+static void _st1wire_async_byte_done(void) {
+    uint32_t inter_byte_t = st1wire_async.pTiming->inter_byte_delay;
+    /* Slow mode request frame uses inter-frame delays to let STICK Vcc stabilize */
+    uint32_t request_t = st1wire_async.pTiming->inter_frame_delay;
+    uint32_t end_t = st1wire_async.pTiming->inter_frame_delay;
+
+    switch (st1wire_async.phase) {
+    case ST1WIRE_ASYNC_PHASE_ADDR:
+#ifndef ST1WIRE_NO_LEN_FIX
+        _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_LEN_MSB, st1wire_async.receive ? request_t : inter_byte_t);
+#else
+        _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_LEN_LSB, st1wire_async.receive ? request_t : inter_byte_t);
+#endif
+        break;
+
+    case ST1WIRE_ASYNC_PHASE_LEN_MSB:
+        _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_LEN_LSB, st1wire_async.receive ? request_t : inter_byte_t);
+        break;
+
+    case ST1WIRE_ASYNC_PHASE_LEN_LSB:
+        st1wire_async.index = 0;
+        if ((st1wire_async.receive == 0) && (st1wire_async.frame_length != 0)) {
+            _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_DATA, inter_byte_t);
+        } else {
+            _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_ACK, inter_byte_t);
+        }
+        break;
+
+    case ST1WIRE_ASYNC_PHASE_DATA:
+        st1wire_async.index++;
+        if (st1wire_async.index < st1wire_async.frame_length) {
+            _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_DATA, inter_byte_t);
+        } else {
+            _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_ACK, inter_byte_t);
+        }
+        break;
+
+    case ST1WIRE_ASYNC_PHASE_ACK:
+        if (st1wire_async.byte != 0x20) {
+            _st1wire_async_complete(ST1WIRE_BUS_ACK_ERROR);
+        } else if (st1wire_async.receive == 0) {
+            st1wire_async.state = ST1WIRE_ASYNC_STATE_END;
+            st1wire_platform_timer_start(end_t);
+        } else {
+#ifndef ST1WIRE_NO_LEN_FIX
+            _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_RSP_LEN_MSB, inter_byte_t);
+#else
+            *st1wire_async.pframe_length = 0;
+            _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_RSP_LEN_LSB, inter_byte_t);
+#endif
+        }
+        break;
+
+    case ST1WIRE_ASYNC_PHASE_RSP_LEN_MSB:
+        *st1wire_async.pframe_length = (uint16_t)st1wire_async.byte << 8;
+        _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_RSP_LEN_LSB, inter_byte_t);
+        break;
+
+    case ST1WIRE_ASYNC_PHASE_RSP_LEN_LSB:
+        *st1wire_async.pframe_length += st1wire_async.byte;
+        st1wire_async.index = 0;
+        /* - Abort before the payload if it can't fit the applicative buffer */
+        if (*st1wire_async.pframe_length > st1wire_async.max_length) {
+            _st1wire_async_complete(ST1WIRE_FRAME_OVERFLOW);
+        } else if (*st1wire_async.pframe_length != 0) {
+            _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_RSP_DATA, inter_byte_t);
+        } else {
+            st1wire_async.state = ST1WIRE_ASYNC_STATE_END;
+            st1wire_platform_timer_start(end_t);
+        }
+        break;
+
+    case ST1WIRE_ASYNC_PHASE_RSP_DATA:
+        st1wire_async.frame[st1wire_async.index++] = st1wire_async.byte;
+        if (st1wire_async.index < *st1wire_async.pframe_length) {
+            _st1wire_async_schedule(ST1WIRE_ASYNC_PHASE_RSP_DATA, inter_byte_t);
+        } else {
+            st1wire_async.state = ST1WIRE_ASYNC_STATE_END;
+            st1wire_platform_timer_start(end_t);
+        }
+        break;
+    }
+}
+
+static st1wire_ReturnCode_t _st1wire_async_start(void) {
+    /* - Wait for bus idle before getting bus arbitration */
+    st1wire_platform_io_in(st1wire_async.bus_addr);
+    st1wire_async.state = ST1WIRE_ASYNC_STATE_ARBITRATION;
+    st1wire_platform_edge_irq_enable(st1wire_async.bus_addr);
+    st1wire_platform_timer_start(ST1WIRE_IDLE);
+
+    return ST1WIRE_OK;
+}
+
+/* ---------- Exported functions Declarations ---------- */
+
+st1wire_ReturnCode_t st1wire_async_SendFrame(uint8_t bus_addr,
+                                             uint8_t dev_addr,
+                                             uint8_t speed,
+                                             uint8_t *frame,
+                                             uint16_t frame_length,
+                                             st1wire_async_callback_t callback,
+                                             void *pCtx) {
+    if (st1wire_async.state != ST1WIRE_ASYNC_STATE_IDLE) {
+        return ST1WIRE_BUS_BUSY;
+    }
+
+    st1wire_async.receive = 0;
+    st1wire_async.bus_addr = bus_addr;
+    st1wire_async.dev_addr = dev_addr;
+    st1wire_async.speed = speed;
+    st1wire_async.pTiming = st1wire_timing_get(bus_addr, dev_addr, speed);
+    st1wire_async.frame = frame;
+    st1wire_async.frame_length = frame_length;
+    st1wire_async.max_length = 0;
+    st1wire_async.pframe_length = NULL;
+    st1wire_async.callback = callback;
+    st1wire_async.pCtx = pCtx;
+
+    return _st1wire_async_start();
+}
+
+st1wire_ReturnCode_t st1wire_async_ReceiveFrame(uint8_t bus_addr,
+                                                uint8_t dev_addr,
+                                                uint8_t speed,
+                                                uint8_t *frame,
+                                                uint16_t max_length,
+                                                uint16_t *pframe_length,
+                                                st1wire_async_callback_t callback,
+                                                void *pCtx) {
+    if (st1wire_async.state != ST1WIRE_ASYNC_STATE_IDLE) {
+        return ST1WIRE_BUS_BUSY;
+    }
+
+    st1wire_async.receive = 1;
+    st1wire_async.bus_addr = bus_addr;
+    st1wire_async.dev_addr = dev_addr;
+    st1wire_async.speed = speed;
+    st1wire_async.pTiming = st1wire_timing_get(bus_addr, dev_addr, speed);
+    st1wire_async.frame = frame;
+    /* - Request Frame reception (frame length = 0x00) */
+    st1wire_async.frame_length = 0;
+    st1wire_async.max_length = max_length;
+    st1wire_async.pframe_length = pframe_length;
+    st1wire_async.callback = callback;
+    st1wire_async.pCtx = pCtx;
+
+    return _st1wire_async_start();
+}
+
+uint8_t st1wire_async_is_busy(void) {
+    return (st1wire_async.state != ST1WIRE_ASYNC_STATE_IDLE);
+}
+
+void st1wire_async_timer_event(void) {
+    uint8_t bit;
+
+    switch (st1wire_async.state) {
+    case ST1WIRE_ASYNC_STATE_ARBITRATION:
+        /* - No edge during ST1WIRE_IDLE : bus is idle */
+        st1wire_platform_edge_irq_disable(st1wire_async.bus_addr);
+        if (st1wire_platform_io_get(st1wire_async.bus_addr) == 0x00) {
+            _st1wire_async_complete(ST1WIRE_BUS_ARBITRATION_FAULT);
+            break;
+        }
+        /* - Set bus to low level */
+        st1wire_platform_io_out(st1wire_async.bus_addr);
+        st1wire_platform_io_clear(st1wire_async.bus_addr);
+        st1wire_async.state = ST1WIRE_ASYNC_STATE_START;
+        st1wire_platform_timer_start(st1wire_async.pTiming->start_pulse);
+        break;
+
+    case ST1WIRE_ASYNC_STATE_START:
+        st1wire_platform_io_set(st1wire_async.bus_addr);
+        _st1wire_async_schedule((st1wire_async.dev_addr != 0) ? ST1WIRE_ASYNC_PHASE_ADDR :
+#ifndef ST1WIRE_NO_LEN_FIX
+                                                                ST1WIRE_ASYNC_PHASE_LEN_MSB,
+#else
+                                                                ST1WIRE_ASYNC_PHASE_LEN_LSB,
+#endif
+                                (st1wire_async.speed == 0) ? st1wire_async.pTiming->inter_byte_delay : 0);
+        break;
+
+    case ST1WIRE_ASYNC_STATE_GAP:
+        _st1wire_async_begin_byte();
+        break;
+
+    case ST1WIRE_ASYNC_STATE_TX_BIT:
+        st1wire_async.edge++;
+        if (st1wire_async.edge == 1) {
+            /* - Sync bit low level */
+            st1wire_platform_io_clear(st1wire_async.bus_addr);
+            st1wire_platform_timer_start(st1wire_async.pTiming->long_pulse);
+        } else if (st1wire_async.edge < 18) {
+            /* - Data bits : MSB first, '1' = long high/short low, '0' = short high/long low */
+            bit = (st1wire_async.byte >> (7 - ((st1wire_async.edge - 2) >> 1))) & 0x01;
+            if ((st1wire_async.edge & 0x01) == 0) {
+                st1wire_platform_io_set(st1wire_async.bus_addr);
+                st1wire_platform_timer_start(bit ? st1wire_async.pTiming->long_pulse : st1wire_async.pTiming->short_pulse);
+            } else {
+                st1wire_platform_io_clear(st1wire_async.bus_addr);
+                st1wire_platform_timer_start(bit ? st1wire_async.pTiming->short_pulse : st1wire_async.pTiming->long_pulse);
+            }
+        } else {
+            /* - Release the ST1Wire line and wait for device acknowledge */
+            st1wire_platform_io_set(st1wire_async.bus_addr);
+            st1wire_platform_io_in(st1wire_async.bus_addr);
+            st1wire_async.state = ST1WIRE_ASYNC_STATE_TX_ACK_LOW;
+            st1wire_platform_edge_irq_enable(st1wire_async.bus_addr);
+            st1wire_platform_timer_start(ST1WIRE_ACK_TIMEOUT);
+            if (st1wire_platform_io_get(st1wire_async.bus_addr) == 0x00) {
+                st1wire_async.state = ST1WIRE_ASYNC_STATE_TX_ACK_HIGH;
+            }
+        }
+        break;
+
+    case ST1WIRE_ASYNC_STATE_RX_SYNC:
+        st1wire_async.edge++;
+        if (st1wire_async.edge == 1) {
+            st1wire_platform_io_clear(st1wire_async.bus_addr);
+            st1wire_platform_timer_start(st1wire_async.pTiming->long_pulse);
+        } else {
+            /* - Release line and measure device bits */
+            st1wire_platform_io_set(st1wire_async.bus_addr);
+            st1wire_platform_io_in(st1wire_async.bus_addr);
+            st1wire_async.edge = 0;
+            st1wire_async.delay_high = 0;
+            st1wire_async.state = ST1WIRE_ASYNC_STATE_RX_BIT;
+            st1wire_platform_edge_irq_enable(st1wire_async.bus_addr);
+            st1wire_platform_timer_start(ST1WIRE_RECEIVE_TIMEOUT);
+        }
+        break;
+
+    case ST1WIRE_ASYNC_STATE_RX_ACK:
+        st1wire_platform_io_set(st1wire_async.bus_addr);
+        _st1wire_async_byte_done();
+        break;
+
+    case ST1WIRE_ASYNC_STATE_END:
+        _st1wire_async_complete(ST1WIRE_OK);
+        break;
+
+    case ST1WIRE_ASYNC_STATE_TX_ACK_LOW:
+    case ST1WIRE_ASYNC_STATE_TX_ACK_HIGH:
+        _st1wire_async_complete(ST1WIRE_BUS_ACK_ERROR);
+        break;
+
+    case ST1WIRE_ASYNC_STATE_RX_BIT:
+        _st1wire_async_complete(ST1WIRE_BUS_RECEIVE_TIMEOUT);
+        break;
+
+    default:
+        break;
+    }
+}
+
+void st1wire_async_edge_event(void) {
+    uint32_t elapsed;
+    uint8_t level = st1wire_platform_io_get(st1wire_async.bus_addr);
+
+    switch (st1wire_async.state) {
+    case ST1WIRE_ASYNC_STATE_ARBITRATION:
+        /* - Bus activity : restart idle detection */
+        st1wire_platform_timer_start(ST1WIRE_IDLE);
+        break;
+
+    case ST1WIRE_ASYNC_STATE_TX_ACK_LOW:
+        if (level == 0) {
+            st1wire_async.state = ST1WIRE_ASYNC_STATE_TX_ACK_HIGH;
+        }
+        break;
+
+    case ST1WIRE_ASYNC_STATE_TX_ACK_HIGH:
+        if (level != 0) {
+            st1wire_platform_edge_irq_disable(st1wire_async.bus_addr);
+            st1wire_platform_timer_stop();
+            _st1wire_async_byte_done();
+        }
+        break;
+
+    case ST1WIRE_ASYNC_STATE_RX_BIT:
+        elapsed = st1wire_platform_timer_elapsed();
+        st1wire_platform_timer_start(ST1WIRE_RECEIVE_TIMEOUT);
+        if (level == 0) {
+            /* - End of high level */
+            st1wire_async.delay_high = elapsed;
+        } else {
+            /* - End of low level : store bit value depending on High/low delays duration */
+            st1wire_async.byte <<= 1;
+            if (st1wire_async.delay_high > elapsed) {
+                st1wire_async.byte |= 0x01;
+            }
+            st1wire_async.edge++;
+            if (st1wire_async.edge == 8) {
+                /* - Acknowledge the byte reception */
+                st1wire_platform_edge_irq_disable(st1wire_async.bus_addr);
+                st1wire_platform_io_out(st1wire_async.bus_addr);
+                st1wire_platform_io_clear(st1wire_async.bus_addr);
+                st1wire_async.state = ST1WIRE_ASYNC_STATE_RX_ACK;
+                st1wire_platform_timer_start(st1wire_async.pTiming->ack_pulse);
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+#endif /* ST1WIRE_ASYNC_ENGINE */
@@ -0,0 +1,98 @@
+/**
+ ******************************************************************************
+ * \file    st1wire_async.h
+ * \brief	st1wire event driven driver (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#ifndef ST1WIRE_ASYNC_H_
+#define ST1WIRE_ASYNC_H_
+
+#include "st1wire.h"
+
+/** \defgroup st1wire_async ST1Wire event driven engine
+ *  \brief ST1Wire frame state machine advanced from timer and line edge interrupts
+ *  \details Each interrupt performs a single line edge (or edge measurement) and
+ *           re-arms the platform timer for the next one. No scheduler suspension
+ *           is required : the only non-preemptible section is the interrupt itself.
+ *  @{
+*/
+
+/*!
+ * \brief	Frame completion callback
+ * \param[in] status	ST1WIRE_OK on success ; st1wire_ReturnCode_t error code otherwise
+ * \param[in] pCtx		Applicative context registered with the transfer
+ * \note	Called from interrupt context
+ */
+typedef void (*st1wire_async_callback_t)(st1wire_ReturnCode_t status, void *pCtx);
+
+/*!
+ * \brief					Start frame transmission on ST1Wire bus
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \param[in] dev_addr		Target device address (0 : no address byte)
+ * \param[in] speed			Communication speed (0 : slow	1: fast)
+ * \param[in] *frame		Pointer to the applicative transmit buffer (shall remain valid until completion)
+ * \param[in] frame_length	Length of the Frame to be sent
+ * \param[in] callback		Completion callback
+ * \param[in] pCtx			Applicative context passed to the callback
+ * \result  ST1WIRE_OK if the transfer is started ; ST1WIRE_BUS_BUSY if a transfer is already in progress
+ */
+extern st1wire_ReturnCode_t st1wire_async_SendFrame(uint8_t bus_addr,
+                                                    uint8_t dev_addr,
+                                                    uint8_t speed,
+                                                    uint8_t *frame,
+                                                    uint16_t frame_length,
+                                                    st1wire_async_callback_t callback,
+                                                    void *pCtx);
+
+/*!
+ * \brief					Start frame reception on ST1Wire bus
+ * \param[in] bus_addr		Index of the ST1Wire bus
+ * \param[in] dev_addr		Target device address (0 : no address byte)
+ * \param[in] speed			Communication speed (0 : slow	1: fast)
+ * \param[in] *frame		Pointer to the applicative receive buffer (shall remain valid until completion)
+ * \param[in] max_length	Size of the applicative receive buffer ; longer frames complete with
+ *							ST1WIRE_FRAME_OVERFLOW before any payload byte is stored
+ * \param[in] pframe_length	Pointer to the applicative receive frame length variable
+ * \param[in] callback		Completion callback
+ * \param[in] pCtx			Applicative context passed to the callback
+ * \result  ST1WIRE_OK if the transfer is started ; ST1WIRE_BUS_BUSY if a transfer is already in progress
+ */
+extern st1wire_ReturnCode_t st1wire_async_ReceiveFrame(uint8_t bus_addr,
+                                                       uint8_t dev_addr,
+                                                       uint8_t speed,
+                                                       uint8_t *frame,
+                                                       uint16_t max_length,
+                                                       uint16_t *pframe_length,
+                                                       st1wire_async_callback_t callback,
+                                                       void *pCtx);
+
+/*!
+ * \brief	Report engine activity
+ * \result  1 if a frame transfer is in progress ; 0 otherwise
+ */
+extern uint8_t st1wire_async_is_busy(void);
+
+/*!
+ * \brief	Timer expiry event (to be called from the platform timer interrupt)
+ */
+extern void st1wire_async_timer_event(void);
+
+/*!
+ * \brief	Line edge event (to be called from the platform line edge interrupt)
+ */
+extern void st1wire_async_edge_event(void);
+
+/*! @}*/
+
+#endif /* ST1WIRE_ASYNC_H_ */
@@ -6,21 +6,76 @@
 
 #include "Drivers/delay_ms/delay_ms.h"
 #include "Drivers/delay_us/delay_us.h"
+#include "st1wire_async.h"
 #include "stm32l4xx.h"
 
 extern uint32_t SystemCoreClock;
 volatile uint32_t st1wire_ref_cpu_cycles = 0;
 
+/* - ST1Wire bus table (index = bus_addr) */
+static const st1wire_platform_bus_t st1wire_platform_bus[ST1WIRE_PLATFORM_BUS_COUNT] = {
+    {ST1WIRE_PLATFORM_BUS0_PORT, ST1WIRE_PLATFORM_BUS0_PIN},
+#if ST1WIRE_PLATFORM_BUS_COUNT > 1
+    {ST1WIRE_PLATFORM_BUS1_PORT, ST1WIRE_PLATFORM_BUS1_PIN},
+#endif
+#if ST1WIRE_PLATFORM_BUS_COUNT > 2
+    {ST1WIRE_PLATFORM_BUS2_PORT, ST1WIRE_PLATFORM_BUS2_PIN},
+#endif
+#if ST1WIRE_PLATFORM_BUS_COUNT > 3
+    {ST1WIRE_PLATFORM_BUS3_PORT, ST1WIRE_PLATFORM_BUS3_PIN},
+#endif
+};
+
+#if ST1WIRE_PLATFORM_BUS_COUNT > 1
+/* - Line descriptors of the bus table (masks computed at compile time) */
+static const st1wire_platform_line_t st1wire_platform_line[ST1WIRE_PLATFORM_BUS_COUNT] = {
+    ST1WIRE_PLATFORM_LINE(ST1WIRE_PLATFORM_BUS0_PORT, ST1WIRE_PLATFORM_BUS0_PIN),
+    ST1WIRE_PLATFORM_LINE(ST1WIRE_PLATFORM_BUS1_PORT, ST1WIRE_PLATFORM_BUS1_PIN),
+#if ST1WIRE_PLATFORM_BUS_COUNT > 2
+    ST1WIRE_PLATFORM_LINE(ST1WIRE_PLATFORM_BUS2_PORT, ST1WIRE_PLATFORM_BUS2_PIN),
+#endif
+#if ST1WIRE_PLATFORM_BUS_COUNT > 3
+    ST1WIRE_PLATFORM_LINE(ST1WIRE_PLATFORM_BUS3_PORT, ST1WIRE_PLATFORM_BUS3_PIN),
+#endif
+};
+#endif
+
 /* ---------- Static Platform Abstraction layer Declarations ---------- */
 
+static const st1wire_platform_bus_t *_st1wire_platform_bus_get(uint8_t bus_addr) {
+    /* - Unknown bus index falls back on the default line */
+    if (bus_addr >= ST1WIRE_PLATFORM_BUS_COUNT) {
+        bus_addr = 0;
+    }
+    return &st1wire_platform_bus[bus_addr];
+}
+
+static ST1WIRE_RAMFUNC void _st1wire_platform_mode_set(GPIO_TypeDef *port, uint16_t pin_mask, uint32_t mode) {
+    uint32_t moder = port->MODER;
+    uint8_t pin;
+
+    for (pin = 0; pin < 16; pin++) {
+        if (pin_mask & (1 << pin)) {
+            moder &= ~(0b11 << (pin * 2));
+            moder |= (mode << (pin * 2));
+        }
+    }
+    port->MODER = moder;
+}
+
 void st1wire_platform_init(void) {
-    /* - Initialize PA9 (ST1Wire line) as open-drain output */
-    GPIOA->PUPDR &= ~(GPIO_PUPDR_PUPD9_Msk);
-    GPIOA->OTYPER |= 1 << 9;
-    GPIOA->ODR |= 1 << 9;
-    GPIOA->OSPEEDR |= (0b11 << GPIO_OSPEEDR_OSPEED9_Pos);
-    GPIOA->MODER &= ~(GPIO_MODER_MODE9_Msk);
-    GPIOA->MODER |= (0b01 << GPIO_MODER_MODE9_Pos);
+    const st1wire_platform_bus_t *pBus;
+    uint8_t i;
+
+    /* - Initialize the configured ST1Wire lines as open-drain outputs (released) */
+    for (i = 0; i < ST1WIRE_PLATFORM_BUS_COUNT; i++) {
+        pBus = &st1wire_platform_bus[i];
+        pBus->port->PUPDR &= ~(0b11 << (pBus->pin * 2));
+        pBus->port->OTYPER |= 1 << pBus->pin;
+        pBus->port->BSRR = 1 << pBus->pin;
+        pBus->port->OSPEEDR |= (0b11 << (pBus->pin * 2));
+        _st1wire_platform_mode_set(pBus->port, 1 << pBus->pin, 0b01);
+    }
 
     GPIOB->ODR &= ~(1 << GPIO_ODR_OD0_Pos);
 
@@ -33,18 +88,24 @@ void st1wire_platform_deinit(void) {
 }
 
 void st1wire_platform_io_set(uint8_t bus_addr) {
-    /* SET IO bit-field in Output data register */
-    GPIOA->ODR |= (1 << 9);
+    const st1wire_platform_bus_t *pBus = _st1wire_platform_bus_get(bus_addr);
+
+    /* Atomic set through Bit Set/Reset register */
+    pBus->port->BSRR = 1 << pBus->pin;
 }
 
 void st1wire_platform_io_clear(uint8_t bus_addr) {
-    /* Clear IO bit-field in Output data register */
-    GPIOA->ODR &= ~(1 << 9);
+    const st1wire_platform_bus_t *pBus = _st1wire_platform_bus_get(bus_addr);
+
+    /* Atomic clear through Bit Set/Reset register */
+    pBus->port->BSRR = 1 << (pBus->pin + 16);
 }
 
 uint8_t st1wire_platform_io_get(uint8_t bus_addr) {
-    /* Return PA9 Status from Input Data register */
-    if ((GPIOA->IDR & 1 << 9) != 0) {
+    const st1wire_platform_bus_t *pBus = _st1wire_platform_bus_get(bus_addr);
+
+    /* Return line status from Input Data register */
+    if ((pBus->port->IDR & 1 << pBus->pin) != 0) {
         return 1;
     } else {
         return 0;
@@ -52,18 +113,96 @@ uint8_t st1wire_platform_io_get(uint8_t bus_addr) {
 }
 
 void st1wire_platform_io_in(uint8_t bus_addr) {
-    /* Set PA9 as input */
-    GPIOA->MODER &= ~(GPIO_MODER_MODE9_Msk);
+    const st1wire_platform_bus_t *pBus = _st1wire_platform_bus_get(bus_addr);
+
+    /* Set line as input */
+    pBus->port->MODER &= ~(0b11 << (pBus->pin * 2));
 }
 
 void st1wire_platform_io_out(uint8_t bus_addr) {
-    /* Set PA9 as output */
-    GPIOA->MODER |= (0b01 << GPIO_MODER_MODE9_Pos);
+    const st1wire_platform_bus_t *pBus = _st1wire_platform_bus_get(bus_addr);
+
+    /* Set line as output */
+    pBus->port->MODER |= (0b01 << (pBus->pin * 2));
 }
 
+#if ST1WIRE_PLATFORM_BUS_COUNT > 1
+void st1wire_platform_line_get(uint8_t bus_addr, st1wire_platform_line_t *pLine) {
+    /* - Unknown bus index falls back on the default line */
+    if (bus_addr >= ST1WIRE_PLATFORM_BUS_COUNT) {
+        bus_addr = 0;
+    }
+    *pLine = st1wire_platform_line[bus_addr];
+}
+#endif
+
+uint8_t st1wire_platform_group_init(uint32_t bus_mask, st1wire_platform_group_t *pGroup) {
+    const st1wire_platform_bus_t *pBus;
+    uint8_t i;
+
+    pGroup->port = NULL;
+    pGroup->bus_mask = 0;
+    pGroup->pin_mask = 0;
+
+    if ((bus_mask == 0) || (bus_mask >> ST1WIRE_PLATFORM_BUS_COUNT) != 0) {
+        return 0;
+    }
+
+    for (i = 0; i < ST1WIRE_PLATFORM_BUS_COUNT; i++) {
+        if ((bus_mask & (1UL << i)) == 0) {
+            continue;
+        }
+        pBus = &st1wire_platform_bus[i];
+        /* - Lockstep edges require a single port (one BSRR write per edge) */
+        if ((pGroup->port != NULL) && (pGroup->port != pBus->port)) {
+            pGroup->port = NULL;
+            pGroup->bus_mask = 0;
+            pGroup->pin_mask = 0;
+            return 0;
+        }
+        pGroup->port = pBus->port;
+        pGroup->pin_mask |= 1 << pBus->pin;
+    }
+    pGroup->bus_mask = bus_mask;
+
+    return 1;
+}
+
+ST1WIRE_RAMFUNC void st1wire_platform_group_set(const st1wire_platform_group_t *pGroup) {
+    pGroup->port->BSRR = pGroup->pin_mask;
+}
+
+ST1WIRE_RAMFUNC void st1wire_platform_group_clear(const st1wire_platform_group_t *pGroup) {
+    pGroup->port->BSRR = (uint32_t)pGroup->pin_mask << 16;
+}
+
+ST1WIRE_RAMFUNC uint32_t st1wire_platform_group_get(const st1wire_platform_group_t *pGroup) {
+    /* - Single IDR sample for all the lines of the group */
+    uint32_t idr = pGroup->port->IDR;
+    uint32_t high_mask = 0;
+    uint8_t i;
+
+    for (i = 0; i < ST1WIRE_PLATFORM_BUS_COUNT; i++) {
+        if ((pGroup->bus_mask & (1UL << i)) && (idr & (1 << st1wire_platform_bus[i].pin))) {
+            high_mask |= 1UL << i;
+        }
+    }
+    return high_mask;
+}
+
+ST1WIRE_RAMFUNC void st1wire_platform_group_in(const st1wire_platform_group_t *pGroup) {
+    _st1wire_platform_mode_set(pGroup->port, pGroup->pin_mask, 0b00);
+}
+
+ST1WIRE_RAMFUNC void st1wire_platform_group_out(const st1wire_platform_group_t *pGroup) {
+    _st1wire_platform_mode_set(pGroup->port, pGroup->pin_mask, 0b01);
+}
+
+#ifndef ST1WIRE_PLATFORM_STATIC_IO
 void st1wire_platform_delay(uint32_t delay) {
     delay_us(delay);
 }
+#endif /* ST1WIRE_PLATFORM_STATIC_IO */
 
 void st1wire_platform_wake(uint8_t bus_addr) {
     st1wire_platform_io_clear(bus_addr);
@@ -72,6 +211,7 @@ void st1wire_platform_wake(uint8_t bus_addr) {
     st1wire_platform_delay(8000);
 }
 
+#ifndef ST1WIRE_PLATFORM_STATIC_IO
 void st1wire_platform_start_timeout(uint32_t timeout) {
     timeout_us_start(timeout);
 }
@@ -79,3 +219,89 @@ void st1wire_platform_start_timeout(uint32_t timeout) {
 int8_t st1wire_platform_is_timeout_exceeded(void) {
     return timeout_us_get_status();
 }
+#endif /* ST1WIRE_PLATFORM_STATIC_IO */
+
+#ifdef ST1WIRE_ASYNC_ENGINE
+
+/* Bus table lines shall stay in the EXTI9_5 range (pins 5 to 9) */
+static volatile uint32_t st1wire_platform_edge_line = 0;
+
+void st1wire_platform_async_init(void) {
+    /* - Configure TIM2 as free running 1MHz counter (CH1 compare used as one-shot event) */
+    TIM2->CR1 &= ~(TIM_CR1_CEN);
+    TIM2->PSC = (SystemCoreClock / 1000000) - 1;
+    TIM2->ARR = 0xFFFFFFFF;
+    TIM2->EGR |= TIM_EGR_UG;
+    TIM2->SR = 0;
+    TIM2->DIER = 0;
+
+    /* - Bus lines EXTI are routed on demand (kept masked until needed) */
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+
+    NVIC_SetPriority(TIM2_IRQn, ST1WIRE_ASYNC_IRQ_PRIORITY);
+    NVIC_SetPriority(EXTI9_5_IRQn, ST1WIRE_ASYNC_IRQ_PRIORITY);
+    NVIC_EnableIRQ(TIM2_IRQn);
+    NVIC_EnableIRQ(EXTI9_5_IRQn);
+}
+
+void st1wire_platform_timer_start(uint32_t delay) {
+    /* - Restart counter and arm CH1 compare event */
+    TIM2->CR1 &= ~(TIM_CR1_CEN);
+    TIM2->CNT = 0;
+    TIM2->CCR1 = delay;
+    TIM2->SR = ~(TIM_SR_CC1IF);
+    TIM2->DIER |= TIM_DIER_CC1IE;
+    TIM2->CR1 |= TIM_CR1_CEN;
+}
+
+void st1wire_platform_timer_stop(void) {
+    TIM2->DIER &= ~(TIM_DIER_CC1IE);
+    TIM2->CR1 &= ~(TIM_CR1_CEN);
+    TIM2->SR = ~(TIM_SR_CC1IF);
+}
+
+uint32_t st1wire_platform_timer_elapsed(void) {
+    return TIM2->CNT;
+}
+
+void st1wire_platform_edge_irq_enable(uint8_t bus_addr) {
+    const st1wire_platform_bus_t *pBus = _st1wire_platform_bus_get(bus_addr);
+    uint32_t port_index = ((uint32_t)pBus->port - GPIOA_BASE) / (GPIOB_BASE - GPIOA_BASE);
+    uint32_t line = 1UL << pBus->pin;
+
+    /* - Route bus line to its EXTI line on both edges */
+    SYSCFG->EXTICR[pBus->pin >> 2] &= ~(0xFUL << ((pBus->pin & 0x3) * 4));
+    SYSCFG->EXTICR[pBus->pin >> 2] |= (port_index << ((pBus->pin & 0x3) * 4));
+    EXTI->RTSR1 |= line;
+    EXTI->FTSR1 |= line;
+    EXTI->PR1 = line;
+    st1wire_platform_edge_line = line;
+    EXTI->IMR1 |= line;
+}
+
+void st1wire_platform_edge_irq_disable(uint8_t bus_addr) {
+    const st1wire_platform_bus_t *pBus = _st1wire_platform_bus_get(bus_addr);
+    uint32_t line = 1UL << pBus->pin;
+
+    EXTI->IMR1 &= ~(line);
+    EXTI->PR1 = line;
+    st1wire_platform_edge_line = 0;
+}
+
+void TIM2_IRQHandler(void) {
+    if (TIM2->SR & TIM_SR_CC1IF) {
+        /* - One-shot event : counter keeps running for edge timings */
+        TIM2->SR = ~(TIM_SR_CC1IF);
+        TIM2->DIER &= ~(TIM_DIER_CC1IE);
+        st1wire_async_timer_event();
+    }
+}
+
+void EXTI9_5_IRQHandler(void) {
+    if (EXTI->PR1 & st1wire_platform_edge_line) {
+        EXTI->PR1 = st1wire_platform_edge_line;
+        st1wire_async_edge_event();
+    }
+}
+
+#endif /* ST1WIRE_ASYNC_ENGINE */
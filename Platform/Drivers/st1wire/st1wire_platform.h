@@ -30,6 +30,82 @@ extern uint32_t SystemCoreClock;
 #define ST1WIRE_END_CRITICAL_SECTION __enable_irq();
 #endif /* USE_FREERTOS */
 
+/* Event driven engine interrupts priority (TIM2 & line EXTI). Keep above the
+ * RTOS syscall priority ceiling so the kernel never delays a line edge */
+#define ST1WIRE_ASYNC_IRQ_PRIORITY 0
+
+#ifdef USE_FREERTOS
+#define ST1WIRE_ASYNC_WAIT(done) \
+    while (!(done)) {            \
+        taskYIELD();             \
+    }
+#else
+/* Flag tested with PRIMASK set : a completion interrupt raised between the
+ * test and the WFI stays pending and wakes the core instead of being lost */
+#define ST1WIRE_ASYNC_WAIT(done) \
+    __disable_irq();             \
+    while (!(done)) {            \
+        __WFI();                 \
+        __enable_irq();          \
+        __disable_irq();         \
+    }                            \
+    __enable_irq();
+#endif /* USE_FREERTOS */
+
+/* ST1Wire bus table (see st1wire_platform.c) : bus_addr indexes the table,
+ * lines of a same GPIO port can be driven in lockstep (broadcast).
+ * Only the first ST1WIRE_PLATFORM_BUS_COUNT lines are configured by
+ * st1wire_platform_init ; other bus indexes fall back on bus 0 */
+#ifndef ST1WIRE_PLATFORM_BUS_COUNT
+#define ST1WIRE_PLATFORM_BUS_COUNT 1 /* 1 to 4 */
+#endif
+#define ST1WIRE_PLATFORM_BUS0_PORT GPIOA /* PA9 (STICK connector) */
+#define ST1WIRE_PLATFORM_BUS0_PIN 9
+#define ST1WIRE_PLATFORM_BUS1_PORT GPIOA /* PA8 (Arduino D7) */
+#define ST1WIRE_PLATFORM_BUS1_PIN 8
+#define ST1WIRE_PLATFORM_BUS2_PORT GPIOA /* PA7 (Arduino D11) : conflicts with Arduino SPI MOSI */
+#define ST1WIRE_PLATFORM_BUS2_PIN 7
+#define ST1WIRE_PLATFORM_BUS3_PORT GPIOA /* PA6 (Arduino D12) : conflicts with Arduino SPI MISO */
+#define ST1WIRE_PLATFORM_BUS3_PIN 6
+
+#if (ST1WIRE_PLATFORM_BUS_COUNT < 1) || (ST1WIRE_PLATFORM_BUS_COUNT > 4)
+#error "ST1WIRE_PLATFORM_BUS_COUNT shall be in range 1 to 4"
+#endif
+
+/* SRAM line backend : the bit-level routines run from SRAM (.RamFunc) and the
+ * delay is inlined as a direct TIM6 sequence, so edge timings don't depend on
+ * flash wait states nor on the optimization level */
+//#define ST1WIRE_PLATFORM_STATIC_IO
+
+typedef struct {
+    GPIO_TypeDef *port;
+    uint8_t pin;
+} st1wire_platform_bus_t;
+
+typedef struct {
+    GPIO_TypeDef *port;
+    uint32_t bus_mask; /* Bit n set : bus n is part of the group */
+    uint16_t pin_mask; /* Matching GPIO pins mask */
+} st1wire_platform_group_t;
+
+/* Bus line resolved once per byte : the bit loops only perform register
+ * accesses with precomputed masks, whatever the bus index */
+typedef struct {
+    GPIO_TypeDef *port;
+    uint32_t set_mask;   /* BSRR bit driving the line high */
+    uint32_t clear_mask; /* BSRR bit driving the line low */
+    uint32_t idr_mask;   /* IDR bit of the line */
+    uint32_t mode_mask;  /* MODER field of the line */
+    uint32_t mode_out;   /* MODER field value for output mode */
+} st1wire_platform_line_t;
+
+/* Line descriptor of a bus table entry (compile-time constant masks) */
+#define ST1WIRE_PLATFORM_LINE(port, pin)                         \
+    {                                                            \
+        (port), 1UL << (pin), 1UL << ((pin) + 16), 1UL << (pin), \
+            0b11UL << ((pin) * 2), 0b01UL << ((pin) * 2)         \
+    }
+
 void st1wire_platform_init(void);
 void st1wire_platform_deinit(void);
 void st1wire_platform_io_set(uint8_t bus_addr);
@@ -37,7 +113,96 @@ void st1wire_platform_io_clear(uint8_t bus_addr);
 uint8_t st1wire_platform_io_get(uint8_t bus_addr);
 void st1wire_platform_io_in(uint8_t bus_addr);
 void st1wire_platform_io_out(uint8_t bus_addr);
-void st1wire_platform_wake(uint8_t bus_addr);
+
+#if ST1WIRE_PLATFORM_BUS_COUNT == 1
+/* Single bus build : the bit loops are specialized for the bus 0 pin, the line
+ * masks fold into immediate operands (no bus table lookup) */
+static inline void st1wire_platform_line_get(uint8_t bus_addr, st1wire_platform_line_t *pLine) {
+    const st1wire_platform_line_t line = ST1WIRE_PLATFORM_LINE(ST1WIRE_PLATFORM_BUS0_PORT, ST1WIRE_PLATFORM_BUS0_PIN);
+
+    (void)bus_addr;
+    *pLine = line;
+}
+#else
+void st1wire_platform_line_get(uint8_t bus_addr, st1wire_platform_line_t *pLine);
+#endif
+
+static inline void st1wire_platform_line_set(const st1wire_platform_line_t *pLine) {
+    pLine->port->BSRR = pLine->set_mask;
+}
+
+static inline void st1wire_platform_line_clear(const st1wire_platform_line_t *pLine) {
+    pLine->port->BSRR = pLine->clear_mask;
+}
+
+static inline uint8_t st1wire_platform_line_get_level(const st1wire_platform_line_t *pLine) {
+    return (pLine->port->IDR & pLine->idr_mask) != 0;
+}
+
+static inline void st1wire_platform_line_in(const st1wire_platform_line_t *pLine) {
+    pLine->port->MODER &= ~(pLine->mode_mask);
+}
+
+static inline void st1wire_platform_line_out(const st1wire_platform_line_t *pLine) {
+    pLine->port->MODER |= pLine->mode_out;
+}
+
+#ifdef ST1WIRE_PLATFORM_STATIC_IO
+#define ST1WIRE_RAMFUNC __attribute__((section(".RamFunc"), noinline))
+
+extern volatile uint16_t delay_us_timer_prescaler;
+
+static inline void st1wire_platform_delay(uint32_t delay) {
+    /* - Same TIM6 one-pulse sequence as delay_us() without the flash call */
+    TIM6->CR1 &= ~(TIM_CR1_CEN);
+    TIM6->PSC = delay_us_timer_prescaler;
+    TIM6->EGR |= TIM_EGR_UG;
+    TIM6->SR &= ~(TIM_SR_UIF);
+    TIM6->CNT = 0x0000;
+    TIM6->ARR = delay;
+    TIM6->CR1 |= TIM_CR1_CEN;
+    while (!(TIM6->SR & TIM_SR_UIF))
+        ;
+    TIM6->CR1 &= ~(TIM_CR1_CEN);
+    TIM6->SR &= ~(TIM_SR_UIF);
+}
+
+static inline void st1wire_platform_start_timeout(uint32_t timeout) {
+    /* - Same TIM6 sequence as timeout_us_start() without the flash call */
+    TIM6->CR1 &= ~(TIM_CR1_CEN);
+    TIM6->PSC = delay_us_timer_prescaler;
+    TIM6->EGR |= TIM_EGR_UG;
+    TIM6->SR &= ~(TIM_SR_UIF);
+    TIM6->CNT = 0x0000;
+    TIM6->ARR = timeout;
+    TIM6->CR1 |= TIM_CR1_CEN;
+}
+
+static inline int8_t st1wire_platform_is_timeout_exceeded(void) {
+    if (TIM6->SR & TIM_SR_UIF) {
+        TIM6->CR1 &= ~(TIM_CR1_CEN);
+        TIM6->SR &= ~(TIM_SR_UIF);
+        return 1;
+    }
+    return 0;
+}
+#else
+#define ST1WIRE_RAMFUNC
+
 void st1wire_platform_delay(uint32_t delay);
 void st1wire_platform_start_timeout(uint32_t timeout);
 int8_t st1wire_platform_is_timeout_exceeded(void);
+#endif /* ST1WIRE_PLATFORM_STATIC_IO */
+void st1wire_platform_wake(uint8_t bus_addr);
+void st1wire_platform_async_init(void);
+void st1wire_platform_timer_start(uint32_t delay);
+void st1wire_platform_timer_stop(void);
+uint32_t st1wire_platform_timer_elapsed(void);
+void st1wire_platform_edge_irq_enable(uint8_t bus_addr);
+void st1wire_platform_edge_irq_disable(uint8_t bus_addr);
+uint8_t st1wire_platform_group_init(uint32_t bus_mask, st1wire_platform_group_t *pGroup);
+void st1wire_platform_group_set(const st1wire_platform_group_t *pGroup);
+void st1wire_platform_group_clear(const st1wire_platform_group_t *pGroup);
+uint32_t st1wire_platform_group_get(const st1wire_platform_group_t *pGroup);
+void st1wire_platform_group_in(const st1wire_platform_group_t *pGroup);
+void st1wire_platform_group_out(const st1wire_platform_group_t *pGroup);
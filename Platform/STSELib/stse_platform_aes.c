@@ -17,90 +17,591 @@
 
 #include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
 #include "stse_conf.h"
+#include "stse_platform_aes.h"
 #include "stselib.h"
 
-cmox_mac_handle_t *pMAC_Handler;
-cmox_cmac_handle_t CMAC_Handler;
-
 #if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
 
-stse_ReturnCode_t stse_platform_aes_cmac_init(const PLAT_UI8 *pKey,
-                                              PLAT_UI16 key_length,
-                                              PLAT_UI16 exp_tag_size) {
-    cmox_mac_retval_t retval;
+/* Context behind the legacy stse_platform_aes_cmac_init/append/finish API */
+static stse_platform_aes_cmac_ctx_t stse_platform_aes_cmac_default_ctx;
 
-    /* - Call CMAC constructor */
-    pMAC_Handler = cmox_cmac_construct(&CMAC_Handler, CMOX_CMAC_AESSMALL);
+static void stse_platform_aes_zeroize(void *pBuffer, size_t length) {
+    volatile PLAT_UI8 *pByte = (volatile PLAT_UI8 *)pBuffer;
 
-    /* - Init MAC */
-    retval = cmox_mac_init(pMAC_Handler);
-    if (retval != CMOX_MAC_SUCCESS) {
-        return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+    while (length-- > 0) {
+        *pByte++ = 0;
     }
-    /* - Set Tag length */
-    retval = cmox_mac_setTagLen(pMAC_Handler, exp_tag_size);
-    if (retval != CMOX_MAC_SUCCESS) {
+}
+
+static void stse_platform_aes_xor_block(PLAT_UI8 *pOut, const PLAT_UI8 *pIn1, const PLAT_UI8 *pIn2) {
+    PLAT_UI8 i;
+
+    for (i = 0; i < STSE_PLATFORM_AES_BLOCK_SIZE; i++) {
+        pOut[i] = pIn1[i] ^ pIn2[i];
+    }
+}
+
+static PLAT_UI8 stse_platform_aes_block_encrypt(stse_platform_aes_key_t *pAes_key, const PLAT_UI8 *pIn, PLAT_UI8 *pOut) {
+    size_t out_length = STSE_PLATFORM_AES_BLOCK_SIZE;
+
+    return (cmox_cipher_append(pAes_key->pEnc, pIn, STSE_PLATFORM_AES_BLOCK_SIZE, pOut, &out_length) == CMOX_CIPHER_SUCCESS) &&
+           (out_length == STSE_PLATFORM_AES_BLOCK_SIZE);
+}
+
+static void stse_platform_aes_cmac_subkey(PLAT_UI8 *pOut, const PLAT_UI8 *pIn) {
+    PLAT_UI8 msb = pIn[0] & 0x80;
+    PLAT_UI8 i;
+
+    /* - Left shift by one bit, conditional XOR with Rb (0x87) */
+    for (i = 0; i < STSE_PLATFORM_AES_BLOCK_SIZE - 1U; i++) {
+        pOut[i] = (PLAT_UI8)((pIn[i] << 1) | (pIn[i + 1] >> 7));
+    }
+    pOut[STSE_PLATFORM_AES_BLOCK_SIZE - 1U] = (PLAT_UI8)(pIn[STSE_PLATFORM_AES_BLOCK_SIZE - 1U] << 1);
+    if (msb) {
+        pOut[STSE_PLATFORM_AES_BLOCK_SIZE - 1U] ^= 0x87;
+    }
+}
+
+stse_ReturnCode_t stse_platform_aes_key_init(stse_platform_aes_key_t *pAes_key,
+                                             const PLAT_UI8 *pKey,
+                                             PLAT_UI16 key_length) {
+    PLAT_UI8 L[STSE_PLATFORM_AES_BLOCK_SIZE] = {0};
+
+    if (pAes_key == NULL || pKey == NULL) {
+        return STSE_PLATFORM_CRYPTO_INIT_ERROR;
+    }
+    pAes_key->valid = 0;
+
+    /* - Expand encryption and decryption key schedules */
+    pAes_key->pEnc = cmox_ecb_construct(&pAes_key->enc_handle, CMOX_AESSMALL_ECB_ENC);
+    pAes_key->pDec = cmox_ecb_construct(&pAes_key->dec_handle, CMOX_AESSMALL_ECB_DEC);
+    if (pAes_key->pEnc == NULL || pAes_key->pDec == NULL ||
+        cmox_cipher_init(pAes_key->pEnc) != CMOX_CIPHER_SUCCESS ||
+        cmox_cipher_init(pAes_key->pDec) != CMOX_CIPHER_SUCCESS ||
+        cmox_cipher_setKey(pAes_key->pEnc, pKey, key_length) != CMOX_CIPHER_SUCCESS ||
+        cmox_cipher_setKey(pAes_key->pDec, pKey, key_length) != CMOX_CIPHER_SUCCESS) {
+        stse_platform_aes_zeroize(pAes_key, sizeof(stse_platform_aes_key_t));
+        return STSE_PLATFORM_CRYPTO_INIT_ERROR;
+    }
+
+    /* - CMAC subkeys (RFC 4493) : L = AES(K, 0^128), K1 = L.x, K2 = K1.x */
+    if (!stse_platform_aes_block_encrypt(pAes_key, L, L)) {
+        stse_platform_aes_key_clear(pAes_key);
+        return STSE_PLATFORM_CRYPTO_INIT_ERROR;
+    }
+    stse_platform_aes_cmac_subkey(pAes_key->k1, L);
+    stse_platform_aes_cmac_subkey(pAes_key->k2, pAes_key->k1);
+    stse_platform_aes_zeroize(L, sizeof(L));
+
+    pAes_key->valid = 1;
+
+    return STSE_OK;
+}
+
+void stse_platform_aes_key_clear(stse_platform_aes_key_t *pAes_key) {
+    if (pAes_key == NULL) {
+        return;
+    }
+    if (pAes_key->pEnc != NULL) {
+        cmox_cipher_cleanup(pAes_key->pEnc);
+    }
+    if (pAes_key->pDec != NULL) {
+        cmox_cipher_cleanup(pAes_key->pDec);
+    }
+    stse_platform_aes_zeroize(pAes_key, sizeof(stse_platform_aes_key_t));
+}
+
+static PLAT_UI8 stse_platform_aes_cmac_last_block(stse_platform_aes_key_t *pAes_key,
+                                                  PLAT_UI8 *pState,
+                                                  const PLAT_UI8 *pLast,
+                                                  PLAT_UI8 last_length) {
+    PLAT_UI8 block[STSE_PLATFORM_AES_BLOCK_SIZE];
+    PLAT_UI8 ok;
+
+    /* - Last block : complete (XOR K1) or padded (XOR K2) */
+    if (last_length == STSE_PLATFORM_AES_BLOCK_SIZE) {
+        stse_platform_aes_xor_block(block, pLast, pAes_key->k1);
+    } else {
+        memset(block, 0, sizeof(block));
+        memcpy(block, pLast, last_length);
+        block[last_length] = 0x80;
+        stse_platform_aes_xor_block(block, block, pAes_key->k2);
+    }
+    stse_platform_aes_xor_block(block, block, pState);
+    ok = stse_platform_aes_block_encrypt(pAes_key, block, pState);
+
+    stse_platform_aes_zeroize(block, sizeof(block));
+
+    return ok;
+}
+
+static PLAT_UI8 stse_platform_aes_key_cmac_tag(stse_platform_aes_key_t *pAes_key,
+                                               const PLAT_UI8 *pPayload,
+                                               PLAT_UI16 payload_length,
+                                               PLAT_UI8 *pTag) {
+    PLAT_UI8 block[STSE_PLATFORM_AES_BLOCK_SIZE];
+    PLAT_UI16 remaining = payload_length;
+    PLAT_UI8 ok = 1;
+
+    memset(pTag, 0, STSE_PLATFORM_AES_BLOCK_SIZE);
+
+    /* - Chain all blocks but the last one */
+    while (ok && remaining > STSE_PLATFORM_AES_BLOCK_SIZE) {
+        stse_platform_aes_xor_block(block, pTag, pPayload);
+        ok = stse_platform_aes_block_encrypt(pAes_key, block, pTag);
+        pPayload += STSE_PLATFORM_AES_BLOCK_SIZE;
+        remaining -= STSE_PLATFORM_AES_BLOCK_SIZE;
+    }
+    stse_platform_aes_zeroize(block, sizeof(block));
+
+    return ok && stse_platform_aes_cmac_last_block(pAes_key, pTag, pPayload, (PLAT_UI8)remaining);
+}
+
+stse_ReturnCode_t stse_platform_aes_key_cmac_compute(stse_platform_aes_key_t *pAes_key,
+                                                     const PLAT_UI8 *pPayload,
+                                                     PLAT_UI16 payload_length,
+                                                     PLAT_UI16 exp_tag_size,
+                                                     PLAT_UI8 *pTag,
+                                                     PLAT_UI16 *pTag_length) {
+    PLAT_UI8 tag[STSE_PLATFORM_AES_BLOCK_SIZE];
+
+    if (pAes_key == NULL || !pAes_key->valid || exp_tag_size == 0 || exp_tag_size > STSE_PLATFORM_AES_BLOCK_SIZE) {
         return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
     }
-    /* - Set Key  */
-    retval = cmox_mac_setKey(pMAC_Handler, pKey, key_length);
-    if (retval != CMOX_MAC_SUCCESS) {
+
+    if (!stse_platform_aes_key_cmac_tag(pAes_key, pPayload, payload_length, tag)) {
         return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
     }
 
+    memcpy(pTag, tag, exp_tag_size);
+    *pTag_length = exp_tag_size;
+
     return STSE_OK;
 }
 
-stse_ReturnCode_t stse_platform_aes_cmac_append(PLAT_UI8 *pInput,
-                                                PLAT_UI16 lenght) {
-    cmox_mac_retval_t retval;
+stse_ReturnCode_t stse_platform_aes_key_cmac_verify(stse_platform_aes_key_t *pAes_key,
+                                                    const PLAT_UI8 *pPayload,
+                                                    PLAT_UI16 payload_length,
+                                                    const PLAT_UI8 *pTag,
+                                                    PLAT_UI16 tag_length) {
+    PLAT_UI8 tag[STSE_PLATFORM_AES_BLOCK_SIZE];
+    PLAT_UI8 diff = 0;
+    PLAT_UI16 i;
 
-    retval = cmox_mac_append(pMAC_Handler, pInput, lenght);
+    if (pAes_key == NULL || !pAes_key->valid || tag_length == 0 || tag_length > STSE_PLATFORM_AES_BLOCK_SIZE) {
+        return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+    }
 
-    if (retval != CMOX_MAC_SUCCESS) {
-        return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+    if (!stse_platform_aes_key_cmac_tag(pAes_key, pPayload, payload_length, tag)) {
+        return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+    }
+
+    /* - Constant time tag comparison */
+    for (i = 0; i < tag_length; i++) {
+        diff |= tag[i] ^ pTag[i];
     }
 
+    return (diff == 0) ? STSE_OK : STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+}
+
+stse_ReturnCode_t stse_platform_aes_key_cbc_enc(stse_platform_aes_key_t *pAes_key,
+                                                const PLAT_UI8 *pPlaintext,
+                                                PLAT_UI16 plaintext_length,
+                                                const PLAT_UI8 *pInitial_value,
+                                                PLAT_UI8 *pEncryptedtext,
+                                                PLAT_UI16 *pEncryptedtext_length) {
+    PLAT_UI8 block[STSE_PLATFORM_AES_BLOCK_SIZE];
+    const PLAT_UI8 *pChain = pInitial_value;
+    PLAT_UI16 offset;
+
+    if (pAes_key == NULL || !pAes_key->valid ||
+        (plaintext_length % STSE_PLATFORM_AES_BLOCK_SIZE) != 0 || *pEncryptedtext_length < plaintext_length) {
+        return STSE_PLATFORM_AES_CBC_ENCRYPT_ERROR;
+    }
+
+    /* - C(i) = AES(K, P(i) ^ C(i-1)) with C(-1) = IV */
+    for (offset = 0; offset < plaintext_length; offset += STSE_PLATFORM_AES_BLOCK_SIZE) {
+        stse_platform_aes_xor_block(block, pPlaintext + offset, pChain);
+        if (!stse_platform_aes_block_encrypt(pAes_key, block, pEncryptedtext + offset)) {
+            stse_platform_aes_zeroize(block, sizeof(block));
+            return STSE_PLATFORM_AES_CBC_ENCRYPT_ERROR;
+        }
+        pChain = pEncryptedtext + offset;
+    }
+    stse_platform_aes_zeroize(block, sizeof(block));
+
+    *pEncryptedtext_length = plaintext_length;
+
     return STSE_OK;
 }
 
-stse_ReturnCode_t stse_platform_aes_cmac_compute_finish(PLAT_UI8 *pTag, PLAT_UI8 *pTagLen) {
-    cmox_mac_retval_t retval;
-    size_t cmox_tag_len = *pTagLen;
+stse_ReturnCode_t stse_platform_aes_key_cbc_dec(stse_platform_aes_key_t *pAes_key,
+                                                const PLAT_UI8 *pEncryptedtext,
+                                                PLAT_UI16 encryptedtext_length,
+                                                const PLAT_UI8 *pInitial_value,
+                                                PLAT_UI8 *pPlaintext,
+                                                PLAT_UI16 *pPlaintext_length) {
+    PLAT_UI8 chain[STSE_PLATFORM_AES_BLOCK_SIZE];
+    PLAT_UI8 cipher_block[STSE_PLATFORM_AES_BLOCK_SIZE];
+    size_t out_length;
+    PLAT_UI16 offset;
+
+    if (pAes_key == NULL || !pAes_key->valid ||
+        (encryptedtext_length % STSE_PLATFORM_AES_BLOCK_SIZE) != 0 || *pPlaintext_length < encryptedtext_length) {
+        return STSE_PLATFORM_AES_CBC_DECRYPT_ERROR;
+    }
 
-    retval = cmox_mac_generateTag(pMAC_Handler, pTag, &cmox_tag_len);
-    if (retval != CMOX_MAC_SUCCESS) {
+    /* - P(i) = AES-1(K, C(i)) ^ C(i-1) with C(-1) = IV */
+    memcpy(chain, pInitial_value, STSE_PLATFORM_AES_BLOCK_SIZE);
+    for (offset = 0; offset < encryptedtext_length; offset += STSE_PLATFORM_AES_BLOCK_SIZE) {
+        memcpy(cipher_block, pEncryptedtext + offset, STSE_PLATFORM_AES_BLOCK_SIZE);
+        out_length = STSE_PLATFORM_AES_BLOCK_SIZE;
+        if (cmox_cipher_append(pAes_key->pDec, cipher_block, STSE_PLATFORM_AES_BLOCK_SIZE,
+                               pPlaintext + offset, &out_length) != CMOX_CIPHER_SUCCESS) {
+            stse_platform_aes_zeroize(pPlaintext, encryptedtext_length);
+            return STSE_PLATFORM_AES_CBC_DECRYPT_ERROR;
+        }
+        stse_platform_aes_xor_block(pPlaintext + offset, pPlaintext + offset, chain);
+        memcpy(chain, cipher_block, STSE_PLATFORM_AES_BLOCK_SIZE);
+    }
+
+    *pPlaintext_length = encryptedtext_length;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_init(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                  const PLAT_UI8 *pKey,
+                                                  PLAT_UI16 key_length,
+                                                  PLAT_UI16 exp_tag_size) {
+    if (pCtx == NULL || exp_tag_size == 0 || exp_tag_size > STSE_PLATFORM_AES_BLOCK_SIZE) {
         return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
     }
+    stse_platform_aes_cmac_ctx_clear(pCtx);
 
-    *pTagLen = (PLAT_UI8)cmox_tag_len;
+    /* - Expand the key in the context */
+    if (stse_platform_aes_key_init(&pCtx->key, pKey, key_length) != STSE_OK) {
+        return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+    }
+    pCtx->pAes_key = &pCtx->key;
+    pCtx->tag_length = (PLAT_UI8)exp_tag_size;
 
-    retval = cmox_mac_cleanup(pMAC_Handler);
-    if (retval != CMOX_MAC_SUCCESS) {
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_init_with_key(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                           stse_platform_aes_key_t *pAes_key,
+                                                           PLAT_UI16 exp_tag_size) {
+    if (pCtx == NULL || pAes_key == NULL || !pAes_key->valid ||
+        exp_tag_size == 0 || exp_tag_size > STSE_PLATFORM_AES_BLOCK_SIZE) {
         return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
     }
+    stse_platform_aes_cmac_ctx_clear(pCtx);
+
+    /* - Borrow the caller key handle */
+    pCtx->pAes_key = pAes_key;
+    pCtx->tag_length = (PLAT_UI8)exp_tag_size;
 
     return STSE_OK;
 }
 
-stse_ReturnCode_t stse_platform_aes_cmac_verify_finish(PLAT_UI8 *pTag) {
-    cmox_mac_retval_t retval;
-    uint32_t cmox_mac_fault_check = 0;
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_append(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                    const PLAT_UI8 *pInput,
+                                                    PLAT_UI16 length) {
+    PLAT_UI8 chunk;
+
+    if (pCtx == NULL || pCtx->pAes_key == NULL) {
+        return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+    }
+
+    while (length > 0) {
+        /* - Chain the buffered block only once more data follows (it may be the last one) */
+        if (pCtx->block_length == STSE_PLATFORM_AES_BLOCK_SIZE) {
+            stse_platform_aes_xor_block(pCtx->block, pCtx->block, pCtx->state);
+            if (!stse_platform_aes_block_encrypt(pCtx->pAes_key, pCtx->block, pCtx->state)) {
+                stse_platform_aes_cmac_ctx_clear(pCtx);
+                return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+            }
+            pCtx->block_length = 0;
+        }
+        chunk = STSE_PLATFORM_AES_BLOCK_SIZE - pCtx->block_length;
+        if (chunk > length) {
+            chunk = (PLAT_UI8)length;
+        }
+        memcpy(pCtx->block + pCtx->block_length, pInput, chunk);
+        pCtx->block_length += chunk;
+        pInput += chunk;
+        length -= chunk;
+    }
+
+    return STSE_OK;
+}
 
-    retval = cmox_mac_verifyTag(
-        pMAC_Handler,
-        pTag,
-        &cmox_mac_fault_check);
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_compute_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                            PLAT_UI8 *pTag,
+                                                            PLAT_UI8 *pTag_length) {
+    if (pCtx == NULL || pCtx->pAes_key == NULL) {
+        return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+    }
+
+    if (!stse_platform_aes_cmac_last_block(pCtx->pAes_key, pCtx->state, pCtx->block, pCtx->block_length)) {
+        stse_platform_aes_cmac_ctx_clear(pCtx);
+        return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+    }
+    memcpy(pTag, pCtx->state, pCtx->tag_length);
+    *pTag_length = pCtx->tag_length;
 
-    cmox_mac_cleanup(pMAC_Handler);
+    stse_platform_aes_cmac_ctx_clear(pCtx);
 
-    if ((retval != CMOX_MAC_AUTH_SUCCESS) || (cmox_mac_fault_check != CMOX_MAC_AUTH_SUCCESS)) {
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_verify_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                           const PLAT_UI8 *pTag) {
+    PLAT_UI8 diff = 0;
+    PLAT_UI8 i;
+
+    if (pCtx == NULL || pCtx->pAes_key == NULL) {
+        return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+    }
+
+    if (!stse_platform_aes_cmac_last_block(pCtx->pAes_key, pCtx->state, pCtx->block, pCtx->block_length)) {
+        stse_platform_aes_cmac_ctx_clear(pCtx);
         return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
     }
 
+    /* - Constant time tag comparison */
+    for (i = 0; i < pCtx->tag_length; i++) {
+        diff |= pCtx->state[i] ^ pTag[i];
+    }
+
+    stse_platform_aes_cmac_ctx_clear(pCtx);
+
+    return (diff == 0) ? STSE_OK : STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+}
+
+void stse_platform_aes_cmac_ctx_clear(stse_platform_aes_cmac_ctx_t *pCtx) {
+    if (pCtx == NULL) {
+        return;
+    }
+    if (pCtx->pAes_key == &pCtx->key) {
+        stse_platform_aes_key_clear(&pCtx->key);
+    }
+    stse_platform_aes_zeroize(pCtx, sizeof(stse_platform_aes_cmac_ctx_t));
+}
+
+stse_ReturnCode_t stse_platform_aes_key_cbc_enc_cmac(stse_platform_aes_key_t *pAes_key,
+                                                     stse_platform_aes_cmac_ctx_t *pCmac_ctx,
+                                                     const PLAT_UI8 *pPlaintext,
+                                                     PLAT_UI16 plaintext_length,
+                                                     const PLAT_UI8 *pInitial_value,
+                                                     PLAT_UI8 *pEncryptedtext,
+                                                     PLAT_UI16 *pEncryptedtext_length,
+                                                     PLAT_UI8 *pTag,
+                                                     PLAT_UI8 *pTag_length) {
+    PLAT_UI8 block[STSE_PLATFORM_AES_BLOCK_SIZE];
+    const PLAT_UI8 *pChain = pInitial_value;
+    PLAT_UI16 offset;
+
+    if (pAes_key == NULL || !pAes_key->valid ||
+        (plaintext_length % STSE_PLATFORM_AES_BLOCK_SIZE) != 0 || *pEncryptedtext_length < plaintext_length) {
+        stse_platform_aes_cmac_ctx_clear(pCmac_ctx);
+        return STSE_PLATFORM_AES_CBC_ENCRYPT_ERROR;
+    }
+
+    /* - Encrypt each block and feed the ciphertext block to the MAC in the same pass */
+    for (offset = 0; offset < plaintext_length; offset += STSE_PLATFORM_AES_BLOCK_SIZE) {
+        stse_platform_aes_xor_block(block, pPlaintext + offset, pChain);
+        if (!stse_platform_aes_block_encrypt(pAes_key, block, pEncryptedtext + offset)) {
+            stse_platform_aes_zeroize(block, sizeof(block));
+            stse_platform_aes_cmac_ctx_clear(pCmac_ctx);
+            return STSE_PLATFORM_AES_CBC_ENCRYPT_ERROR;
+        }
+        if (stse_platform_aes_cmac_ctx_append(pCmac_ctx, pEncryptedtext + offset, STSE_PLATFORM_AES_BLOCK_SIZE) != STSE_OK) {
+            stse_platform_aes_zeroize(block, sizeof(block));
+            return STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR;
+        }
+        pChain = pEncryptedtext + offset;
+    }
+    stse_platform_aes_zeroize(block, sizeof(block));
+
+    *pEncryptedtext_length = plaintext_length;
+
+    return stse_platform_aes_cmac_ctx_compute_finish(pCmac_ctx, pTag, pTag_length);
+}
+
+stse_ReturnCode_t stse_platform_aes_key_cmac_verify_cbc_dec(stse_platform_aes_key_t *pAes_key,
+                                                            stse_platform_aes_cmac_ctx_t *pCmac_ctx,
+                                                            const PLAT_UI8 *pEncryptedtext,
+                                                            PLAT_UI16 encryptedtext_length,
+                                                            const PLAT_UI8 *pInitial_value,
+                                                            const PLAT_UI8 *pTag,
+                                                            PLAT_UI8 *pPlaintext,
+                                                            PLAT_UI16 *pPlaintext_length) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 chain[STSE_PLATFORM_AES_BLOCK_SIZE];
+    PLAT_UI8 cipher_block[STSE_PLATFORM_AES_BLOCK_SIZE];
+    size_t out_length;
+    PLAT_UI16 offset;
+
+    if (pAes_key == NULL || !pAes_key->valid ||
+        (encryptedtext_length % STSE_PLATFORM_AES_BLOCK_SIZE) != 0 || *pPlaintext_length < encryptedtext_length) {
+        stse_platform_aes_cmac_ctx_clear(pCmac_ctx);
+        return STSE_PLATFORM_AES_CBC_DECRYPT_ERROR;
+    }
+
+    /* - Feed each ciphertext block to the MAC and decrypt it in the same pass */
+    memcpy(chain, pInitial_value, STSE_PLATFORM_AES_BLOCK_SIZE);
+    for (offset = 0; offset < encryptedtext_length; offset += STSE_PLATFORM_AES_BLOCK_SIZE) {
+        memcpy(cipher_block, pEncryptedtext + offset, STSE_PLATFORM_AES_BLOCK_SIZE);
+        if (stse_platform_aes_cmac_ctx_append(pCmac_ctx, cipher_block, STSE_PLATFORM_AES_BLOCK_SIZE) != STSE_OK) {
+            stse_platform_aes_zeroize(pPlaintext, encryptedtext_length);
+            return STSE_PLATFORM_AES_CMAC_VERIFY_ERROR;
+        }
+        out_length = STSE_PLATFORM_AES_BLOCK_SIZE;
+        if (cmox_cipher_append(pAes_key->pDec, cipher_block, STSE_PLATFORM_AES_BLOCK_SIZE,
+                               pPlaintext + offset, &out_length) != CMOX_CIPHER_SUCCESS) {
+            stse_platform_aes_cmac_ctx_clear(pCmac_ctx);
+            stse_platform_aes_zeroize(pPlaintext, encryptedtext_length);
+            return STSE_PLATFORM_AES_CBC_DECRYPT_ERROR;
+        }
+        stse_platform_aes_xor_block(pPlaintext + offset, pPlaintext + offset, chain);
+        memcpy(chain, cipher_block, STSE_PLATFORM_AES_BLOCK_SIZE);
+    }
+
+    /* - Release the plaintext only if the tag matches */
+    ret = stse_platform_aes_cmac_ctx_verify_finish(pCmac_ctx, pTag);
+    if (ret != STSE_OK) {
+        stse_platform_aes_zeroize(pPlaintext, encryptedtext_length);
+        return ret;
+    }
+
+    *pPlaintext_length = encryptedtext_length;
+
     return STSE_OK;
 }
 
+#ifdef STSE_CONF_PLATFORM_AES_KEY_CACHE
+typedef struct {
+    stse_platform_aes_key_t aes_key;
+    PLAT_UI8 key_digest[CMOX_SHA256_SIZE]; /* SHA-256 of the key : no second copy of the raw key */
+    PLAT_UI16 key_length;
+    PLAT_UI32 last_use;
+    const void *pSession;
+} stse_platform_aes_key_cache_entry_t;
+
+static stse_platform_aes_key_cache_entry_t stse_platform_aes_key_cache[STSE_PLATFORM_AES_KEY_CACHE_SIZE];
+static PLAT_UI32 stse_platform_aes_key_cache_use_count;
+static const void *stse_platform_aes_key_cache_session;
+
+static void stse_platform_aes_key_cache_evict(stse_platform_aes_key_cache_entry_t *pEntry) {
+    stse_platform_aes_key_clear(&pEntry->aes_key);
+    stse_platform_aes_zeroize(pEntry, sizeof(stse_platform_aes_key_cache_entry_t));
+}
+
+static stse_platform_aes_key_t *stse_platform_aes_key_cache_get(const PLAT_UI8 *pKey, PLAT_UI16 key_length) {
+    stse_platform_aes_key_cache_entry_t *pEntry;
+    stse_platform_aes_key_cache_entry_t *pVictim = &stse_platform_aes_key_cache[0];
+    PLAT_UI8 key_digest[CMOX_SHA256_SIZE];
+    size_t digest_length;
+    PLAT_UI8 diff;
+    PLAT_UI16 i;
+    PLAT_UI8 slot;
+
+    /* - No bound session : keys are not kept beyond the call */
+    if (stse_platform_aes_key_cache_session == NULL || pKey == NULL || key_length > STSE_PLATFORM_AES_MAX_KEY_SIZE) {
+        return NULL;
+    }
+
+    /* - Keys are looked up by their digest */
+    if (cmox_hash_compute(CMOX_SHA256_ALGO, pKey, key_length,
+                          key_digest, sizeof(key_digest), &digest_length) != CMOX_HASH_SUCCESS) {
+        return NULL;
+    }
+
+    /* - Look for the key among the bound session keys (constant time comparison) */
+    for (slot = 0; slot < STSE_PLATFORM_AES_KEY_CACHE_SIZE; slot++) {
+        pEntry = &stse_platform_aes_key_cache[slot];
+        if (pEntry->aes_key.valid && pEntry->pSession == stse_platform_aes_key_cache_session &&
+            pEntry->key_length == key_length) {
+            diff = 0;
+            for (i = 0; i < sizeof(key_digest); i++) {
+                diff |= pEntry->key_digest[i] ^ key_digest[i];
+            }
+            if (diff == 0) {
+                pEntry->last_use = ++stse_platform_aes_key_cache_use_count;
+                return &pEntry->aes_key;
+            }
+        }
+        /* - Free slot first, then least recently used */
+        if (pVictim->aes_key.valid && (!pEntry->aes_key.valid || pEntry->last_use < pVictim->last_use)) {
+            pVictim = pEntry;
+        }
+    }
+
+    /* - Expand the key in the victim slot */
+    stse_platform_aes_key_cache_evict(pVictim);
+    if (stse_platform_aes_key_init(&pVictim->aes_key, pKey, key_length) != STSE_OK) {
+        return NULL;
+    }
+    memcpy(pVictim->key_digest, key_digest, sizeof(key_digest));
+    pVictim->key_length = key_length;
+    pVictim->last_use = ++stse_platform_aes_key_cache_use_count;
+    pVictim->pSession = stse_platform_aes_key_cache_session;
+
+    return &pVictim->aes_key;
+}
+
+void stse_platform_aes_key_cache_open(const void *pSession) {
+    stse_platform_aes_key_cache_session = pSession;
+}
+
+void stse_platform_aes_key_cache_close(const void *pSession) {
+    PLAT_UI8 slot;
+
+    if (pSession == NULL) {
+        return;
+    }
+    for (slot = 0; slot < STSE_PLATFORM_AES_KEY_CACHE_SIZE; slot++) {
+        if (stse_platform_aes_key_cache[slot].pSession == pSession) {
+            stse_platform_aes_key_cache_evict(&stse_platform_aes_key_cache[slot]);
+        }
+    }
+    if (stse_platform_aes_key_cache_session == pSession) {
+        stse_platform_aes_key_cache_session = NULL;
+    }
+}
+
+void stse_platform_aes_key_cache_flush(void) {
+    PLAT_UI8 slot;
+
+    for (slot = 0; slot < STSE_PLATFORM_AES_KEY_CACHE_SIZE; slot++) {
+        stse_platform_aes_key_cache_evict(&stse_platform_aes_key_cache[slot]);
+    }
+    stse_platform_aes_key_cache_use_count = 0;
+    stse_platform_aes_key_cache_session = NULL;
+}
+#endif /* STSE_CONF_PLATFORM_AES_KEY_CACHE */
+
+stse_ReturnCode_t stse_platform_aes_cmac_init(const PLAT_UI8 *pKey,
+                                              PLAT_UI16 key_length,
+                                              PLAT_UI16 exp_tag_size) {
+    return stse_platform_aes_cmac_ctx_init(&stse_platform_aes_cmac_default_ctx, pKey, key_length, exp_tag_size);
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_append(PLAT_UI8 *pInput,
+                                                PLAT_UI16 lenght) {
+    return stse_platform_aes_cmac_ctx_append(&stse_platform_aes_cmac_default_ctx, pInput, lenght);
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_compute_finish(PLAT_UI8 *pTag, PLAT_UI8 *pTagLen) {
+    return stse_platform_aes_cmac_ctx_compute_finish(&stse_platform_aes_cmac_default_ctx, pTag, pTagLen);
+}
+
+stse_ReturnCode_t stse_platform_aes_cmac_verify_finish(PLAT_UI8 *pTag) {
+    return stse_platform_aes_cmac_ctx_verify_finish(&stse_platform_aes_cmac_default_ctx, pTag);
+}
+
 stse_ReturnCode_t stse_platform_aes_cmac_compute(const PLAT_UI8 *pPayload,
                                                  PLAT_UI16 payload_length,
                                                  const PLAT_UI8 *pKey,
@@ -111,6 +612,13 @@ stse_ReturnCode_t stse_platform_aes_cmac_compute(const PLAT_UI8 *pPayload,
     cmox_mac_retval_t retval;
     size_t cmox_tag_len = *pTag_length;
 
+#ifdef STSE_CONF_PLATFORM_AES_KEY_CACHE
+    stse_platform_aes_key_t *pAes_key = stse_platform_aes_key_cache_get(pKey, key_length);
+    if (pAes_key != NULL) {
+        return stse_platform_aes_key_cmac_compute(pAes_key, pPayload, payload_length, exp_tag_size, pTag, pTag_length);
+    }
+#endif /* STSE_CONF_PLATFORM_AES_KEY_CACHE */
+
     retval = cmox_mac_compute(CMOX_CMAC_AESSMALL_ALGO, /* Use AES CMAC algorithm */
                               pPayload,                /* Message */
                               payload_length,          /* Message length*/
@@ -140,6 +648,13 @@ stse_ReturnCode_t stse_platform_aes_cmac_verify(const PLAT_UI8 *pPayload,
                                                 PLAT_UI16 tag_length) {
     cmox_mac_retval_t retval;
 
+#ifdef STSE_CONF_PLATFORM_AES_KEY_CACHE
+    stse_platform_aes_key_t *pAes_key = stse_platform_aes_key_cache_get(pKey, key_length);
+    if (pAes_key != NULL) {
+        return stse_platform_aes_key_cmac_verify(pAes_key, pPayload, payload_length, pTag, tag_length);
+    }
+#endif /* STSE_CONF_PLATFORM_AES_KEY_CACHE */
+
     /* - Perform CMAC verification */
     retval = cmox_mac_verify(CMOX_CMAC_AESSMALL_ALGO, /* Use AES CMAC algorithm */
                              pPayload,                /* Message length */
@@ -171,6 +686,14 @@ stse_ReturnCode_t stse_platform_aes_cbc_enc(const PLAT_UI8 *pPlaintext,
     cmox_cipher_retval_t retval;
     size_t cmox_encryptedtext_len = *pEncryptedtext_length;
 
+#ifdef STSE_CONF_PLATFORM_AES_KEY_CACHE
+    stse_platform_aes_key_t *pAes_key = stse_platform_aes_key_cache_get(pKey, key_length);
+    if (pAes_key != NULL) {
+        return stse_platform_aes_key_cbc_enc(pAes_key, pPlaintext, plaintext_length, pInitial_value,
+                                             pEncryptedtext, pEncryptedtext_length);
+    }
+#endif /* STSE_CONF_PLATFORM_AES_KEY_CACHE */
+
     /*- Perform AES ECB Encryption */
     retval = cmox_cipher_encrypt(CMOX_AESSMALL_CBC_ENC_ALGO, /* Use AES CBC algorithm */
                                  pPlaintext,                 /* Plain Text */
@@ -203,6 +726,14 @@ stse_ReturnCode_t stse_platform_aes_cbc_dec(const PLAT_UI8 *pEncryptedtext,
     cmox_cipher_retval_t retval;
     size_t cmox_plaintext_len = *pPlaintext_length;
 
+#ifdef STSE_CONF_PLATFORM_AES_KEY_CACHE
+    stse_platform_aes_key_t *pAes_key = stse_platform_aes_key_cache_get(pKey, key_length);
+    if (pAes_key != NULL) {
+        return stse_platform_aes_key_cbc_dec(pAes_key, pEncryptedtext, encryptedtext_length, pInitial_value,
+                                             pPlaintext, pPlaintext_length);
+    }
+#endif /* STSE_CONF_PLATFORM_AES_KEY_CACHE */
+
     /*- Perform AES ECB decryption */
     retval = cmox_cipher_decrypt(CMOX_AESSMALL_CBC_DEC_ALGO, /* Use AES CBC algorithm */
                                  pEncryptedtext,             /* Ciphered Text */
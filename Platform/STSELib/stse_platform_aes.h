@@ -0,0 +1,222 @@
+/******************************************************************************
+ * \file	stse_platform_aes.h
+ * \brief   STSecureElement AES platform file (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_PLATFORM_AES_H
+#define STSE_PLATFORM_AES_H
+
+#include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
+#include "core/stse_platform.h"
+#include "stse_conf.h"
+
+#define STSE_PLATFORM_AES_BLOCK_SIZE 16U
+#define STSE_PLATFORM_AES_MAX_KEY_SIZE 32U
+
+/* AES key handle : encryption / decryption key schedules and CMAC subkeys K1/K2
+ * expanded once (e.g. per secure session) and reused for every CMAC and CBC
+ * operation performed with the key */
+typedef struct {
+    cmox_ecb_handle_t enc_handle;
+    cmox_ecb_handle_t dec_handle;
+    cmox_cipher_handle_t *pEnc;
+    cmox_cipher_handle_t *pDec;
+    PLAT_UI8 k1[STSE_PLATFORM_AES_BLOCK_SIZE];
+    PLAT_UI8 k2[STSE_PLATFORM_AES_BLOCK_SIZE];
+    PLAT_UI8 valid;
+} stse_platform_aes_key_t;
+
+/* Key cache (STSE_CONF_PLATFORM_AES_KEY_CACHE in stse_conf.h) : while a session is
+ * bound with stse_platform_aes_key_cache_open, stse_platform_aes_cmac_compute/verify
+ * and stse_platform_aes_cbc_enc/dec keep the handles of the last
+ * STSE_PLATFORM_AES_KEY_CACHE_SIZE keys used so that session traffic does not
+ * expand the same key on every frame. Cached keys belong to the
+ * bound session and are zeroized by stse_platform_aes_key_cache_close ; keys used
+ * outside a bound session are expanded per call and never cached.
+ * Entries are matched on the SHA-256 of the key (one hash per lookup) : the
+ * cache holds the expanded key handles, not a copy of the raw keys */
+#define STSE_PLATFORM_AES_KEY_CACHE_SIZE 4U // Session MAC and encryption keys. Shall be adapted to applicative use case!
+
+/*!
+ * \brief	Expand an AES key in a key handle
+ * \param[out] pAes_key		AES key handle
+ * \param[in] pKey			AES key
+ * \param[in] key_length	AES key length (16, 24 or 32)
+ * \result  STSE_OK on success ; STSE_PLATFORM_CRYPTO_INIT_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_key_init(stse_platform_aes_key_t *pAes_key,
+                                             const PLAT_UI8 *pKey,
+                                             PLAT_UI16 key_length);
+
+/*!
+ * \brief	Release an AES key handle and zeroize the expanded key material
+ * \param[in,out] pAes_key	AES key handle
+ */
+void stse_platform_aes_key_clear(stse_platform_aes_key_t *pAes_key);
+
+stse_ReturnCode_t stse_platform_aes_key_cmac_compute(stse_platform_aes_key_t *pAes_key,
+                                                     const PLAT_UI8 *pPayload,
+                                                     PLAT_UI16 payload_length,
+                                                     PLAT_UI16 exp_tag_size,
+                                                     PLAT_UI8 *pTag,
+                                                     PLAT_UI16 *pTag_length);
+
+stse_ReturnCode_t stse_platform_aes_key_cmac_verify(stse_platform_aes_key_t *pAes_key,
+                                                    const PLAT_UI8 *pPayload,
+                                                    PLAT_UI16 payload_length,
+                                                    const PLAT_UI8 *pTag,
+                                                    PLAT_UI16 tag_length);
+
+/*!
+ * \brief	AES CBC encryption with a key handle (payload length multiple of 16)
+ */
+stse_ReturnCode_t stse_platform_aes_key_cbc_enc(stse_platform_aes_key_t *pAes_key,
+                                                const PLAT_UI8 *pPlaintext,
+                                                PLAT_UI16 plaintext_length,
+                                                const PLAT_UI8 *pInitial_value,
+                                                PLAT_UI8 *pEncryptedtext,
+                                                PLAT_UI16 *pEncryptedtext_length);
+
+/*!
+ * \brief	AES CBC decryption with a key handle (in place decryption supported)
+ */
+stse_ReturnCode_t stse_platform_aes_key_cbc_dec(stse_platform_aes_key_t *pAes_key,
+                                                const PLAT_UI8 *pEncryptedtext,
+                                                PLAT_UI16 encryptedtext_length,
+                                                const PLAT_UI8 *pInitial_value,
+                                                PLAT_UI8 *pPlaintext,
+                                                PLAT_UI16 *pPlaintext_length);
+
+/* Streaming CMAC context : each secure session (or key establishment) owns its
+ * context so that several MAC computations can be interleaved across devices
+ * and tasks. The legacy stse_platform_aes_cmac_init/append/finish API runs on a
+ * platform default context */
+typedef struct {
+    stse_platform_aes_key_t key;                  /* Key expanded by stse_platform_aes_cmac_ctx_init */
+    stse_platform_aes_key_t *pAes_key;            /* Key in use (own key or caller key handle) */
+    PLAT_UI8 state[STSE_PLATFORM_AES_BLOCK_SIZE]; /* CBC-MAC chaining value */
+    PLAT_UI8 block[STSE_PLATFORM_AES_BLOCK_SIZE]; /* Pending (possibly last) message block */
+    PLAT_UI8 block_length;
+    PLAT_UI8 tag_length;
+} stse_platform_aes_cmac_ctx_t;
+
+/*!
+ * \brief	Start a CMAC computation with its own copy of the expanded key
+ * \param[out] pCtx			CMAC context
+ * \param[in] pKey			AES key
+ * \param[in] key_length	AES key length
+ * \param[in] exp_tag_size	Tag length (1 to 16)
+ * \result  STSE_OK on success ; STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_init(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                  const PLAT_UI8 *pKey,
+                                                  PLAT_UI16 key_length,
+                                                  PLAT_UI16 exp_tag_size);
+
+/*!
+ * \brief	Start a CMAC computation on a caller key handle
+ * \details	The key handle shall remain valid until the context is finished
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_init_with_key(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                           stse_platform_aes_key_t *pAes_key,
+                                                           PLAT_UI16 exp_tag_size);
+
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_append(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                    const PLAT_UI8 *pInput,
+                                                    PLAT_UI16 length);
+
+/*!
+ * \brief	Generate the tag and clear the context
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_compute_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                            PLAT_UI8 *pTag,
+                                                            PLAT_UI8 *pTag_length);
+
+/*!
+ * \brief	Verify the tag (constant time) and clear the context
+ * \result  STSE_OK on match ; STSE_PLATFORM_AES_CMAC_VERIFY_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_cmac_ctx_verify_finish(stse_platform_aes_cmac_ctx_t *pCtx,
+                                                           const PLAT_UI8 *pTag);
+
+/*!
+ * \brief	Abort a CMAC computation and zeroize the context
+ */
+void stse_platform_aes_cmac_ctx_clear(stse_platform_aes_cmac_ctx_t *pCtx);
+
+/*!
+ * \brief	Single pass AES CBC encryption and CMAC of the ciphertext (encrypt-then-MAC)
+ * \details	Each ciphertext block is appended to pCmac_ctx as soon as it is produced.
+ *          The context may already hold leading authenticated data (e.g. frame header)
+ *          and is finished (tag generated, context cleared) by this call
+ * \param[in] pAes_key				Encryption key handle
+ * \param[in,out] pCmac_ctx			Started CMAC context
+ * \param[in] pPlaintext			Plaintext (length multiple of 16)
+ * \param[in] plaintext_length		Plaintext length
+ * \param[in] pInitial_value		CBC initial value
+ * \param[out] pEncryptedtext		Ciphertext (may be pPlaintext)
+ * \param[in,out] pEncryptedtext_length	Ciphertext buffer size / length
+ * \param[out] pTag					CMAC tag of the context data followed by the ciphertext
+ * \param[out] pTag_length			CMAC tag length
+ * \result  STSE_OK on success ; stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_key_cbc_enc_cmac(stse_platform_aes_key_t *pAes_key,
+                                                     stse_platform_aes_cmac_ctx_t *pCmac_ctx,
+                                                     const PLAT_UI8 *pPlaintext,
+                                                     PLAT_UI16 plaintext_length,
+                                                     const PLAT_UI8 *pInitial_value,
+                                                     PLAT_UI8 *pEncryptedtext,
+                                                     PLAT_UI16 *pEncryptedtext_length,
+                                                     PLAT_UI8 *pTag,
+                                                     PLAT_UI8 *pTag_length);
+
+/*!
+ * \brief	Single pass CMAC verification of the ciphertext and AES CBC decryption
+ * \details	Mirror of stse_platform_aes_key_cbc_enc_cmac. The plaintext is zeroized
+ *          if the tag does not match
+ * \result  STSE_OK on success ; STSE_PLATFORM_AES_CMAC_VERIFY_ERROR on tag mismatch ;
+ *          stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_aes_key_cmac_verify_cbc_dec(stse_platform_aes_key_t *pAes_key,
+                                                            stse_platform_aes_cmac_ctx_t *pCmac_ctx,
+                                                            const PLAT_UI8 *pEncryptedtext,
+                                                            PLAT_UI16 encryptedtext_length,
+                                                            const PLAT_UI8 *pInitial_value,
+                                                            const PLAT_UI8 *pTag,
+                                                            PLAT_UI8 *pPlaintext,
+                                                            PLAT_UI16 *pPlaintext_length);
+
+#ifdef STSE_CONF_PLATFORM_AES_KEY_CACHE
+/*!
+ * \brief	Bind the key cache to a session
+ * \details	Keys used by the platform AES services are cached on behalf of pSession
+ *          until stse_platform_aes_key_cache_close is called with the same handle
+ * \param[in] pSession	Session handle (e.g. the STSELib session context)
+ */
+void stse_platform_aes_key_cache_open(const void *pSession);
+
+/*!
+ * \brief	Zeroize the keys cached for a session and unbind it
+ * \param[in] pSession	Session handle given to stse_platform_aes_key_cache_open
+ */
+void stse_platform_aes_key_cache_close(const void *pSession);
+
+/*!
+ * \brief	Zeroize all cached AES key handles and unbind the session
+ */
+void stse_platform_aes_key_cache_flush(void);
+#endif /* STSE_CONF_PLATFORM_AES_KEY_CACHE */
+
+#endif /* STSE_PLATFORM_AES_H */
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * \file	stse_platform_arena.c
+ * \brief   STSecureElement crypto scratch arena platform file
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "stm32l4xx.h"
+#include "stse_platform_arena.h"
+#include "stse_platform_ecc.h"
+#include "stse_platform_hash.h"
+#include <string.h>
+
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+
+#ifdef STSE_CONF_PLATFORM_ARENA_IN_SRAM2
+#define STSE_PLATFORM_ARENA_PLACEMENT __attribute__((section(".ram2"), aligned(STSE_PLATFORM_ARENA_ALIGN)))
+#else
+#define STSE_PLATFORM_ARENA_PLACEMENT __attribute__((aligned(STSE_PLATFORM_ARENA_ALIGN)))
+#endif
+
+/* Block header, stored in the STSE_PLATFORM_ARENA_ALIGN bytes preceding each block */
+typedef struct {
+    PLAT_UI32 previous_top;   /* Arena top before the block was acquired */
+    PLAT_UI32 previous_block; /* Offset of the previously acquired block */
+} stse_platform_arena_header_t;
+
+static PLAT_UI8 stse_platform_arena[(STSE_PLATFORM_ARENA_SIZE + STSE_PLATFORM_ARENA_ALIGN - 1U) & ~(STSE_PLATFORM_ARENA_ALIGN - 1U)] STSE_PLATFORM_ARENA_PLACEMENT;
+static PLAT_UI32 stse_platform_arena_top;        /* Offset of the first free byte */
+static PLAT_UI32 stse_platform_arena_last_block; /* Offset of the last acquired block (0 : none) */
+static PLAT_UI32 stse_platform_arena_high_mark;  /* Highest top offset reached */
+
+void *stse_platform_arena_acquire(PLAT_UI32 size) {
+    stse_platform_arena_header_t *pHeader;
+    PLAT_UI32 primask;
+    PLAT_UI32 block_size;
+    void *pBlock = NULL;
+
+    /* - Round block size to arena alignment and add the block header */
+    block_size = (size + (STSE_PLATFORM_ARENA_ALIGN - 1U)) & ~(STSE_PLATFORM_ARENA_ALIGN - 1U);
+    if (block_size < size) {
+        return NULL;
+    }
+    block_size += STSE_PLATFORM_ARENA_ALIGN;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (block_size <= (sizeof(stse_platform_arena) - stse_platform_arena_top)) {
+        pHeader = (stse_platform_arena_header_t *)&stse_platform_arena[stse_platform_arena_top];
+        pHeader->previous_top = stse_platform_arena_top;
+        pHeader->previous_block = stse_platform_arena_last_block;
+
+        stse_platform_arena_last_block = stse_platform_arena_top + STSE_PLATFORM_ARENA_ALIGN;
+        stse_platform_arena_top += block_size;
+        if (stse_platform_arena_top > stse_platform_arena_high_mark) {
+            stse_platform_arena_high_mark = stse_platform_arena_top;
+        }
+        pBlock = &stse_platform_arena[stse_platform_arena_last_block];
+    }
+    __set_PRIMASK(primask);
+
+    return pBlock;
+}
+
+stse_ReturnCode_t stse_platform_arena_release(void *pBlock) {
+    stse_platform_arena_header_t *pHeader;
+    volatile PLAT_UI8 *pByte;
+    PLAT_UI32 primask;
+
+    /* - Ownership check, zeroize and top update in one critical section : a block
+     *   acquired from an interrupt in between would otherwise be zeroized or freed */
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    /* - Only the last acquired block can be released */
+    if ((stse_platform_arena_last_block == 0) || ((PLAT_UI8 *)pBlock != &stse_platform_arena[stse_platform_arena_last_block])) {
+        __set_PRIMASK(primask);
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    /* - Zeroize the block while it is still owned (nested users release theirs first) */
+    for (pByte = pBlock; pByte < &stse_platform_arena[stse_platform_arena_top]; pByte++) {
+        *pByte = 0;
+    }
+
+    pHeader = (stse_platform_arena_header_t *)((PLAT_UI8 *)pBlock - STSE_PLATFORM_ARENA_ALIGN);
+    stse_platform_arena_top = pHeader->previous_top;
+    stse_platform_arena_last_block = pHeader->previous_block;
+    memset(pHeader, 0, sizeof(stse_platform_arena_header_t));
+    __set_PRIMASK(primask);
+
+    return STSE_OK;
+}
+
+PLAT_UI32 stse_platform_arena_in_use(void) {
+    return stse_platform_arena_top;
+}
+
+PLAT_UI32 stse_platform_arena_high_water(void) {
+    return stse_platform_arena_high_mark;
+}
+
+void stse_platform_arena_reset_high_water(void) {
+    stse_platform_arena_high_mark = stse_platform_arena_top;
+}
+
+#endif /* STSE_CONF_PLATFORM_CRYPTO_ARENA */
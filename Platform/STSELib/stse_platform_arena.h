@@ -0,0 +1,89 @@
+/******************************************************************************
+ * \file	stse_platform_arena.h
+ * \brief   STSecureElement crypto scratch arena platform file (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_PLATFORM_ARENA_H
+#define STSE_PLATFORM_ARENA_H
+
+#include "core/stse_platform.h"
+#include "stse_conf.h"
+
+/* Crypto scratch arena (STSE_CONF_PLATFORM_CRYPTO_ARENA in stse_conf.h) : ECC math
+ * buffers, ECC nonces and HMAC midstates are borrowed from a single stack-ordered
+ * arena for the duration of an operation instead of being reserved statically (or
+ * on the stack) by each platform file.
+ * Blocks are released in reverse acquisition order and zeroized on release.
+ * Acquire / release bookkeeping runs with interrupts masked : operations nested
+ * in interrupt handlers complete before the interrupted one resumes. Tasks of a
+ * preemptive scheduler shall not share the arena (release order not guaranteed).
+ * STSE_CONF_PLATFORM_ARENA_IN_SRAM2 places the arena in the .ram2 section of the
+ * linker script */
+
+/* Number of ECC engines holding a math buffer at the same time : one per engine
+ * explicitly constructed with stse_platform_ecc_engine_init (held until
+ * deinit), plus one for the engines constructed per operation */
+#ifndef STSE_PLATFORM_ARENA_ECC_ENGINES
+#define STSE_PLATFORM_ARENA_ECC_ENGINES 1U
+#endif
+
+#define STSE_PLATFORM_ARENA_ALIGN 8U
+#define STSE_PLATFORM_ARENA_BLOCK_OVERHEAD (2U * STSE_PLATFORM_ARENA_ALIGN) /* Block header + size rounding */
+#define STSE_PLATFORM_ARENA_ECC_RANDOM_SIZE 72U /* NIST P-521 private key length aligned to 4 */
+#define STSE_PLATFORM_ARENA_MAC_SIZE sizeof(stse_platform_hmac_sha256_midstate_t)
+
+/* Largest concurrent need : the engine math buffers and an ECC nonce nested in
+ * a MAC computation */
+#define STSE_PLATFORM_ARENA_SIZE                                                                                   \
+    (STSE_PLATFORM_ARENA_ECC_ENGINES * (STSE_PLATFORM_ECC_MATH_BUFFER_SIZE + STSE_PLATFORM_ARENA_BLOCK_OVERHEAD) + \
+     STSE_PLATFORM_ARENA_ECC_RANDOM_SIZE + STSE_PLATFORM_ARENA_BLOCK_OVERHEAD +                                    \
+     STSE_PLATFORM_ARENA_MAC_SIZE + STSE_PLATFORM_ARENA_BLOCK_OVERHEAD)
+
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+
+/*!
+ * \brief	Borrow a block from the crypto arena
+ * \param[in] size	Block size in bytes
+ * \result  Pointer to the block (STSE_PLATFORM_ARENA_ALIGN aligned) ; NULL if the arena is exhausted
+ */
+void *stse_platform_arena_acquire(PLAT_UI32 size);
+
+/*!
+ * \brief	Return a block to the crypto arena
+ * \details	Only the last acquired block can be released. Released memory is zeroized
+ *          with interrupts masked (masking time proportional to the block size)
+ * \param[in] pBlock	Block returned by stse_platform_arena_acquire
+ * \result  STSE_OK on success ; STSE_PLATFORM_INVALID_PARAMETER if pBlock is not the last acquired block
+ */
+stse_ReturnCode_t stse_platform_arena_release(void *pBlock);
+
+/*!
+ * \brief	Get the number of arena bytes currently in use
+ */
+PLAT_UI32 stse_platform_arena_in_use(void);
+
+/*!
+ * \brief	Get the highest number of arena bytes used since start-up (or last reset)
+ */
+PLAT_UI32 stse_platform_arena_high_water(void);
+
+/*!
+ * \brief	Reset the arena high-water mark to the current use
+ */
+void stse_platform_arena_reset_high_water(void);
+
+#endif /* STSE_CONF_PLATFORM_CRYPTO_ARENA */
+
+#endif /* STSE_PLATFORM_ARENA_H */
@@ -0,0 +1,510 @@
+/******************************************************************************
+ * \file	stse_platform_bench.c
+ * \brief   STSecureElement crypto platform benchmark
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "stse_platform_bench.h"
+
+#ifdef STSE_CONF_PLATFORM_BENCHMARK
+
+#include "Drivers/crc16/crc16.h"
+#include "Drivers/cycle_counter/cycle_counter.h"
+#include "stse_platform_ecc.h"
+#include "stse_platform_hash.h"
+#include "stselib.h"
+
+#if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED) ||   \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
+#define STSE_PLATFORM_BENCH_ECC_SIGN
+#endif
+
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) ||                      \
+    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||               \
+    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) ||                 \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED) ||   \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||          \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
+#define STSE_PLATFORM_BENCH_ECC_ECDH
+#endif
+
+#if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||               \
+    defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||          \
+    defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
+#define STSE_PLATFORM_BENCH_NIST_KW
+#endif
+
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
+#define STSE_PLATFORM_BENCH_AES_CMAC
+#endif
+
+#if defined(STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || defined(STSE_CONF_USE_HOST_SESSION)
+#define STSE_PLATFORM_BENCH_AES_CIPHER
+#endif
+
+#define STSE_PLATFORM_BENCH_STACK_PATTERN 0xA5A5A5A5U
+#define STSE_PLATFORM_BENCH_STACK_MARGIN 64U /* Bytes left unpainted under the caller frame */
+#define STSE_PLATFORM_BENCH_DIGEST_SIZE 32U
+#define STSE_PLATFORM_BENCH_AES_KEY_SIZE 16U
+#define STSE_PLATFORM_BENCH_PRIV_KEY_SIZE 66U  /* NIST P-521 */
+#define STSE_PLATFORM_BENCH_PUB_KEY_SIZE 132U  /* NIST P-521 */
+#define STSE_PLATFORM_BENCH_SIGNATURE_SIZE 132U /* NIST P-521 */
+
+/* CRC16 engine compiled in (see Drivers/crc16/crc16.h) : rebuild with each
+ * CRC16_HW_IMP / CRC16_HW_DMA / CRC16_SW_SLICING setting to compare engines */
+#if defined(CRC16_HW_IMP) && defined(CRC16_HW_DMA)
+#define STSE_PLATFORM_BENCH_CRC16_ENGINE "HW+DMA"
+#elif defined(CRC16_HW_IMP)
+#define STSE_PLATFORM_BENCH_CRC16_ENGINE "HW"
+#elif (CRC16_SW_SLICING == 8)
+#define STSE_PLATFORM_BENCH_CRC16_ENGINE "SW slice-8"
+#elif (CRC16_SW_SLICING == 4)
+#define STSE_PLATFORM_BENCH_CRC16_ENGINE "SW slice-4"
+#else
+#define STSE_PLATFORM_BENCH_CRC16_ENGINE "SW table"
+#endif
+
+typedef stse_ReturnCode_t (*stse_platform_bench_op_t)(void);
+
+typedef struct {
+    stse_ecc_key_type_t key_type;
+    const char *pName;
+} stse_platform_bench_curve_t;
+
+/* Linker script symbols */
+extern PLAT_UI8 _estack;
+extern PLAT_UI32 _Min_Stack_Size;
+extern void *_sbrk(ptrdiff_t incr);
+
+static const stse_platform_bench_curve_t stse_platform_bench_curves[] = {
+#ifdef STSE_CONF_ECC_NIST_P_256
+    {STSE_ECC_KT_NIST_P_256, "NIST P-256"},
+#endif
+#ifdef STSE_CONF_ECC_NIST_P_384
+    {STSE_ECC_KT_NIST_P_384, "NIST P-384"},
+#endif
+#ifdef STSE_CONF_ECC_NIST_P_521
+    {STSE_ECC_KT_NIST_P_521, "NIST P-521"},
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_256
+    {STSE_ECC_KT_BP_P_256, "Brainpool P-256"},
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_384
+    {STSE_ECC_KT_BP_P_384, "Brainpool P-384"},
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_512
+    {STSE_ECC_KT_BP_P_512, "Brainpool P-512"},
+#endif
+#ifdef STSE_CONF_ECC_CURVE_25519
+    {STSE_ECC_KT_CURVE25519, "Curve25519"},
+#endif
+#ifdef STSE_CONF_ECC_EDWARD_25519
+    {STSE_ECC_KT_ED25519, "Ed25519"},
+#endif
+};
+
+static const struct {
+    stse_hash_algorithm_t algo;
+    const char *pName;
+} stse_platform_bench_hashes[] = {
+#ifdef STSE_CONF_HASH_SHA_1
+    {STSE_SHA_1, "SHA-1"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_224
+    {STSE_SHA_224, "SHA-224"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_256
+    {STSE_SHA_256, "SHA-256"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_384
+    {STSE_SHA_384, "SHA-384"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_512
+    {STSE_SHA_512, "SHA-512"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_256
+    {STSE_SHA3_256, "SHA3-256"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_384
+    {STSE_SHA3_384, "SHA3-384"},
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_512
+    {STSE_SHA3_512, "SHA3-512"},
+#endif
+};
+
+/* Frame sizes : short command / response frames up to the bulk buffer size */
+static const struct {
+    PLAT_UI16 length;
+    const char *pName;
+} stse_platform_bench_crc16_frames[] = {
+    {8U, STSE_PLATFORM_BENCH_CRC16_ENGINE " 8B"},
+    {32U, STSE_PLATFORM_BENCH_CRC16_ENGINE " 32B"},
+    {128U, STSE_PLATFORM_BENCH_CRC16_ENGINE " 128B"},
+    {STSE_PLATFORM_BENCH_BULK_SIZE, STSE_PLATFORM_BENCH_CRC16_ENGINE " 256B"},
+};
+
+static struct {
+    stse_platform_bench_result_t *pResults;
+    PLAT_UI16 max_results;
+    PLAT_UI16 count;
+} stse_platform_bench_table;
+
+/* Operation operands */
+static stse_ecc_key_type_t stse_platform_bench_key_type;
+static stse_hash_algorithm_t stse_platform_bench_hash_algo;
+static PLAT_UI16 stse_platform_bench_crc16_length;
+static PLAT_UI8 stse_platform_bench_priv_key[STSE_PLATFORM_BENCH_PRIV_KEY_SIZE];
+static PLAT_UI8 stse_platform_bench_pub_key[STSE_PLATFORM_BENCH_PUB_KEY_SIZE];
+static PLAT_UI8 stse_platform_bench_signature[STSE_PLATFORM_BENCH_SIGNATURE_SIZE];
+static PLAT_UI8 stse_platform_bench_shared_secret[STSE_PLATFORM_BENCH_PRIV_KEY_SIZE];
+static PLAT_UI8 stse_platform_bench_digest[64];
+static PLAT_UI8 stse_platform_bench_key[32];
+static PLAT_UI8 stse_platform_bench_input[STSE_PLATFORM_BENCH_BULK_SIZE];
+static PLAT_UI8 stse_platform_bench_output[STSE_PLATFORM_BENCH_BULK_SIZE + 8U];
+
+__attribute__((weak)) PLAT_UI32 stse_platform_bench_get_cycles(void) {
+    return cycle_counter_get();
+}
+
+/* ---------------------------------------------------------------------------
+ * Measured operations
+ * ------------------------------------------------------------------------- */
+
+static stse_ReturnCode_t stse_platform_bench_ecc_generate_key_pair(void) {
+    return stse_platform_ecc_generate_key_pair(stse_platform_bench_key_type,
+                                               stse_platform_bench_priv_key,
+                                               stse_platform_bench_pub_key);
+}
+
+#ifdef STSE_PLATFORM_BENCH_ECC_SIGN
+static stse_ReturnCode_t stse_platform_bench_ecc_sign(void) {
+    return stse_platform_ecc_sign(stse_platform_bench_key_type,
+                                  stse_platform_bench_priv_key,
+                                  stse_platform_bench_digest, STSE_PLATFORM_BENCH_DIGEST_SIZE,
+                                  stse_platform_bench_signature);
+}
+
+static stse_ReturnCode_t stse_platform_bench_ecc_verify(void) {
+#ifdef STSE_CONF_PLATFORM_ECC_VERIFY_CACHE
+    /* - Measure the full verification, not a cache hit */
+    stse_platform_ecc_verify_cache_invalidate();
+#endif
+    return stse_platform_ecc_verify(stse_platform_bench_key_type,
+                                    stse_platform_bench_pub_key,
+                                    stse_platform_bench_digest, STSE_PLATFORM_BENCH_DIGEST_SIZE,
+                                    stse_platform_bench_signature);
+}
+#endif /* STSE_PLATFORM_BENCH_ECC_SIGN */
+
+#ifdef STSE_PLATFORM_BENCH_ECC_ECDH
+static stse_ReturnCode_t stse_platform_bench_ecc_ecdh(void) {
+    return stse_platform_ecc_ecdh(stse_platform_bench_key_type,
+                                  stse_platform_bench_pub_key,
+                                  stse_platform_bench_priv_key,
+                                  stse_platform_bench_shared_secret);
+}
+#endif /* STSE_PLATFORM_BENCH_ECC_ECDH */
+
+static stse_ReturnCode_t stse_platform_bench_hash_compute(void) {
+    PLAT_UI16 digest_length;
+
+    switch (stse_platform_bench_hash_algo) {
+    case STSE_SHA_1:
+        digest_length = 20U;
+        break;
+    case STSE_SHA_224:
+        digest_length = 28U;
+        break;
+    case STSE_SHA_256:
+    case STSE_SHA3_256:
+        digest_length = 32U;
+        break;
+    case STSE_SHA_384:
+    case STSE_SHA3_384:
+        digest_length = 48U;
+        break;
+    default:
+        digest_length = 64U;
+        break;
+    }
+
+    return stse_platform_hash_compute(stse_platform_bench_hash_algo,
+                                      stse_platform_bench_input, STSE_PLATFORM_BENCH_BULK_SIZE,
+                                      stse_platform_bench_digest, &digest_length);
+}
+
+static stse_ReturnCode_t stse_platform_bench_hmac_sha256_extract(void) {
+    return stse_platform_hmac_sha256_extract(stse_platform_bench_key, sizeof(stse_platform_bench_key),
+                                             stse_platform_bench_input, 32U,
+                                             stse_platform_bench_digest, 32U);
+}
+
+static stse_ReturnCode_t stse_platform_bench_hmac_sha256_expand(void) {
+    return stse_platform_hmac_sha256_expand(stse_platform_bench_key, sizeof(stse_platform_bench_key),
+                                            stse_platform_bench_input, 16U,
+                                            stse_platform_bench_output, 64U);
+}
+
+static stse_ReturnCode_t stse_platform_bench_hmac_sha256_extract_expand(void) {
+    return stse_platform_hmac_sha256_extract_expand(stse_platform_bench_key, sizeof(stse_platform_bench_key),
+                                                    stse_platform_bench_input, 32U,
+                                                    stse_platform_bench_input, 16U,
+                                                    stse_platform_bench_output, 64U);
+}
+
+#ifdef STSE_PLATFORM_BENCH_AES_CMAC
+static stse_ReturnCode_t stse_platform_bench_aes_cmac_compute(void) {
+    PLAT_UI16 tag_length = 16U;
+
+    return stse_platform_aes_cmac_compute(stse_platform_bench_input, STSE_PLATFORM_BENCH_BULK_SIZE,
+                                          stse_platform_bench_key, STSE_PLATFORM_BENCH_AES_KEY_SIZE,
+                                          16U, stse_platform_bench_digest, &tag_length);
+}
+
+static stse_ReturnCode_t stse_platform_bench_aes_cmac_verify(void) {
+    return stse_platform_aes_cmac_verify(stse_platform_bench_input, STSE_PLATFORM_BENCH_BULK_SIZE,
+                                         stse_platform_bench_key, STSE_PLATFORM_BENCH_AES_KEY_SIZE,
+                                         stse_platform_bench_digest, 16U);
+}
+
+static stse_ReturnCode_t stse_platform_bench_aes_cmac_stream(void) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 tag_length = 16U;
+
+    ret = stse_platform_aes_cmac_init(stse_platform_bench_key, STSE_PLATFORM_BENCH_AES_KEY_SIZE, 16U);
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cmac_append(stse_platform_bench_input, STSE_PLATFORM_BENCH_BULK_SIZE);
+    }
+    if (ret == STSE_OK) {
+        ret = stse_platform_aes_cmac_compute_finish(stse_platform_bench_digest, &tag_length);
+    }
+
+    return ret;
+}
+#endif /* STSE_PLATFORM_BENCH_AES_CMAC */
+
+#ifdef STSE_PLATFORM_BENCH_AES_CIPHER
+static stse_ReturnCode_t stse_platform_bench_aes_cbc_enc(void) {
+    PLAT_UI8 iv[16] = {0};
+    PLAT_UI16 output_length = STSE_PLATFORM_BENCH_BULK_SIZE;
+
+    return stse_platform_aes_cbc_enc(stse_platform_bench_input, STSE_PLATFORM_BENCH_BULK_SIZE, iv,
+                                     stse_platform_bench_key, STSE_PLATFORM_BENCH_AES_KEY_SIZE,
+                                     stse_platform_bench_output, &output_length);
+}
+
+static stse_ReturnCode_t stse_platform_bench_aes_cbc_dec(void) {
+    PLAT_UI8 iv[16] = {0};
+    PLAT_UI16 output_length = STSE_PLATFORM_BENCH_BULK_SIZE;
+
+    return stse_platform_aes_cbc_dec(stse_platform_bench_input, STSE_PLATFORM_BENCH_BULK_SIZE, iv,
+                                     stse_platform_bench_key, STSE_PLATFORM_BENCH_AES_KEY_SIZE,
+                                     stse_platform_bench_output, &output_length);
+}
+
+static stse_ReturnCode_t stse_platform_bench_aes_ecb_enc(void) {
+    PLAT_UI16 output_length = STSE_PLATFORM_BENCH_BULK_SIZE;
+
+    return stse_platform_aes_ecb_enc(stse_platform_bench_input, STSE_PLATFORM_BENCH_BULK_SIZE,
+                                     stse_platform_bench_key, STSE_PLATFORM_BENCH_AES_KEY_SIZE,
+                                     stse_platform_bench_output, &output_length);
+}
+
+static stse_ReturnCode_t stse_platform_bench_aes_ecb_dec(void) {
+    PLAT_UI16 output_length = STSE_PLATFORM_BENCH_BULK_SIZE;
+
+    return stse_platform_aes_ecb_dec(stse_platform_bench_input, STSE_PLATFORM_BENCH_BULK_SIZE,
+                                     stse_platform_bench_key, STSE_PLATFORM_BENCH_AES_KEY_SIZE,
+                                     stse_platform_bench_output, &output_length);
+}
+#endif /* STSE_PLATFORM_BENCH_AES_CIPHER */
+
+#ifdef STSE_PLATFORM_BENCH_NIST_KW
+static stse_ReturnCode_t stse_platform_bench_nist_kw_encrypt(void) {
+    PLAT_UI32 output_length = 40U;
+
+    return stse_platform_nist_kw_encrypt(stse_platform_bench_input, 32U,
+                                         stse_platform_bench_key, STSE_PLATFORM_BENCH_AES_KEY_SIZE,
+                                         stse_platform_bench_output, &output_length);
+}
+#endif /* STSE_PLATFORM_BENCH_NIST_KW */
+
+static stse_ReturnCode_t stse_platform_bench_crc16_calculate(void) {
+    crc16_Calculate(stse_platform_bench_input, stse_platform_bench_crc16_length);
+
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_platform_bench_crc16_copy_calculate(void) {
+    crc16_Copy_Calculate(stse_platform_bench_output, stse_platform_bench_input, stse_platform_bench_crc16_length);
+
+    return STSE_OK;
+}
+
+/* ---------------------------------------------------------------------------
+ * Measurement
+ * ------------------------------------------------------------------------- */
+
+static void stse_platform_bench_measure(const char *pName,
+                                        const char *pVariant,
+                                        stse_platform_bench_op_t op,
+                                        PLAT_UI32 bytes) {
+    stse_platform_bench_result_t *pResult;
+    volatile PLAT_UI32 *pStack_top;
+    volatile PLAT_UI32 *pStack_bottom;
+    volatile PLAT_UI32 *pWord;
+    PLAT_UI8 *pStack_limit;
+    PLAT_UI8 *pHeap_start;
+    PLAT_UI32 start;
+    PLAT_UI32 iteration;
+
+    if (stse_platform_bench_table.count >= stse_platform_bench_table.max_results) {
+        return;
+    }
+    pResult = &stse_platform_bench_table.pResults[stse_platform_bench_table.count++];
+
+    pResult->pName = pName;
+    pResult->pVariant = pVariant;
+    pResult->bytes = bytes;
+
+    pHeap_start = _sbrk(0);
+
+    /* - Paint the stack area under the current frame */
+    pStack_top = (volatile PLAT_UI32 *)(((uintptr_t)__get_MSP() - STSE_PLATFORM_BENCH_STACK_MARGIN) & ~(uintptr_t)3U);
+    pStack_limit = &_estack - (uintptr_t)&_Min_Stack_Size;
+    pStack_bottom = pStack_top - (STSE_PLATFORM_BENCH_STACK_PAINT_SIZE / sizeof(PLAT_UI32));
+    if ((PLAT_UI8 *)pStack_bottom < pStack_limit) {
+        pStack_bottom = (volatile PLAT_UI32 *)pStack_limit;
+    }
+    for (pWord = pStack_bottom; pWord < pStack_top; pWord++) {
+        *pWord = STSE_PLATFORM_BENCH_STACK_PATTERN;
+    }
+
+    /* - First run : stack usage (also constructs lazily initialized contexts) */
+    pResult->status = op();
+
+    /* - Find the deepest overwritten word */
+    for (pWord = pStack_bottom; pWord < pStack_top; pWord++) {
+        if (*pWord != STSE_PLATFORM_BENCH_STACK_PATTERN) {
+            break;
+        }
+    }
+    pResult->stack_peak = (PLAT_UI32)(pStack_top - pWord) * sizeof(PLAT_UI32) + STSE_PLATFORM_BENCH_STACK_MARGIN;
+
+    /* - Deepest painted word overwritten : the operation may have gone further */
+    pResult->stack_overflow = (pWord == pStack_bottom);
+
+    /* - Timed runs */
+    pResult->cycles = 0;
+    if (pResult->status == STSE_OK) {
+        start = stse_platform_bench_get_cycles();
+        for (iteration = 0; iteration < STSE_PLATFORM_BENCH_ITERATIONS; iteration++) {
+            pResult->status = op();
+            if (pResult->status != STSE_OK) {
+                break;
+            }
+        }
+        pResult->cycles = (stse_platform_bench_get_cycles() - start) / STSE_PLATFORM_BENCH_ITERATIONS;
+    }
+
+    pResult->heap_peak = (PLAT_UI32)((PLAT_UI8 *)_sbrk(0) - pHeap_start);
+}
+
+PLAT_UI16 stse_platform_bench_run(stse_platform_bench_result_t *pResults, PLAT_UI16 max_results) {
+    PLAT_UI16 i;
+
+    if (pResults == NULL) {
+        return 0;
+    }
+
+    stse_platform_bench_table.pResults = pResults;
+    stse_platform_bench_table.max_results = max_results;
+    stse_platform_bench_table.count = 0;
+
+    cycle_counter_init();
+
+    /* - Deterministic operands */
+    for (i = 0; i < sizeof(stse_platform_bench_input); i++) {
+        stse_platform_bench_input[i] = (PLAT_UI8)i;
+    }
+    for (i = 0; i < sizeof(stse_platform_bench_key); i++) {
+        stse_platform_bench_key[i] = (PLAT_UI8)(0xA0 + i);
+    }
+    memset(stse_platform_bench_digest, 0x5A, sizeof(stse_platform_bench_digest));
+
+    /* - ECC primitives on each enabled curve */
+    for (i = 0; i < sizeof(stse_platform_bench_curves) / sizeof(stse_platform_bench_curves[0]); i++) {
+        stse_platform_bench_key_type = stse_platform_bench_curves[i].key_type;
+
+        stse_platform_bench_measure("ecc_generate_key_pair", stse_platform_bench_curves[i].pName,
+                                    stse_platform_bench_ecc_generate_key_pair, 0);
+#ifdef STSE_PLATFORM_BENCH_ECC_SIGN
+        if (stse_platform_bench_key_type != STSE_ECC_KT_CURVE25519) {
+            stse_platform_bench_measure("ecc_sign", stse_platform_bench_curves[i].pName,
+                                        stse_platform_bench_ecc_sign, 0);
+            stse_platform_bench_measure("ecc_verify", stse_platform_bench_curves[i].pName,
+                                        stse_platform_bench_ecc_verify, 0);
+        }
+#endif
+#ifdef STSE_PLATFORM_BENCH_ECC_ECDH
+        if (stse_platform_bench_key_type != STSE_ECC_KT_ED25519) {
+            stse_platform_bench_measure("ecc_ecdh", stse_platform_bench_curves[i].pName,
+                                        stse_platform_bench_ecc_ecdh, 0);
+        }
+#endif
+    }
+
+    /* - Hash primitives */
+    for (i = 0; i < sizeof(stse_platform_bench_hashes) / sizeof(stse_platform_bench_hashes[0]); i++) {
+        stse_platform_bench_hash_algo = stse_platform_bench_hashes[i].algo;
+        stse_platform_bench_measure("hash_compute", stse_platform_bench_hashes[i].pName,
+                                    stse_platform_bench_hash_compute, STSE_PLATFORM_BENCH_BULK_SIZE);
+    }
+    stse_platform_bench_measure("hmac_sha256_extract", "", stse_platform_bench_hmac_sha256_extract, 32U);
+    stse_platform_bench_measure("hmac_sha256_expand", "", stse_platform_bench_hmac_sha256_expand, 64U);
+    stse_platform_bench_measure("hmac_sha256_extract_expand", "", stse_platform_bench_hmac_sha256_extract_expand, 64U);
+
+    /* - AES primitives */
+#ifdef STSE_PLATFORM_BENCH_AES_CMAC
+    stse_platform_bench_measure("aes_cmac_compute", "AES-128", stse_platform_bench_aes_cmac_compute, STSE_PLATFORM_BENCH_BULK_SIZE);
+    stse_platform_bench_measure("aes_cmac_verify", "AES-128", stse_platform_bench_aes_cmac_verify, STSE_PLATFORM_BENCH_BULK_SIZE);
+    stse_platform_bench_measure("aes_cmac_init/append/finish", "AES-128", stse_platform_bench_aes_cmac_stream, STSE_PLATFORM_BENCH_BULK_SIZE);
+#endif
+#ifdef STSE_PLATFORM_BENCH_AES_CIPHER
+    stse_platform_bench_measure("aes_cbc_enc", "AES-128", stse_platform_bench_aes_cbc_enc, STSE_PLATFORM_BENCH_BULK_SIZE);
+    stse_platform_bench_measure("aes_cbc_dec", "AES-128", stse_platform_bench_aes_cbc_dec, STSE_PLATFORM_BENCH_BULK_SIZE);
+    stse_platform_bench_measure("aes_ecb_enc", "AES-128", stse_platform_bench_aes_ecb_enc, STSE_PLATFORM_BENCH_BULK_SIZE);
+    stse_platform_bench_measure("aes_ecb_dec", "AES-128", stse_platform_bench_aes_ecb_dec, STSE_PLATFORM_BENCH_BULK_SIZE);
+#endif
+#ifdef STSE_PLATFORM_BENCH_NIST_KW
+    stse_platform_bench_measure("nist_kw_encrypt", "AES-128", stse_platform_bench_nist_kw_encrypt, 32U);
+#endif
+
+    /* - CRC16 engine per frame size */
+    for (i = 0; i < sizeof(stse_platform_bench_crc16_frames) / sizeof(stse_platform_bench_crc16_frames[0]); i++) {
+        stse_platform_bench_crc16_length = stse_platform_bench_crc16_frames[i].length;
+        stse_platform_bench_measure("crc16_calculate", stse_platform_bench_crc16_frames[i].pName,
+                                    stse_platform_bench_crc16_calculate, stse_platform_bench_crc16_length);
+        stse_platform_bench_measure("crc16_copy_calculate", stse_platform_bench_crc16_frames[i].pName,
+                                    stse_platform_bench_crc16_copy_calculate, stse_platform_bench_crc16_length);
+    }
+
+    return stse_platform_bench_table.count;
+}
+
+#endif /* STSE_CONF_PLATFORM_BENCHMARK */
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * \file	stse_platform_bench.h
+ * \brief   STSecureElement crypto platform benchmark (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_PLATFORM_BENCH_H
+#define STSE_PLATFORM_BENCH_H
+
+#include "core/stse_platform.h"
+#include "stse_conf.h"
+
+#ifdef STSE_CONF_PLATFORM_BENCHMARK
+
+/* Each enabled stse_platform_* crypto primitive is run
+ * STSE_PLATFORM_BENCH_ITERATIONS times. Bulk primitives (AES, hash, CMAC)
+ * process STSE_PLATFORM_BENCH_BULK_SIZE bytes per operation. Peak stack is
+ * measured by painting STSE_PLATFORM_BENCH_STACK_PAINT_SIZE bytes below the
+ * current stack pointer (bounded by the reserved stack) : an operation
+ * reaching the bottom of the painted area is reported as a stack overflow */
+#define STSE_PLATFORM_BENCH_ITERATIONS 4U
+#define STSE_PLATFORM_BENCH_BULK_SIZE 256U
+#ifndef STSE_PLATFORM_BENCH_STACK_PAINT_SIZE
+#define STSE_PLATFORM_BENCH_STACK_PAINT_SIZE 4096U
+#endif
+#define STSE_PLATFORM_BENCH_MAX_RESULTS 64U
+
+typedef struct {
+    const char *pName;        /* Primitive name */
+    const char *pVariant;     /* Curve / algorithm ("" when not applicable) */
+    stse_ReturnCode_t status; /* Last operation return code */
+    PLAT_UI32 cycles;         /* Average cycles per operation */
+    PLAT_UI32 bytes;          /* Bytes processed per operation (bulk primitives, 0 otherwise) */
+    PLAT_UI32 stack_peak;     /* Peak stack usage of one operation (bytes) */
+    PLAT_UI8 stack_overflow;  /* Painted area exhausted : stack_peak is a lower bound */
+    PLAT_UI32 heap_peak;      /* Heap growth over the measurement (bytes) */
+} stse_platform_bench_result_t;
+
+/*!
+ * \brief	Read the benchmark time base (DWT cycle counter by default)
+ * \details	Weak : may be overridden by the application
+ * \result  Current cycle count
+ */
+PLAT_UI32 stse_platform_bench_get_cycles(void);
+
+/*!
+ * \brief	Run the benchmark on every enabled crypto primitive
+ * \param[out] pResults		Result table
+ * \param[in] max_results	Result table size
+ * \result  Number of results written
+ */
+PLAT_UI16 stse_platform_bench_run(stse_platform_bench_result_t *pResults, PLAT_UI16 max_results);
+
+#endif /* STSE_CONF_PLATFORM_BENCHMARK */
+
+#endif /* STSE_PLATFORM_BENCH_H */
@@ -17,8 +17,21 @@
 
 #include "Drivers/crc16/crc16.h"
 #include "stse_conf.h"
+#include "stse_platform_crc.h"
 #include "stselib.h"
 
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE) || defined(STSE_CONF_PLATFORM_I2C_RECEIVE_CRC)
+/* Response verified by the I2C PAL, core CRC pass in progress over it */
+static PLAT_UI8 *pCrc16_verified_header = NULL;
+static PLAT_UI16 crc16_verified;
+static PLAT_UI8 crc16_verified_pass = 0;
+
+void stse_platform_crc16_receive_verified(PLAT_UI8 *pHeader, PLAT_UI16 crc) {
+    pCrc16_verified_header = pHeader;
+    crc16_verified = crc;
+}
+#endif
+
 stse_ReturnCode_t stse_platform_crc16_init(void) {
     crc16_Init();
 
@@ -26,9 +39,22 @@ stse_ReturnCode_t stse_platform_crc16_init(void) {
 }
 
 PLAT_UI16 stse_platform_Crc16_Calculate(PLAT_UI8 *pbuffer, PLAT_UI16 length) {
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE) || defined(STSE_CONF_PLATFORM_I2C_RECEIVE_CRC)
+    /* - Core pass over the verified response : CRC already computed */
+    crc16_verified_pass = (pCrc16_verified_header != NULL) && (pbuffer == pCrc16_verified_header) && (length == 1U);
+    pCrc16_verified_header = NULL;
+    if (crc16_verified_pass) {
+        return crc16_verified;
+    }
+#endif
     return crc16_Calculate(pbuffer, length);
 }
 
 PLAT_UI16 stse_platform_Crc16_Accumulate(PLAT_UI8 *pbuffer, PLAT_UI16 length) {
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE) || defined(STSE_CONF_PLATFORM_I2C_RECEIVE_CRC)
+    if (crc16_verified_pass) {
+        return crc16_verified;
+    }
+#endif
     return crc16_Accumulate(pbuffer, length);
 }
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * \file	stse_platform_crc.h
+ * \brief   STSecureElement CRC16 platform file (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_PLATFORM_CRC_H
+#define STSE_PLATFORM_CRC_H
+
+#include "core/stse_platform.h"
+#include "stse_conf.h"
+
+/* Fused receive CRC (STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE in stse_conf.h) : the I2C
+ * PAL receive copies accumulate the response CRC (header and payload) in the same
+ * pass, and receive_stop compares it with the received CRC field
+ * (STSE_CORE_FRAME_CRC_ERROR on mismatch) */
+
+/* Receive loop CRC (STSE_CONF_PLATFORM_I2C_RECEIVE_CRC in stse_conf.h) : the I2C driver
+ * accumulates the response CRC by chunks while the frame is received (header and
+ * payload, length and CRC fields excluded), and receive_stop compares it with the
+ * received CRC field (STSE_CORE_FRAME_CRC_ERROR on mismatch) */
+
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE) && defined(STSE_CONF_PLATFORM_I2C_RECEIVE_CRC)
+#error "STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE and STSE_CONF_PLATFORM_I2C_RECEIVE_CRC are exclusive"
+#endif
+
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE) || defined(STSE_CONF_PLATFORM_I2C_RECEIVE_CRC)
+/*!
+ * \brief	Mark the last received response as CRC verified by the I2C PAL
+ * \details	The core CRC pass over the response elements is skipped : the next
+ *          stse_platform_Crc16_Calculate call on the response header (pHeader,
+ *          1 byte) and the stse_platform_Crc16_Accumulate calls following it
+ *          return crc without reading the elements. Any other Calculate call
+ *          ends the skipped pass
+ * \param[in] pHeader	Response header element (NULL : no verified response)
+ * \param[in] crc		Verified response CRC
+ */
+void stse_platform_crc16_receive_verified(PLAT_UI8 *pHeader, PLAT_UI16 crc);
+#endif
+
+#endif /* STSE_PLATFORM_CRC_H */
@@ -17,6 +17,7 @@
 
 #include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
 #include "stse_conf.h"
+#include "stse_platform_ecc.h"
 #include "stselib.h"
 
 stse_ReturnCode_t stse_platform_crypto_init(void) {
@@ -27,5 +28,10 @@ stse_ReturnCode_t stse_platform_crypto_init(void) {
         ret = STSE_PLATFORM_CRYPTO_INIT_ERROR;
     }
 
+#ifdef STSE_CONF_PLATFORM_ECC_KEY_POOL
+    /* - Ephemeral key pool is not initialized by the startup code (SRAM2) */
+    stse_platform_ecc_pool_flush();
+#endif
+
     return ret;
 }
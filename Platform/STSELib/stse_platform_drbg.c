@@ -0,0 +1,133 @@
+/******************************************************************************
+ * \file	stse_platform_drbg.c
+ * \brief   STSecureElement deterministic random bit generator platform file
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "Drivers/rng/rng.h"
+#include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
+#include "stse_conf.h"
+#include "stse_platform_drbg.h"
+#include "stselib.h"
+
+#define STSE_PLATFORM_DRBG_ENTROPY_SIZE 32U /* AES-256 security strength */
+#define STSE_PLATFORM_DRBG_NONCE_SIZE 16U
+#define STSE_PLATFORM_DRBG_MAX_REQUEST 0x10000U /* 2^19 bits per generate request */
+
+typedef struct {
+    cmox_ctr_drbg_handle_t ctr_drbg;
+    cmox_drbg_handle_t *pDrbg;
+    PLAT_UI32 requests;
+    PLAT_UI32 reseed_interval;
+    const char *personalization;
+} stse_platform_drbg_t;
+
+static stse_platform_drbg_t stse_platform_drbg[STSE_PLATFORM_DRBG_COUNT] = {
+    {.reseed_interval = STSE_PLATFORM_DRBG_PAYLOAD_RESEED_INTERVAL, .personalization = "STSE DRBG PAYLOAD"},
+    {.reseed_interval = STSE_PLATFORM_DRBG_NONCE_RESEED_INTERVAL, .personalization = "STSE DRBG NONCE"},
+};
+
+static void _stse_platform_drbg_collect(PLAT_UI8 *pBuffer, PLAT_UI32 length) {
+    /* - Entropy input from the hardware RNG pool */
+    rng_fill(pBuffer, length);
+}
+
+static stse_ReturnCode_t _stse_platform_drbg_instantiate(stse_platform_drbg_t *pInstance) {
+    PLAT_UI8 entropy[STSE_PLATFORM_DRBG_ENTROPY_SIZE];
+    PLAT_UI8 nonce[STSE_PLATFORM_DRBG_NONCE_SIZE];
+    cmox_drbg_retval_t retval;
+
+    pInstance->pDrbg = cmox_ctr_drbg_construct(&pInstance->ctr_drbg, CMOX_CTR_DRBG_AES256);
+    if (pInstance->pDrbg == NULL) {
+        return STSE_PLATFORM_CRYPTO_INIT_ERROR;
+    }
+
+    _stse_platform_drbg_collect(entropy, sizeof(entropy));
+    _stse_platform_drbg_collect(nonce, sizeof(nonce));
+    retval = cmox_drbg_init(pInstance->pDrbg,
+                            entropy,
+                            sizeof(entropy),
+                            (const uint8_t *)pInstance->personalization,
+                            strlen(pInstance->personalization),
+                            nonce,
+                            sizeof(nonce));
+    memset(entropy, 0, sizeof(entropy));
+    memset(nonce, 0, sizeof(nonce));
+
+    if (retval != CMOX_DRBG_SUCCESS) {
+        cmox_drbg_cleanup(pInstance->pDrbg);
+        pInstance->pDrbg = NULL;
+        return STSE_PLATFORM_CRYPTO_INIT_ERROR;
+    }
+    pInstance->requests = 0;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_drbg_reseed(stse_platform_drbg_id_t drbg_id) {
+    stse_platform_drbg_t *pInstance;
+    PLAT_UI8 entropy[STSE_PLATFORM_DRBG_ENTROPY_SIZE];
+    cmox_drbg_retval_t retval;
+
+    if (drbg_id >= STSE_PLATFORM_DRBG_COUNT) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+    pInstance = &stse_platform_drbg[drbg_id];
+
+    if (pInstance->pDrbg == NULL) {
+        return _stse_platform_drbg_instantiate(pInstance);
+    }
+
+    _stse_platform_drbg_collect(entropy, sizeof(entropy));
+    retval = cmox_drbg_reseed(pInstance->pDrbg, entropy, sizeof(entropy), NULL, 0);
+    memset(entropy, 0, sizeof(entropy));
+
+    if (retval != CMOX_DRBG_SUCCESS) {
+        return STSE_PLATFORM_CRYPTO_INIT_ERROR;
+    }
+    pInstance->requests = 0;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_drbg_generate(stse_platform_drbg_id_t drbg_id, PLAT_UI8 *pOutput, PLAT_UI32 length) {
+    stse_platform_drbg_t *pInstance;
+    stse_ReturnCode_t ret;
+    PLAT_UI32 chunk;
+
+    if ((drbg_id >= STSE_PLATFORM_DRBG_COUNT) || (pOutput == NULL)) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+    pInstance = &stse_platform_drbg[drbg_id];
+
+    while (length > 0) {
+        /* - Instantiate on first use / reseed when the interval is reached */
+        if ((pInstance->pDrbg == NULL) || (pInstance->requests >= pInstance->reseed_interval)) {
+            ret = stse_platform_drbg_reseed(drbg_id);
+            if (ret != STSE_OK) {
+                return ret;
+            }
+        }
+
+        chunk = (length > STSE_PLATFORM_DRBG_MAX_REQUEST) ? STSE_PLATFORM_DRBG_MAX_REQUEST : length;
+        if (cmox_drbg_generate(pInstance->pDrbg, NULL, 0, pOutput, chunk) != CMOX_DRBG_SUCCESS) {
+            return STSE_PLATFORM_CRYPTO_INIT_ERROR;
+        }
+        pInstance->requests++;
+        pOutput += chunk;
+        length -= chunk;
+    }
+
+    return STSE_OK;
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * \file	stse_platform_drbg.h
+ * \brief   STSecureElement deterministic random bit generator platform file (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_PLATFORM_DRBG_H
+#define STSE_PLATFORM_DRBG_H
+
+#include "core/stse_platform.h"
+
+/* CMOX CTR-DRBG (AES-256) instances seeded from the hardware RNG. Each instance is
+ * instantiated on first use and reseeded from the hardware RNG every
+ * STSE_PLATFORM_DRBG_<ID>_RESEED_INTERVAL generate requests */
+#define STSE_PLATFORM_DRBG_PAYLOAD_RESEED_INTERVAL 4096U
+#define STSE_PLATFORM_DRBG_NONCE_RESEED_INTERVAL 32U
+
+typedef enum {
+    STSE_PLATFORM_DRBG_PAYLOAD = 0, /* Non security test payloads */
+    STSE_PLATFORM_DRBG_NONCE,       /* Security relevant nonces and private keys */
+    STSE_PLATFORM_DRBG_COUNT
+} stse_platform_drbg_id_t;
+
+/*!
+ * \brief	Generate random bytes from a DRBG instance
+ * \param[in] drbg_id	DRBG instance
+ * \param[out] pOutput	Output buffer
+ * \param[in] length	Number of bytes to generate
+ * \result  STSE_OK on success ; stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_drbg_generate(stse_platform_drbg_id_t drbg_id, PLAT_UI8 *pOutput, PLAT_UI32 length);
+
+/*!
+ * \brief	Force a reseed of a DRBG instance from the hardware RNG
+ * \param[in] drbg_id	DRBG instance
+ * \result  STSE_OK on success ; stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_drbg_reseed(stse_platform_drbg_id_t drbg_id);
+
+#endif /* STSE_PLATFORM_DRBG_H */
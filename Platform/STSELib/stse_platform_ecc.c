@@ -17,36 +17,155 @@
 
 #include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
 #include "stse_conf.h"
+#include "stse_platform_drbg.h"
+#include "stm32l4xx.h"
+#include "stse_platform_ecc.h"
 #include "stselib.h"
 
-cmox_ecc_handle_t Ecc_Ctx;
-PLAT_UI8 cmox_math_buffer[2400];
+#ifdef STSE_CONF_PLATFORM_ECC_FAST
+#define STSE_PLATFORM_ECC_MATH_FUNCS CMOX_MATH_FUNCS_FAST
+#define STSE_PLATFORM_ECC_IMPL(curve) CMOX_ECC_##curve##_HIGHMEM
+#else
+#define STSE_PLATFORM_ECC_MATH_FUNCS CMOX_MATH_FUNCS_SMALL
+#define STSE_PLATFORM_ECC_IMPL(curve) CMOX_ECC_##curve##_LOWMEM
+#endif
+
+/* Engine used by the STSELib platform entry points */
+static stse_platform_ecc_engine_t stse_platform_ecc_default_engine;
+
+static void stse_platform_ecc_zeroize(void *pBuffer, size_t length) {
+    volatile PLAT_UI8 *pByte = (volatile PLAT_UI8 *)pBuffer;
+
+    while (length-- > 0) {
+        *pByte++ = 0;
+    }
+}
+
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+void stse_platform_ecc_engine_init(stse_platform_ecc_engine_t *pEngine) {
+    /*- Borrow math buffer from the crypto arena */
+    pEngine->pMath_buffer = stse_platform_arena_acquire(STSE_PLATFORM_ECC_MATH_BUFFER_SIZE);
+    if (pEngine->pMath_buffer == NULL) {
+        pEngine->constructed = 0;
+        return;
+    }
+
+    /*- Set ECC context */
+    cmox_ecc_construct(&pEngine->ctx,                     /* ECC context */
+                       STSE_PLATFORM_ECC_MATH_FUNCS,      /* Math functions */
+                       pEngine->pMath_buffer,             /* Crypto math buffer */
+                       STSE_PLATFORM_ECC_MATH_BUFFER_SIZE /* buffer size */
+    );
+    pEngine->scoped = 0;
+    pEngine->constructed = 1;
+}
+
+stse_ReturnCode_t stse_platform_ecc_engine_deinit(stse_platform_ecc_engine_t *pEngine) {
+    stse_ReturnCode_t ret;
+
+    if (!pEngine->constructed) {
+        return STSE_OK;
+    }
+
+    /* - Return the math buffer (zeroized) to the arena and clear ECC context.
+     *   Engines holding a math buffer are released in reverse construction order */
+    ret = stse_platform_arena_release(pEngine->pMath_buffer);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+    cmox_ecc_cleanup(&pEngine->ctx);
+    pEngine->pMath_buffer = NULL;
+    pEngine->constructed = 0;
+
+    return STSE_OK;
+}
+#else
+void stse_platform_ecc_engine_init(stse_platform_ecc_engine_t *pEngine) {
+    /*- Set ECC context */
+    cmox_ecc_construct(&pEngine->ctx,                /* ECC context */
+                       STSE_PLATFORM_ECC_MATH_FUNCS, /* Math functions */
+                       pEngine->math_buffer,         /* Crypto math buffer */
+                       sizeof(pEngine->math_buffer)  /* buffer size */
+    );
+    pEngine->constructed = 1;
+}
+
+stse_ReturnCode_t stse_platform_ecc_engine_deinit(stse_platform_ecc_engine_t *pEngine) {
+    /* - Clear ECC context and intermediate values */
+    cmox_ecc_cleanup(&pEngine->ctx);
+    stse_platform_ecc_zeroize(pEngine->math_buffer, sizeof(pEngine->math_buffer));
+    pEngine->constructed = 0;
+
+    return STSE_OK;
+}
+#endif /* STSE_CONF_PLATFORM_CRYPTO_ARENA */
+
+stse_platform_ecc_engine_t *stse_platform_ecc_get_default_engine(void) {
+    return &stse_platform_ecc_default_engine;
+}
+
+static PLAT_UI8 stse_platform_ecc_engine_prepare(stse_platform_ecc_engine_t *pEngine) {
+    /* - Context is constructed on first use and kept across operations
+     *   (for the current operation only when borrowed from the crypto arena) */
+    if (!pEngine->constructed) {
+        stse_platform_ecc_engine_init(pEngine);
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+        pEngine->scoped = 1;
+#endif
+    }
+
+    return pEngine->constructed;
+}
+
+static stse_ReturnCode_t stse_platform_ecc_engine_release(stse_platform_ecc_engine_t *pEngine) {
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+    /* - Fails if a block acquired during the operation is still held above the math buffer */
+    if (pEngine->constructed && pEngine->scoped) {
+        return stse_platform_ecc_engine_deinit(pEngine);
+    }
+#else
+    (void)pEngine;
+#endif
+    return STSE_OK;
+}
+
+static stse_ReturnCode_t stse_platform_ecc_engine_release_secret(stse_platform_ecc_engine_t *pEngine) {
+    /* - Clear the private key intermediates left in a math buffer kept by the engine */
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+    if (pEngine->constructed && !pEngine->scoped) {
+        stse_platform_ecc_zeroize(pEngine->pMath_buffer, STSE_PLATFORM_ECC_MATH_BUFFER_SIZE);
+    }
+#else
+    stse_platform_ecc_zeroize(pEngine->math_buffer, sizeof(pEngine->math_buffer));
+#endif
+    return stse_platform_ecc_engine_release(pEngine);
+}
 
 static cmox_ecc_impl_t stse_platform_get_cmox_ecc_impl(stse_ecc_key_type_t key_type) {
     switch (key_type) {
 #ifdef STSE_CONF_ECC_NIST_P_256
     case STSE_ECC_KT_NIST_P_256:
-        return CMOX_ECC_SECP256R1_LOWMEM;
+        return STSE_PLATFORM_ECC_IMPL(SECP256R1);
 #endif
 #ifdef STSE_CONF_ECC_NIST_P_384
     case STSE_ECC_KT_NIST_P_384:
-        return CMOX_ECC_SECP384R1_LOWMEM;
+        return STSE_PLATFORM_ECC_IMPL(SECP384R1);
 #endif
 #ifdef STSE_CONF_ECC_NIST_P_521
     case STSE_ECC_KT_NIST_P_521:
-        return CMOX_ECC_SECP521R1_LOWMEM;
+        return STSE_PLATFORM_ECC_IMPL(SECP521R1);
 #endif
 #ifdef STSE_CONF_ECC_BRAINPOOL_P_256
     case STSE_ECC_KT_BP_P_256:
-        return CMOX_ECC_BPP256R1_LOWMEM;
+        return STSE_PLATFORM_ECC_IMPL(BPP256R1);
 #endif
 #ifdef STSE_CONF_ECC_BRAINPOOL_P_384
     case STSE_ECC_KT_BP_P_384:
-        return CMOX_ECC_BPP384R1_LOWMEM;
+        return STSE_PLATFORM_ECC_IMPL(BPP384R1);
 #endif
 #ifdef STSE_CONF_ECC_BRAINPOOL_P_512
     case STSE_ECC_KT_BP_P_512:
-        return CMOX_ECC_BPP512R1_LOWMEM;
+        return STSE_PLATFORM_ECC_IMPL(BPP512R1);
 #endif
 #ifdef STSE_CONF_ECC_CURVE_25519
     case STSE_ECC_KT_CURVE25519:
@@ -54,7 +173,7 @@ static cmox_ecc_impl_t stse_platform_get_cmox_ecc_impl(stse_ecc_key_type_t key_t
 #endif
 #ifdef STSE_CONF_ECC_EDWARD_25519
     case STSE_ECC_KT_ED25519:
-        return CMOX_ECC_ED25519_OPT_LOWMEM;
+        return STSE_PLATFORM_ECC_IMPL(ED25519_OPT);
 #endif
     default:
         return NULL;
@@ -100,7 +219,7 @@ static size_t stse_platform_get_cmox_ecc_pub_key_len(stse_ecc_key_type_t key_typ
     }
 }
 
-static size_t stse_platform_get_cmox_ecc_sig_len(stse_ecc_key_type_t key_type) {
+size_t stse_platform_get_cmox_ecc_sig_len(stse_ecc_key_type_t key_type) {
     switch (key_type) {
 #ifdef STSE_CONF_ECC_NIST_P_256
     case STSE_ECC_KT_NIST_P_256:
@@ -128,7 +247,7 @@ static size_t stse_platform_get_cmox_ecc_sig_len(stse_ecc_key_type_t key_type) {
 #endif
 #ifdef STSE_CONF_ECC_CURVE_25519
     case STSE_ECC_KT_CURVE25519:
-        return STSE_OK; /* No signature with curve25519 */
+        return 0u; /* No signature with curve25519 */
 #endif
 #ifdef STSE_CONF_ECC_EDWARD_25519
     case STSE_ECC_KT_ED25519:
@@ -139,7 +258,152 @@ static size_t stse_platform_get_cmox_ecc_sig_len(stse_ecc_key_type_t key_type) {
     }
 }
 
-stse_ReturnCode_t stse_platform_ecc_verify(
+#ifdef STSE_CONF_PLATFORM_ECC_VERIFY_CACHE
+typedef struct {
+    PLAT_UI8 key[CMOX_SHA256_SIZE];
+    PLAT_UI32 timestamp;
+    PLAT_UI32 last_use;
+    PLAT_UI8 valid;
+} stse_platform_ecc_verify_cache_entry_t;
+
+static stse_platform_ecc_verify_cache_entry_t stse_platform_ecc_verify_cache[STSE_PLATFORM_ECC_VERIFY_CACHE_SIZE];
+static stse_platform_ecc_verify_cache_stats_t stse_platform_ecc_verify_cache_stats;
+static PLAT_UI32 stse_platform_ecc_verify_cache_use_count;
+static PLAT_UI32 stse_platform_ecc_verify_cache_requests;
+
+__attribute__((weak)) PLAT_UI32 stse_platform_ecc_verify_cache_get_time(void) {
+    return stse_platform_ecc_verify_cache_requests;
+}
+
+static PLAT_UI8 stse_platform_ecc_verify_cache_key(stse_ecc_key_type_t key_type,
+                                                   const PLAT_UI8 *pPubKey,
+                                                   PLAT_UI8 *pDigest,
+                                                   PLAT_UI16 digestLen,
+                                                   PLAT_UI8 *pSignature,
+                                                   PLAT_UI8 *pKey) {
+    cmox_sha256_handle_t sha256_handle;
+    cmox_hash_handle_t *pHash_handle;
+    cmox_hash_retval_t retval;
+    PLAT_UI8 type = (PLAT_UI8)key_type;
+
+    pHash_handle = cmox_sha256_construct(&sha256_handle);
+    retval = cmox_hash_init(pHash_handle);
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_append(pHash_handle, &type, 1);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_append(pHash_handle, pPubKey, stse_platform_get_cmox_ecc_pub_key_len(key_type));
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_append(pHash_handle, pDigest, digestLen);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_append(pHash_handle, pSignature, stse_platform_get_cmox_ecc_sig_len(key_type));
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_generateTag(pHash_handle, pKey, NULL);
+    }
+    cmox_hash_cleanup(pHash_handle);
+
+    return (retval == CMOX_HASH_SUCCESS);
+}
+
+/* Cache tables are accessed with interrupts masked (callers of _find and _insert) */
+static stse_platform_ecc_verify_cache_entry_t *stse_platform_ecc_verify_cache_find(const PLAT_UI8 *pKey) {
+    PLAT_UI32 now = stse_platform_ecc_verify_cache_get_time();
+    PLAT_UI8 i;
+
+    for (i = 0; i < STSE_PLATFORM_ECC_VERIFY_CACHE_SIZE; i++) {
+        stse_platform_ecc_verify_cache_entry_t *pEntry = &stse_platform_ecc_verify_cache[i];
+
+        if (!pEntry->valid) {
+            continue;
+        }
+        if ((now - pEntry->timestamp) > STSE_PLATFORM_ECC_VERIFY_CACHE_MAX_AGE) {
+            /* - Expired entry */
+            pEntry->valid = 0;
+            stse_platform_ecc_verify_cache_stats.expirations++;
+            continue;
+        }
+        if (memcmp(pEntry->key, pKey, CMOX_SHA256_SIZE) == 0) {
+            return pEntry;
+        }
+    }
+
+    return NULL;
+}
+
+static void stse_platform_ecc_verify_cache_insert(const PLAT_UI8 *pKey) {
+    stse_platform_ecc_verify_cache_entry_t *pVictim = &stse_platform_ecc_verify_cache[0];
+    PLAT_UI32 primask;
+    PLAT_UI8 i;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    /* - Use a free slot, otherwise replace the least recently used entry */
+    for (i = 0; i < STSE_PLATFORM_ECC_VERIFY_CACHE_SIZE; i++) {
+        stse_platform_ecc_verify_cache_entry_t *pEntry = &stse_platform_ecc_verify_cache[i];
+
+        if (!pEntry->valid) {
+            pVictim = pEntry;
+            break;
+        }
+        if (pEntry->last_use < pVictim->last_use) {
+            pVictim = pEntry;
+        }
+    }
+    if (pVictim->valid) {
+        stse_platform_ecc_verify_cache_stats.evictions++;
+    }
+
+    memcpy(pVictim->key, pKey, CMOX_SHA256_SIZE);
+    pVictim->timestamp = stse_platform_ecc_verify_cache_get_time();
+    pVictim->last_use = ++stse_platform_ecc_verify_cache_use_count;
+    pVictim->valid = 1;
+    __set_PRIMASK(primask);
+}
+
+void stse_platform_ecc_verify_cache_invalidate(void) {
+    PLAT_UI32 primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    memset(stse_platform_ecc_verify_cache, 0, sizeof(stse_platform_ecc_verify_cache));
+    __set_PRIMASK(primask);
+}
+
+void stse_platform_ecc_verify_cache_invalidate_entry(stse_ecc_key_type_t key_type,
+                                                     const PLAT_UI8 *pPubKey,
+                                                     PLAT_UI8 *pDigest,
+                                                     PLAT_UI16 digestLen,
+                                                     PLAT_UI8 *pSignature) {
+    stse_platform_ecc_verify_cache_entry_t *pEntry;
+    PLAT_UI8 key[CMOX_SHA256_SIZE];
+    PLAT_UI32 primask;
+
+    if (stse_platform_ecc_verify_cache_key(key_type, pPubKey, pDigest, digestLen, pSignature, key)) {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        pEntry = stse_platform_ecc_verify_cache_find(key);
+        if (pEntry != NULL) {
+            memset(pEntry, 0, sizeof(stse_platform_ecc_verify_cache_entry_t));
+        }
+        __set_PRIMASK(primask);
+    }
+}
+
+void stse_platform_ecc_verify_cache_get_stats(stse_platform_ecc_verify_cache_stats_t *pStats) {
+    PLAT_UI32 primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    *pStats = stse_platform_ecc_verify_cache_stats;
+    __set_PRIMASK(primask);
+}
+#endif /* STSE_CONF_PLATFORM_ECC_VERIFY_CACHE */
+
+stse_ReturnCode_t stse_platform_ecc_engine_verify(
+    stse_platform_ecc_engine_t *pEngine,
     stse_ecc_key_type_t key_type,
     const PLAT_UI8 *pPubKey,
     PLAT_UI8 *pDigest,
@@ -150,18 +414,42 @@ stse_ReturnCode_t stse_platform_ecc_verify(
     defined(STSE_CONF_ECC_CURVE_25519) || defined(STSE_CONF_ECC_EDWARD_25519)
     cmox_ecc_retval_t retval;
     PLAT_UI32 faultCheck;
+#ifdef STSE_CONF_PLATFORM_ECC_VERIFY_CACHE
+    stse_platform_ecc_verify_cache_entry_t *pEntry = NULL;
+    PLAT_UI8 cache_key[CMOX_SHA256_SIZE];
+    PLAT_UI8 cache_key_valid;
+    PLAT_UI32 primask;
+
+    /* - Look for a previous positive verification of the same material
+     *   (key hashed outside of the critical section) */
+    cache_key_valid = stse_platform_ecc_verify_cache_key(key_type, pPubKey, pDigest, digestLen, pSignature, cache_key);
+    primask = __get_PRIMASK();
+    __disable_irq();
+    stse_platform_ecc_verify_cache_requests++;
+    if (cache_key_valid) {
+        pEntry = stse_platform_ecc_verify_cache_find(cache_key);
+    }
+    if (pEntry != NULL) {
+        pEntry->last_use = ++stse_platform_ecc_verify_cache_use_count;
+        stse_platform_ecc_verify_cache_stats.hits++;
+    } else {
+        stse_platform_ecc_verify_cache_stats.misses++;
+    }
+    __set_PRIMASK(primask);
+    if (pEntry != NULL) {
+        return STSE_OK;
+    }
+#endif /* STSE_CONF_PLATFORM_ECC_VERIFY_CACHE */
 
-    /*- Set ECC context */
-    cmox_ecc_construct(&Ecc_Ctx,                /* ECC context */
-                       CMOX_MATH_FUNCS_SMALL,   /* Small math functions */
-                       cmox_math_buffer,        /* Crypto math buffer */
-                       sizeof(cmox_math_buffer) /* buffer size */
-    );
+    /*- Get ECC context */
+    if (!stse_platform_ecc_engine_prepare(pEngine)) {
+        return STSE_PLATFORM_ECC_VERIFY_ERROR;
+    }
 
 #ifdef STSE_CONF_ECC_EDWARD_25519
     if (key_type == STSE_ECC_KT_ED25519) {
         /* - Perform EDDSA verify */
-        retval = cmox_eddsa_verify(&Ecc_Ctx,                                         /* ECC context */
+        retval = cmox_eddsa_verify(&pEngine->ctx,                                    /* ECC context */
                                    stse_platform_get_cmox_ecc_impl(key_type),        /* Curve param */
                                    pPubKey,                                          /* Public key */
                                    stse_platform_get_cmox_ecc_pub_key_len(key_type), /* Public key length */
@@ -175,7 +463,7 @@ stse_ReturnCode_t stse_platform_ecc_verify(
 #endif /* STSE_CONF_ECC_EDWARD_25519 */
     {
         /* - Perform ECDSA verify */
-        retval = cmox_ecdsa_verify(&Ecc_Ctx,                                         /* ECC context */
+        retval = cmox_ecdsa_verify(&pEngine->ctx,                                    /* ECC context */
                                    stse_platform_get_cmox_ecc_impl(key_type),        /* Curve : SECP256R1 */
                                    pPubKey,                                          /* Public key */
                                    stse_platform_get_cmox_ecc_pub_key_len(key_type), /* Public key length */
@@ -187,13 +475,16 @@ stse_ReturnCode_t stse_platform_ecc_verify(
         );
     }
 
-    /* - Clear ECC context */
-    cmox_ecc_cleanup(&Ecc_Ctx);
-
-    if (retval != CMOX_ECC_AUTH_SUCCESS) {
+    if ((stse_platform_ecc_engine_release(pEngine) != STSE_OK) || (retval != CMOX_ECC_AUTH_SUCCESS)) {
         return STSE_PLATFORM_ECC_VERIFY_ERROR;
     }
 
+#ifdef STSE_CONF_PLATFORM_ECC_VERIFY_CACHE
+    if (cache_key_valid) {
+        stse_platform_ecc_verify_cache_insert(cache_key);
+    }
+#endif /* STSE_CONF_PLATFORM_ECC_VERIFY_CACHE */
+
     return STSE_OK;
 #else
     return STSE_PLATFORM_ECC_VERIFY_ERROR;
@@ -202,6 +493,46 @@ stse_ReturnCode_t stse_platform_ecc_verify(
           STSE_CONF_ECC_CURVE_25519 || STSE_CONF_ECC_EDWARD_25519 */
 }
 
+stse_ReturnCode_t stse_platform_ecc_verify(
+    stse_ecc_key_type_t key_type,
+    const PLAT_UI8 *pPubKey,
+    PLAT_UI8 *pDigest,
+    PLAT_UI16 digestLen,
+    PLAT_UI8 *pSignature) {
+    return stse_platform_ecc_engine_verify(&stse_platform_ecc_default_engine, key_type, pPubKey, pDigest, digestLen, pSignature);
+}
+
+stse_ReturnCode_t stse_platform_ecc_engine_verify_batch(stse_platform_ecc_engine_t *pEngine,
+                                                        stse_platform_ecc_verify_item_t *pItems,
+                                                        PLAT_UI16 item_count) {
+    stse_ReturnCode_t ret = STSE_OK;
+    PLAT_UI16 i;
+
+    if ((pItems == NULL) && (item_count != 0)) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    /* - Verify each item in order (one verification per item, no batching) */
+    for (i = 0; i < item_count; i++) {
+        pItems[i].result = stse_platform_ecc_engine_verify(pEngine,
+                                                           pItems[i].key_type,
+                                                           pItems[i].pPubKey,
+                                                           pItems[i].pDigest,
+                                                           pItems[i].digestLen,
+                                                           pItems[i].pSignature);
+        if (pItems[i].result != STSE_OK) {
+            ret = STSE_PLATFORM_ECC_VERIFY_ERROR;
+        }
+    }
+
+    return ret;
+}
+
+stse_ReturnCode_t stse_platform_ecc_verify_batch(stse_platform_ecc_verify_item_t *pItems,
+                                                 PLAT_UI16 item_count) {
+    return stse_platform_ecc_engine_verify_batch(&stse_platform_ecc_default_engine, pItems, item_count);
+}
+
 static size_t stse_platform_get_cmox_ecc_priv_key_len(stse_ecc_key_type_t key_type) {
     switch (key_type) {
 #ifdef STSE_CONF_ECC_NIST_P_256
@@ -241,19 +572,13 @@ static size_t stse_platform_get_cmox_ecc_priv_key_len(stse_ecc_key_type_t key_ty
     }
 }
 
-/* Private_key */
-PLAT_UI8 static_c25519_priv_key[32] = {0x3D, 0xAC, 0x2A, 0xFF, 0x7A, 0x55, 0x9F, 0xAA,
-                                       0xAC, 0x1B, 0xB6, 0x46, 0xE9, 0xD5, 0xE0, 0x50,
-                                       0x28, 0x72, 0xFE, 0x9F, 0xD5, 0xE8, 0x3B, 0x7E,
-                                       0x68, 0x28, 0x7A, 0xB3, 0xF4, 0x7E, 0x59, 0x8F};
-
-/* Public_key */
-PLAT_UI8 static_c25519_pub_key[32] = {0x59, 0x86, 0xA8, 0xA3, 0x51, 0xBB, 0x07, 0xCA,
-                                      0x40, 0x01, 0x76, 0xF7, 0x66, 0x8A, 0x4F, 0xBF,
-                                      0xA1, 0xA5, 0xE1, 0x9A, 0xCB, 0x57, 0x55, 0xF6,
-                                      0x57, 0xF9, 0x43, 0xE9, 0xBC, 0x39, 0x54, 0x0B};
+#ifdef STSE_CONF_ECC_CURVE_25519
+/* X25519 base point (u = 9) */
+static const PLAT_UI8 stse_platform_c25519_base_point[32] = {0x09};
+#endif /* STSE_CONF_ECC_CURVE_25519 */
 
-stse_ReturnCode_t stse_platform_ecc_generate_key_pair(
+static stse_ReturnCode_t stse_platform_ecc_compute_key_pair(
+    stse_platform_ecc_engine_t *pEngine,
     stse_ecc_key_type_t key_type,
     PLAT_UI8 *pPrivKey,
     PLAT_UI8 *pPubKey) {
@@ -262,33 +587,41 @@ stse_ReturnCode_t stse_platform_ecc_generate_key_pair(
     defined(STSE_CONF_ECC_CURVE_25519) || defined(STSE_CONF_ECC_EDWARD_25519)
     cmox_ecc_retval_t retval;
 
-    /*- Set ECC context */
-    cmox_ecc_construct(&Ecc_Ctx,                /* ECC context */
-                       CMOX_MATH_FUNCS_SMALL,   /* Small math functions */
-                       cmox_math_buffer,        /* Crypto math buffer */
-                       sizeof(cmox_math_buffer) /* buffer size */
-    );
+    /*- Get ECC context */
+    if (!stse_platform_ecc_engine_prepare(pEngine)) {
+        return STSE_PLATFORM_ECC_GENERATE_KEY_PAIR_ERROR;
+    }
 
     /* Minimum random length equal the private key length */
     size_t randomLength = stse_platform_get_cmox_ecc_priv_key_len(key_type);
     /* Align the random length to modulo 4 */
     randomLength += 4 - (randomLength & 0x3);
-    /* Add 32bytes to random length if the key is Curve25519 because it will use the Ed25519 key gen */
-#ifdef STSE_CONF_ECC_CURVE_25519
-    randomLength += ((key_type == STSE_ECC_KT_CURVE25519) ? 32 : 0);
-#endif /* STSE_CONF_ECC_CURVE_25519 */
     /* Retry loop in case the RNG isn't strong enough */
     do {
         /* - Generate a random number */
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+        PLAT_UI8 *randomNumber = stse_platform_arena_acquire(randomLength);
+        if (randomNumber == NULL) {
+            stse_platform_ecc_engine_release_secret(pEngine);
+            return STSE_PLATFORM_ECC_GENERATE_KEY_PAIR_ERROR;
+        }
+#else
         PLAT_UI8 randomNumber[randomLength];
-        for (uint8_t i = 0; i < randomLength; i += 4) {
-            *((PLAT_UI32 *)&randomNumber[i]) = stse_platform_generate_random();
+#endif
+        if (stse_platform_drbg_generate(STSE_PLATFORM_DRBG_NONCE, randomNumber, randomLength) != STSE_OK) {
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+            stse_platform_arena_release(randomNumber);
+#else
+            stse_platform_ecc_zeroize(randomNumber, randomLength);
+#endif
+            stse_platform_ecc_engine_release_secret(pEngine);
+            return STSE_PLATFORM_ECC_GENERATE_KEY_PAIR_ERROR;
         }
 
         /*- Generate EdDSA key pair */
 #ifdef STSE_CONF_ECC_EDWARD_25519
         if (key_type == STSE_ECC_KT_ED25519) {
-            retval = cmox_eddsa_keyGen(&Ecc_Ctx,                                  /* ECC context */
+            retval = cmox_eddsa_keyGen(&pEngine->ctx,                             /* ECC context */
                                        stse_platform_get_cmox_ecc_impl(key_type), /* Curve param */
                                        randomNumber,                              /* Random number */
                                        randomLength,                              /* Random number length */
@@ -300,14 +633,20 @@ stse_ReturnCode_t stse_platform_ecc_generate_key_pair(
 #endif /* STSE_CONF_ECC_EDWARD_25519 */
 #ifdef STSE_CONF_ECC_CURVE_25519
             if (key_type == STSE_ECC_KT_CURVE25519) {
-            memcpy(pPrivKey, static_c25519_priv_key, 32);
-            memcpy(pPubKey, static_c25519_pub_key, 32);
-
-            retval = CMOX_ECC_SUCCESS;
+            /* - Private key : random scalar (clamped by X25519) / Public key : X25519(priv, 9) */
+            memcpy(pPrivKey, randomNumber, CMOX_ECC_CURVE25519_PRIVKEY_LEN);
+            retval = cmox_ecdh(&pEngine->ctx,                              /* ECC context */
+                               CMOX_ECC_CURVE25519,                        /* Curve param */
+                               pPrivKey,                                   /* Private key */
+                               CMOX_ECC_CURVE25519_PRIVKEY_LEN,            /* Private key length */
+                               stse_platform_c25519_base_point,            /* Base point */
+                               sizeof(stse_platform_c25519_base_point),    /* Base point length */
+                               pPubKey,                                    /* Public key */
+                               NULL);                                      /* Public key length */
         } else
 #endif /* STSE_CONF_ECC_CURVE_25519 */
         {
-            retval = cmox_ecdsa_keyGen(&Ecc_Ctx,                                  /* ECC context */
+            retval = cmox_ecdsa_keyGen(&pEngine->ctx,                             /* ECC context */
                                        stse_platform_get_cmox_ecc_impl(key_type), /* Curve param */
                                        randomNumber,                              /* Random number */
                                        randomLength,                              /* Random number length */
@@ -316,12 +655,14 @@ stse_ReturnCode_t stse_platform_ecc_generate_key_pair(
                                        pPubKey,                                   /* Public key */
                                        NULL);                                     /* Public key length */
         }
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+        stse_platform_arena_release(randomNumber);
+#else
+        stse_platform_ecc_zeroize(randomNumber, randomLength);
+#endif
     } while (retval == CMOX_ECC_ERR_WRONG_RANDOM);
 
-    /* - Clear ECC context */
-    cmox_ecc_cleanup(&Ecc_Ctx);
-
-    if (retval != CMOX_ECC_SUCCESS) {
+    if ((stse_platform_ecc_engine_release_secret(pEngine) != STSE_OK) || (retval != CMOX_ECC_SUCCESS)) {
         return STSE_PLATFORM_ECC_GENERATE_KEY_PAIR_ERROR;
     }
 
@@ -333,11 +674,119 @@ stse_ReturnCode_t stse_platform_ecc_generate_key_pair(
           STSE_CONF_ECC_CURVE_25519 || STSE_CONF_ECC_EDWARD_25519 */
 }
 
+#ifdef STSE_CONF_PLATFORM_ECC_KEY_POOL
+typedef struct {
+    PLAT_UI8 priv_key[STSE_PLATFORM_ECC_POOL_PRIV_KEY_SIZE];
+    PLAT_UI8 pub_key[STSE_PLATFORM_ECC_POOL_PUB_KEY_SIZE];
+} stse_platform_ecc_pool_slot_t;
+
+/* Key material kept in SRAM2 (parity checked, erased on tamper / option reset) */
+static stse_platform_ecc_pool_slot_t stse_platform_ecc_pool[STSE_PLATFORM_ECC_POOL_SIZE] __attribute__((section(".ram2")));
+static PLAT_UI32 stse_platform_ecc_pool_valid; /* Slot bitmap */
+static stse_platform_ecc_pool_stats_t stse_platform_ecc_pool_stats;
+
+stse_ReturnCode_t stse_platform_ecc_pool_refill(PLAT_UI8 max_keys) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 slot;
+
+    /* - Pool key type shall be an enabled curve fitting the slots */
+    if ((stse_platform_get_cmox_ecc_priv_key_len(STSE_PLATFORM_ECC_POOL_KEY_TYPE) == 0) ||
+        (stse_platform_get_cmox_ecc_priv_key_len(STSE_PLATFORM_ECC_POOL_KEY_TYPE) > STSE_PLATFORM_ECC_POOL_PRIV_KEY_SIZE) ||
+        (stse_platform_get_cmox_ecc_pub_key_len(STSE_PLATFORM_ECC_POOL_KEY_TYPE) > STSE_PLATFORM_ECC_POOL_PUB_KEY_SIZE)) {
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    for (slot = 0; (slot < STSE_PLATFORM_ECC_POOL_SIZE) && (max_keys > 0); slot++) {
+        if (stse_platform_ecc_pool_valid & (1UL << slot)) {
+            continue;
+        }
+        ret = stse_platform_ecc_compute_key_pair(&stse_platform_ecc_default_engine,
+                                                 STSE_PLATFORM_ECC_POOL_KEY_TYPE,
+                                                 stse_platform_ecc_pool[slot].priv_key,
+                                                 stse_platform_ecc_pool[slot].pub_key);
+        if (ret != STSE_OK) {
+            stse_platform_ecc_zeroize(&stse_platform_ecc_pool[slot], sizeof(stse_platform_ecc_pool_slot_t));
+            return ret;
+        }
+        stse_platform_ecc_pool_valid |= (1UL << slot);
+        stse_platform_ecc_pool_stats.refills++;
+        max_keys--;
+    }
+
+    return STSE_OK;
+}
+
+void stse_platform_ecc_pool_flush(void) {
+    stse_platform_ecc_zeroize(stse_platform_ecc_pool, sizeof(stse_platform_ecc_pool));
+    stse_platform_ecc_pool_valid = 0;
+}
+
+PLAT_UI8 stse_platform_ecc_pool_level(void) {
+    PLAT_UI8 level = 0;
+    PLAT_UI8 slot;
+
+    for (slot = 0; slot < STSE_PLATFORM_ECC_POOL_SIZE; slot++) {
+        level += (stse_platform_ecc_pool_valid >> slot) & 1U;
+    }
+
+    return level;
+}
+
+void stse_platform_ecc_pool_get_stats(stse_platform_ecc_pool_stats_t *pStats) {
+    *pStats = stse_platform_ecc_pool_stats;
+}
+
+static PLAT_UI8 stse_platform_ecc_pool_take(stse_ecc_key_type_t key_type, PLAT_UI8 *pPrivKey, PLAT_UI8 *pPubKey) {
+    PLAT_UI8 slot;
+
+    if (key_type != STSE_PLATFORM_ECC_POOL_KEY_TYPE) {
+        return 0;
+    }
+
+    for (slot = 0; slot < STSE_PLATFORM_ECC_POOL_SIZE; slot++) {
+        if (stse_platform_ecc_pool_valid & (1UL << slot)) {
+            /* - Hand out key pair and zeroize the slot */
+            memcpy(pPrivKey, stse_platform_ecc_pool[slot].priv_key, stse_platform_get_cmox_ecc_priv_key_len(key_type));
+            memcpy(pPubKey, stse_platform_ecc_pool[slot].pub_key, stse_platform_get_cmox_ecc_pub_key_len(key_type));
+            stse_platform_ecc_zeroize(&stse_platform_ecc_pool[slot], sizeof(stse_platform_ecc_pool_slot_t));
+            stse_platform_ecc_pool_valid &= ~(1UL << slot);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+#endif /* STSE_CONF_PLATFORM_ECC_KEY_POOL */
+
+stse_ReturnCode_t stse_platform_ecc_engine_generate_key_pair(
+    stse_platform_ecc_engine_t *pEngine,
+    stse_ecc_key_type_t key_type,
+    PLAT_UI8 *pPrivKey,
+    PLAT_UI8 *pPubKey) {
+#ifdef STSE_CONF_PLATFORM_ECC_KEY_POOL
+    if (stse_platform_ecc_pool_take(key_type, pPrivKey, pPubKey)) {
+        stse_platform_ecc_pool_stats.hits++;
+        return STSE_OK;
+    }
+    stse_platform_ecc_pool_stats.misses++;
+#endif /* STSE_CONF_PLATFORM_ECC_KEY_POOL */
+
+    return stse_platform_ecc_compute_key_pair(pEngine, key_type, pPrivKey, pPubKey);
+}
+
+stse_ReturnCode_t stse_platform_ecc_generate_key_pair(
+    stse_ecc_key_type_t key_type,
+    PLAT_UI8 *pPrivKey,
+    PLAT_UI8 *pPubKey) {
+    return stse_platform_ecc_engine_generate_key_pair(&stse_platform_ecc_default_engine, key_type, pPrivKey, pPubKey);
+}
+
 #if defined(STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED) || \
     defined(STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED) ||   \
     defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
 
-stse_ReturnCode_t stse_platform_ecc_sign(
+stse_ReturnCode_t stse_platform_ecc_engine_sign(
+    stse_platform_ecc_engine_t *pEngine,
     stse_ecc_key_type_t key_type,
     PLAT_UI8 *pPrivKey,
     PLAT_UI8 *pDigest,
@@ -352,17 +801,15 @@ stse_ReturnCode_t stse_platform_ecc_sign(
         return STSE_PLATFORM_INVALID_PARAMETER;
     }
 
-    /*- Set ECC context */
-    cmox_ecc_construct(&Ecc_Ctx,                /* ECC context */
-                       CMOX_MATH_FUNCS_SMALL,   /* Small math functions */
-                       cmox_math_buffer,        /* Crypto math buffer */
-                       sizeof(cmox_math_buffer) /* buffer size */
-    );
+    /*- Get ECC context */
+    if (!stse_platform_ecc_engine_prepare(pEngine)) {
+        return STSE_PLATFORM_ECC_SIGN_ERROR;
+    }
 
 #ifdef STSE_CONF_ECC_EDWARD_25519
     if (key_type == STSE_ECC_KT_ED25519) {
         /* - Perform EDDSA sign */
-        retval = cmox_eddsa_sign(&Ecc_Ctx,                                          /* ECC context */
+        retval = cmox_eddsa_sign(&pEngine->ctx,                                     /* ECC context */
                                  stse_platform_get_cmox_ecc_impl(key_type),         /* Curve param */
                                  pPrivKey,                                          /* Private key */
                                  stse_platform_get_cmox_ecc_priv_key_len(key_type), /* Private key length*/
@@ -377,13 +824,27 @@ stse_ReturnCode_t stse_platform_ecc_sign(
         do {
             /* - Generate a random number */
             size_t randomLength = stse_platform_get_cmox_ecc_priv_key_len(key_type) + (4 - (stse_platform_get_cmox_ecc_priv_key_len(key_type) & 0x3));
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+            PLAT_UI8 *randomNumber = stse_platform_arena_acquire(randomLength);
+            if (randomNumber == NULL) {
+                stse_platform_ecc_engine_release_secret(pEngine);
+                return STSE_PLATFORM_ECC_SIGN_ERROR;
+            }
+#else
             PLAT_UI8 randomNumber[randomLength];
-            for (uint8_t i = 0; i < randomLength; i += 4) {
-                *((PLAT_UI32 *)&randomNumber[i]) = stse_platform_generate_random();
+#endif
+            if (stse_platform_drbg_generate(STSE_PLATFORM_DRBG_NONCE, randomNumber, randomLength) != STSE_OK) {
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+                stse_platform_arena_release(randomNumber);
+#else
+                stse_platform_ecc_zeroize(randomNumber, randomLength);
+#endif
+                stse_platform_ecc_engine_release_secret(pEngine);
+                return STSE_PLATFORM_ECC_SIGN_ERROR;
             }
 
             /* - Perform ECDSA sign */
-            retval = cmox_ecdsa_sign(&Ecc_Ctx,                                  /* ECC context */
+            retval = cmox_ecdsa_sign(&pEngine->ctx,                             /* ECC context */
                                      stse_platform_get_cmox_ecc_impl(key_type), /* Curve param */
                                      randomNumber,
                                      stse_platform_get_cmox_ecc_priv_key_len(key_type),
@@ -394,13 +855,15 @@ stse_ReturnCode_t stse_platform_ecc_sign(
                                      pSignature,                                        /* Signature */
                                      NULL                                               /* Signature length */
             );
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+            stse_platform_arena_release(randomNumber);
+#else
+            stse_platform_ecc_zeroize(randomNumber, randomLength);
+#endif
         } while (retval == CMOX_ECC_ERR_WRONG_RANDOM);
     }
 
-    /* - Clear ECC context */
-    cmox_ecc_cleanup(&Ecc_Ctx);
-
-    if (retval != CMOX_ECC_SUCCESS) {
+    if ((stse_platform_ecc_engine_release_secret(pEngine) != STSE_OK) || (retval != CMOX_ECC_SUCCESS)) {
         return STSE_PLATFORM_ECC_SIGN_ERROR;
     }
 
@@ -411,6 +874,15 @@ stse_ReturnCode_t stse_platform_ecc_sign(
           STSE_CONF_ECC_BRAINPOOL_P_256 || STSE_CONF_ECC_BRAINPOOL_P_384 || STSE_CONF_ECC_BRAINPOOL_P_512 ||\
           STSE_CONF_ECC_CURVE_25519 || STSE_CONF_ECC_EDWARD_25519 */
 }
+
+stse_ReturnCode_t stse_platform_ecc_sign(
+    stse_ecc_key_type_t key_type,
+    PLAT_UI8 *pPrivKey,
+    PLAT_UI8 *pDigest,
+    PLAT_UI16 digestLen,
+    PLAT_UI8 *pSignature) {
+    return stse_platform_ecc_engine_sign(&stse_platform_ecc_default_engine, key_type, pPrivKey, pDigest, digestLen, pSignature);
+}
 #endif /* STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED || STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED ||
 			STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED */
 
@@ -422,21 +894,20 @@ stse_ReturnCode_t stse_platform_ecc_sign(
     defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED) ||          \
     defined(STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED_AUTHENTICATED)
 
-stse_ReturnCode_t stse_platform_ecc_ecdh(
+stse_ReturnCode_t stse_platform_ecc_engine_ecdh(
+    stse_platform_ecc_engine_t *pEngine,
     stse_ecc_key_type_t key_type,
     const PLAT_UI8 *pPubKey,
     const PLAT_UI8 *pPrivKey,
     PLAT_UI8 *pSharedSecret) {
     cmox_ecc_retval_t retval;
 
-    /*- Set ECC context */
-    cmox_ecc_construct(&Ecc_Ctx,                /* ECC context */
-                       CMOX_MATH_FUNCS_SMALL,   /* Small math functions */
-                       cmox_math_buffer,        /* Crypto math buffer */
-                       sizeof(cmox_math_buffer) /* buffer size */
-    );
+    /*- Get ECC context */
+    if (!stse_platform_ecc_engine_prepare(pEngine)) {
+        return STSE_PLATFORM_ECC_ECDH_ERROR;
+    }
 
-    retval = cmox_ecdh(&Ecc_Ctx,                                          /* ECC context */
+    retval = cmox_ecdh(&pEngine->ctx,                                     /* ECC context */
                        stse_platform_get_cmox_ecc_impl(key_type),         /* Curve param */
                        pPrivKey,                                          /* Private key (local) */
                        stse_platform_get_cmox_ecc_priv_key_len(key_type), /* Private key length*/
@@ -446,15 +917,20 @@ stse_ReturnCode_t stse_platform_ecc_ecdh(
                        NULL                                               /* Shared secret length */
     );
 
-    /* - Clear ECC context */
-    cmox_ecc_cleanup(&Ecc_Ctx);
-
-    if (retval != CMOX_ECC_SUCCESS) {
+    if ((stse_platform_ecc_engine_release_secret(pEngine) != STSE_OK) || (retval != CMOX_ECC_SUCCESS)) {
         return STSE_PLATFORM_ECC_ECDH_ERROR;
     }
 
     return STSE_OK;
 }
+
+stse_ReturnCode_t stse_platform_ecc_ecdh(
+    stse_ecc_key_type_t key_type,
+    const PLAT_UI8 *pPubKey,
+    const PLAT_UI8 *pPrivKey,
+    PLAT_UI8 *pSharedSecret) {
+    return stse_platform_ecc_engine_ecdh(&stse_platform_ecc_default_engine, key_type, pPubKey, pPrivKey, pSharedSecret);
+}
 #endif /* STSE_CONF_USE_HOST_KEY_ESTABLISHMENT) || STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED) ||
 			STSE_CONF_USE_HOST_KEY_PROVISIONING_WRAPPED_AUTHENTICATED || STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT) ||
 			STSE_CONF_USE_SYMMETRIC_KEY_ESTABLISHMENT_AUTHENTICATED || STSE_CONF_USE_SYMMETRIC_KEY_PROVISIONING_WRAPPED ||
@@ -0,0 +1,274 @@
+/******************************************************************************
+ * \file	stse_platform_ecc.h
+ * \brief   STSecureElement ECC platform file (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_PLATFORM_ECC_H
+#define STSE_PLATFORM_ECC_H
+
+#include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
+#include "core/stse_platform.h"
+#include "stse_conf.h"
+#include "stse_platform_arena.h"
+#include "stselib.h"
+
+/* ECC math buffer size (bytes), derived from the largest enabled STSE_CONF_ECC_*
+ * curve and the STSE_CONF_PLATFORM_ECC_FAST selection :
+ *
+ *  Largest enabled curve                    | LOWMEM + SMALL | HIGHMEM + FAST
+ *  -----------------------------------------+----------------+---------------
+ *  256-bit (P-256, BP-256, X25519, Ed25519) |      2400      |      4800
+ *  384-bit (P-384, BP-384)                  |      3200      |      6400
+ *  512/521-bit (BP-512, P-521)              |      4000      |      8000
+ *
+ * Cycle counts per operation are reported on the target by
+ * STSE_CONF_PLATFORM_BENCHMARK. Define STSE_PLATFORM_ECC_MATH_BUFFER_SIZE to
+ * override the derived size */
+#if defined(STSE_CONF_ECC_NIST_P_521) || defined(STSE_CONF_ECC_BRAINPOOL_P_512)
+#define STSE_PLATFORM_ECC_MATH_BUFFER_SMALL 4000U
+#define STSE_PLATFORM_ECC_MATH_BUFFER_FAST 8000U
+#elif defined(STSE_CONF_ECC_NIST_P_384) || defined(STSE_CONF_ECC_BRAINPOOL_P_384)
+#define STSE_PLATFORM_ECC_MATH_BUFFER_SMALL 3200U
+#define STSE_PLATFORM_ECC_MATH_BUFFER_FAST 6400U
+#else
+#define STSE_PLATFORM_ECC_MATH_BUFFER_SMALL 2400U
+#define STSE_PLATFORM_ECC_MATH_BUFFER_FAST 4800U
+#endif
+
+#ifndef STSE_PLATFORM_ECC_MATH_BUFFER_SIZE
+#ifdef STSE_CONF_PLATFORM_ECC_FAST
+#define STSE_PLATFORM_ECC_MATH_BUFFER_SIZE STSE_PLATFORM_ECC_MATH_BUFFER_FAST
+#else
+#define STSE_PLATFORM_ECC_MATH_BUFFER_SIZE STSE_PLATFORM_ECC_MATH_BUFFER_SMALL
+#endif
+#endif /* STSE_PLATFORM_ECC_MATH_BUFFER_SIZE */
+
+/* ECC engine : CMOX context and math buffer constructed once and reused across
+ * operations. Use one engine per concurrent user (task) ; the STSELib platform
+ * entry points share the default engine. Key generation, sign and ECDH clear the
+ * math buffer before returning (private key intermediates), verifications leave
+ * it as is.
+ * With STSE_CONF_PLATFORM_CRYPTO_ARENA the math buffer is borrowed from the crypto
+ * arena : engines are constructed for each operation (unless explicitly
+ * constructed with stse_platform_ecc_engine_init) */
+typedef struct {
+    cmox_ecc_handle_t ctx;
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+    PLAT_UI8 *pMath_buffer; /* Borrowed from the crypto arena */
+    PLAT_UI8 scoped;        /* Constructed for the current operation only */
+#else
+    PLAT_UI8 math_buffer[STSE_PLATFORM_ECC_MATH_BUFFER_SIZE] __attribute__((aligned(4)));
+#endif
+    PLAT_UI8 constructed;
+} stse_platform_ecc_engine_t;
+
+/*!
+ * \brief	Construct an ECC engine (optional : engines are constructed on first use)
+ * \details	With STSE_CONF_PLATFORM_CRYPTO_ARENA the engine holds its math buffer until
+ *          stse_platform_ecc_engine_deinit (count it in STSE_PLATFORM_ARENA_ECC_ENGINES) ;
+ *          the engine is left unconstructed if the arena is exhausted
+ * \param[in,out] pEngine	ECC engine
+ */
+void stse_platform_ecc_engine_init(stse_platform_ecc_engine_t *pEngine);
+
+/*!
+ * \brief	Release an ECC engine and clear its math buffer
+ * \details	With STSE_CONF_PLATFORM_CRYPTO_ARENA engines are released in reverse
+ *          construction order : an engine whose math buffer is not the last
+ *          arena block is left constructed
+ * \param[in,out] pEngine	ECC engine
+ * \result  STSE_OK on success ; STSE_PLATFORM_INVALID_PARAMETER if the engine math
+ *          buffer is not the last arena block (engine left constructed)
+ */
+stse_ReturnCode_t stse_platform_ecc_engine_deinit(stse_platform_ecc_engine_t *pEngine);
+
+/*!
+ * \brief	Get the engine used by the STSELib platform entry points
+ */
+stse_platform_ecc_engine_t *stse_platform_ecc_get_default_engine(void);
+
+/*!
+ * \brief	Get the signature length of a key type
+ * \param[in] key_type	ECC key type
+ * \result  Signature length in bytes ; 0 if the key type is not enabled or has no signature scheme
+ */
+size_t stse_platform_get_cmox_ecc_sig_len(stse_ecc_key_type_t key_type);
+
+/* Batch verification item */
+typedef struct {
+    stse_ecc_key_type_t key_type;
+    const PLAT_UI8 *pPubKey;
+    PLAT_UI8 *pDigest;
+    PLAT_UI16 digestLen;
+    PLAT_UI8 *pSignature;
+    stse_ReturnCode_t result; /* Set by the batch verification */
+} stse_platform_ecc_verify_item_t;
+
+/*!
+ * \brief	Verify a set of signatures
+ * \details	Items are verified one after the other on the engine ; each item
+ *          result is reported. No batch verification speedup : CMOX verifies
+ *          one signature per call (Ed25519 included) and the engine context
+ *          does not depend on the curve, so items are not grouped by curve
+ * \param[in,out] pEngine	ECC engine
+ * \param[in,out] pItems	Verification items (result field updated for each item)
+ * \param[in] item_count	Number of items
+ * \result  STSE_OK if all signatures are valid ; STSE_PLATFORM_ECC_VERIFY_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_ecc_engine_verify_batch(stse_platform_ecc_engine_t *pEngine,
+                                                        stse_platform_ecc_verify_item_t *pItems,
+                                                        PLAT_UI16 item_count);
+
+/*!
+ * \brief	Verify a set of signatures with the default engine
+ */
+stse_ReturnCode_t stse_platform_ecc_verify_batch(stse_platform_ecc_verify_item_t *pItems,
+                                                 PLAT_UI16 item_count);
+
+stse_ReturnCode_t stse_platform_ecc_engine_verify(stse_platform_ecc_engine_t *pEngine,
+                                                  stse_ecc_key_type_t key_type,
+                                                  const PLAT_UI8 *pPubKey,
+                                                  PLAT_UI8 *pDigest,
+                                                  PLAT_UI16 digestLen,
+                                                  PLAT_UI8 *pSignature);
+
+stse_ReturnCode_t stse_platform_ecc_engine_sign(stse_platform_ecc_engine_t *pEngine,
+                                                stse_ecc_key_type_t key_type,
+                                                PLAT_UI8 *pPrivKey,
+                                                PLAT_UI8 *pDigest,
+                                                PLAT_UI16 digestLen,
+                                                PLAT_UI8 *pSignature);
+
+stse_ReturnCode_t stse_platform_ecc_engine_ecdh(stse_platform_ecc_engine_t *pEngine,
+                                                stse_ecc_key_type_t key_type,
+                                                const PLAT_UI8 *pPubKey,
+                                                const PLAT_UI8 *pPrivKey,
+                                                PLAT_UI8 *pSharedSecret);
+
+stse_ReturnCode_t stse_platform_ecc_engine_generate_key_pair(stse_platform_ecc_engine_t *pEngine,
+                                                             stse_ecc_key_type_t key_type,
+                                                             PLAT_UI8 *pPrivKey,
+                                                             PLAT_UI8 *pPubKey);
+
+/* Ephemeral key pool (STSE_CONF_PLATFORM_ECC_KEY_POOL in stse_conf.h) : key pairs of
+ * STSE_PLATFORM_ECC_POOL_KEY_TYPE are generated ahead of time by
+ * stse_platform_ecc_pool_refill() (idle time) into SRAM2 and handed out by
+ * stse_platform_ecc_generate_key_pair(). Slots are zeroized at crypto init and
+ * once taken. The pool key type defaults to the first enabled curve */
+
+#define STSE_PLATFORM_ECC_POOL_SIZE 4U
+#ifndef STSE_PLATFORM_ECC_POOL_KEY_TYPE
+#if defined(STSE_CONF_ECC_NIST_P_256)
+#define STSE_PLATFORM_ECC_POOL_KEY_TYPE STSE_ECC_KT_NIST_P_256
+#elif defined(STSE_CONF_ECC_NIST_P_384)
+#define STSE_PLATFORM_ECC_POOL_KEY_TYPE STSE_ECC_KT_NIST_P_384
+#elif defined(STSE_CONF_ECC_NIST_P_521)
+#define STSE_PLATFORM_ECC_POOL_KEY_TYPE STSE_ECC_KT_NIST_P_521
+#elif defined(STSE_CONF_ECC_BRAINPOOL_P_256)
+#define STSE_PLATFORM_ECC_POOL_KEY_TYPE STSE_ECC_KT_BP_P_256
+#elif defined(STSE_CONF_ECC_BRAINPOOL_P_384)
+#define STSE_PLATFORM_ECC_POOL_KEY_TYPE STSE_ECC_KT_BP_P_384
+#elif defined(STSE_CONF_ECC_BRAINPOOL_P_512)
+#define STSE_PLATFORM_ECC_POOL_KEY_TYPE STSE_ECC_KT_BP_P_512
+#elif defined(STSE_CONF_ECC_CURVE_25519)
+#define STSE_PLATFORM_ECC_POOL_KEY_TYPE STSE_ECC_KT_CURVE25519
+#elif defined(STSE_CONF_ECC_EDWARD_25519)
+#define STSE_PLATFORM_ECC_POOL_KEY_TYPE STSE_ECC_KT_ED25519
+#elif defined(STSE_CONF_PLATFORM_ECC_KEY_POOL)
+#error "STSE_CONF_PLATFORM_ECC_KEY_POOL requires an enabled STSE_CONF_ECC_* curve"
+#endif
+#endif /* STSE_PLATFORM_ECC_POOL_KEY_TYPE */
+#define STSE_PLATFORM_ECC_POOL_PRIV_KEY_SIZE 66U  /* NIST P-521 */
+#define STSE_PLATFORM_ECC_POOL_PUB_KEY_SIZE 132U  /* NIST P-521 */
+
+typedef struct {
+    PLAT_UI32 hits;    /* Key pairs served from the pool */
+    PLAT_UI32 misses;  /* Key pairs generated on request */
+    PLAT_UI32 refills; /* Key pairs generated in idle time */
+} stse_platform_ecc_pool_stats_t;
+
+/*!
+ * \brief	Generate key pairs in the empty pool slots
+ * \param[in] max_keys	Maximum number of key pairs to generate in this call
+ * \result  STSE_OK on success ; stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_ecc_pool_refill(PLAT_UI8 max_keys);
+
+/*!
+ * \brief	Zeroize all pool slots (called by stse_platform_crypto_init : SRAM2 is not initialized)
+ */
+void stse_platform_ecc_pool_flush(void);
+
+/*!
+ * \brief	Report number of key pairs available in the pool
+ */
+PLAT_UI8 stse_platform_ecc_pool_level(void);
+
+/*!
+ * \brief	Report pool statistics
+ * \param[out] pStats	Pool statistics
+ */
+void stse_platform_ecc_pool_get_stats(stse_platform_ecc_pool_stats_t *pStats);
+
+/* Verified signature cache (STSE_CONF_PLATFORM_ECC_VERIFY_CACHE in stse_conf.h) :
+ * positive stse_platform_ecc_verify results are kept in a bounded LRU table keyed
+ * by SHA-256(key type | public key | digest | signature). Repeated verifications
+ * of the same material skip the ECC computation. Entries expire after STSE_PLATFORM_ECC_VERIFY_CACHE_MAX_AGE time units (see
+ * stse_platform_ecc_verify_cache_get_time). The cache can be used from several
+ * tasks : table accesses run with interrupts masked, the key is hashed outside */
+
+#define STSE_PLATFORM_ECC_VERIFY_CACHE_SIZE 8U
+#define STSE_PLATFORM_ECC_VERIFY_CACHE_MAX_AGE 1000U
+
+typedef struct {
+    PLAT_UI32 hits;        /* Verifications served from the cache */
+    PLAT_UI32 misses;      /* Verifications computed */
+    PLAT_UI32 evictions;   /* Least recently used entries replaced */
+    PLAT_UI32 expirations; /* Entries dropped on max age */
+} stse_platform_ecc_verify_cache_stats_t;
+
+/*!
+ * \brief	Cache time base (weak : defaults to the number of verify requests)
+ * \details	Called with interrupts masked : overrides shall be short (e.g. HAL_GetTick)
+ * \result  Current time in STSE_PLATFORM_ECC_VERIFY_CACHE_MAX_AGE units
+ */
+PLAT_UI32 stse_platform_ecc_verify_cache_get_time(void);
+
+/*!
+ * \brief	Drop all cached verification results
+ */
+void stse_platform_ecc_verify_cache_invalidate(void);
+
+/*!
+ * \brief	Drop the cached verification result of a signature
+ * \param[in] key_type		ECC key type
+ * \param[in] pPubKey		Public key
+ * \param[in] pDigest		Message digest
+ * \param[in] digestLen		Message digest length
+ * \param[in] pSignature	Signature
+ */
+void stse_platform_ecc_verify_cache_invalidate_entry(stse_ecc_key_type_t key_type,
+                                                     const PLAT_UI8 *pPubKey,
+                                                     PLAT_UI8 *pDigest,
+                                                     PLAT_UI16 digestLen,
+                                                     PLAT_UI8 *pSignature);
+
+/*!
+ * \brief	Report verify cache statistics
+ * \param[out] pStats	Cache statistics
+ */
+void stse_platform_ecc_verify_cache_get_stats(stse_platform_ecc_verify_cache_stats_t *pStats);
+
+#endif /* STSE_PLATFORM_ECC_H */
@@ -15,9 +15,9 @@
  ******************************************************************************
  */
 
-#include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
-#include "stse_conf.h"
-#include "stselib.h"
+#include "stse_platform_arena.h"
+#include "stse_platform_hash.h"
+#include <stddef.h>
 
 static cmox_hash_algo_t stse_platform_get_cmox_hash_algo(stse_hash_algorithm_t hash_algo) {
     switch (hash_algo) {
@@ -89,6 +89,127 @@ stse_ReturnCode_t stse_platform_hash_compute(stse_hash_algorithm_t hash_algo,
           STSE_CONF_HASH_SHA_3_256 || STSE_CONF_HASH_SHA_3_284 || STSE_CONF_HASH_SHA_3_512 */
 }
 
+stse_ReturnCode_t stse_platform_hash_stream_init(stse_platform_hash_stream_t *pStream,
+                                                 stse_hash_algorithm_t hash_algo) {
+    if (pStream == NULL) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+
+    /*- Construct hash handle */
+    switch (hash_algo) {
+#ifdef STSE_CONF_HASH_SHA_1
+    case STSE_SHA_1:
+        pStream->pHash = cmox_sha1_construct(&pStream->handle.sha1);
+        pStream->digest_length = CMOX_SHA1_SIZE;
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_224
+    case STSE_SHA_224:
+        pStream->pHash = cmox_sha224_construct(&pStream->handle.sha256);
+        pStream->digest_length = CMOX_SHA224_SIZE;
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_256
+    case STSE_SHA_256:
+        pStream->pHash = cmox_sha256_construct(&pStream->handle.sha256);
+        pStream->digest_length = CMOX_SHA256_SIZE;
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_384
+    case STSE_SHA_384:
+        pStream->pHash = cmox_sha384_construct(&pStream->handle.sha512);
+        pStream->digest_length = CMOX_SHA384_SIZE;
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_512
+    case STSE_SHA_512:
+        pStream->pHash = cmox_sha512_construct(&pStream->handle.sha512);
+        pStream->digest_length = CMOX_SHA512_SIZE;
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_256
+    case STSE_SHA3_256:
+        pStream->pHash = cmox_sha3_256_construct(&pStream->handle.sha3);
+        pStream->digest_length = CMOX_SHA3_256_SIZE;
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_384
+    case STSE_SHA3_384:
+        pStream->pHash = cmox_sha3_384_construct(&pStream->handle.sha3);
+        pStream->digest_length = CMOX_SHA3_384_SIZE;
+        break;
+#endif
+#ifdef STSE_CONF_HASH_SHA_3_512
+    case STSE_SHA3_512:
+        pStream->pHash = cmox_sha3_512_construct(&pStream->handle.sha3);
+        pStream->digest_length = CMOX_SHA3_512_SIZE;
+        break;
+#endif
+    default:
+        pStream->pHash = NULL;
+        break;
+    }
+
+    if (pStream->pHash == NULL) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+
+    /*- Initialize hash computation */
+    if (cmox_hash_init(pStream->pHash) != CMOX_HASH_SUCCESS ||
+        cmox_hash_setTagLen(pStream->pHash, pStream->digest_length) != CMOX_HASH_SUCCESS) {
+        cmox_hash_cleanup(pStream->pHash);
+        pStream->pHash = NULL;
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_hash_stream_append(stse_platform_hash_stream_t *pStream,
+                                                   const PLAT_UI8 *pChunk, PLAT_UI16 chunk_length) {
+    if (pStream == NULL || pStream->pHash == NULL) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+
+    if (chunk_length == 0) {
+        return STSE_OK;
+    }
+
+    if (cmox_hash_append(pStream->pHash, pChunk, chunk_length) != CMOX_HASH_SUCCESS) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_hash_stream_finish(stse_platform_hash_stream_t *pStream,
+                                                   PLAT_UI8 *pHash, PLAT_UI16 *hash_length) {
+    cmox_hash_retval_t retval;
+    size_t cmox_hash_length = 0;
+
+    if (pStream == NULL || pStream->pHash == NULL) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+
+    if (*hash_length < pStream->digest_length) {
+        retval = CMOX_HASH_ERR_BAD_PARAMETER;
+    } else {
+        retval = cmox_hash_generateTag(pStream->pHash, pHash, &cmox_hash_length);
+    }
+
+    cmox_hash_cleanup(pStream->pHash);
+    pStream->pHash = NULL;
+
+    /*- Verify Hash compute return */
+    if (retval != CMOX_HASH_SUCCESS || cmox_hash_length != pStream->digest_length) {
+        return STSE_PLATFORM_HASH_ERROR;
+    }
+
+    *hash_length = (PLAT_UI16)cmox_hash_length;
+
+    return STSE_OK;
+}
+
 stse_ReturnCode_t stse_platform_hmac_sha256_extract(PLAT_UI8 *pSalt, PLAT_UI16 salt_length,
                                                     PLAT_UI8 *pInput_keying_material, PLAT_UI16 input_keying_material_length,
                                                     PLAT_UI8 *pPseudorandom_key, PLAT_UI16 pseudorandom_key_expected_length) {
@@ -115,18 +236,148 @@ stse_ReturnCode_t stse_platform_hmac_sha256_extract(PLAT_UI8 *pSalt, PLAT_UI16 s
     return STSE_OK;
 }
 
+/* CMOX has no hash handle clone service : the HMAC midstates are snapshot and
+ * restored by copying whole cmox_sha256_handle_t objects, which relies on the
+ * handle being a plain value object whose generic handle is its first member
+ * (tested with X-CUBE-CRYPTOLIB v4.5.0, see Middleware/STM32_Cryptographic/ReadMe.md).
+ * Snapshots are only ever restored into the handle they were taken from, so
+ * pointers the handle may keep to itself stay valid. Check this layout again when
+ * moving to another CMOX release */
+_Static_assert(offsetof(cmox_sha256_handle_t, super) == 0U,
+               "HMAC-SHA256 midstates copy whole CMOX SHA-256 handles");
+
+stse_ReturnCode_t stse_platform_hmac_sha256_midstate_init(stse_platform_hmac_sha256_midstate_t *pMidstate,
+                                                          const PLAT_UI8 *pKey, PLAT_UI16 key_length) {
+    PLAT_UI8 block[STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE];
+    size_t hashed_key_length = CMOX_SHA256_SIZE;
+    PLAT_UI8 i;
+
+    if (pMidstate == NULL || (pKey == NULL && key_length != 0)) {
+        return STSE_PLATFORM_HKDF_ERROR;
+    }
+    memset(pMidstate, 0, sizeof(stse_platform_hmac_sha256_midstate_t));
+
+    /* - Block sized key : K padded with zeros, or H(K) if longer than a block */
+    memset(block, 0, sizeof(block));
+    if (key_length > STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE) {
+        if (cmox_hash_compute(CMOX_SHA256_ALGO, pKey, key_length,
+                              block, CMOX_SHA256_SIZE, &hashed_key_length) != CMOX_HASH_SUCCESS) {
+            return STSE_PLATFORM_HKDF_ERROR;
+        }
+    } else if (key_length != 0) {
+        memcpy(block, pKey, key_length);
+    }
+
+    /* - Generic handles embedded in the copied objects (see the layout check above) */
+    pMidstate->pInner = cmox_sha256_construct(&pMidstate->inner);
+    pMidstate->pOuter = cmox_sha256_construct(&pMidstate->outer);
+    if (pMidstate->pInner != &pMidstate->inner.super || pMidstate->pOuter != &pMidstate->outer.super) {
+        memset(block, 0, sizeof(block));
+        return STSE_PLATFORM_HKDF_ERROR;
+    }
+
+    /* - Absorb K ^ ipad in the inner hash */
+    for (i = 0; i < STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE; i++) {
+        block[i] ^= 0x36;
+    }
+    if (cmox_hash_init(pMidstate->pInner) != CMOX_HASH_SUCCESS ||
+        cmox_hash_setTagLen(pMidstate->pInner, CMOX_SHA256_SIZE) != CMOX_HASH_SUCCESS ||
+        cmox_hash_append(pMidstate->pInner, block, sizeof(block)) != CMOX_HASH_SUCCESS) {
+        memset(block, 0, sizeof(block));
+        stse_platform_hmac_sha256_midstate_clear(pMidstate);
+        return STSE_PLATFORM_HKDF_ERROR;
+    }
+
+    /* - Absorb K ^ opad in the outer hash */
+    for (i = 0; i < STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE; i++) {
+        block[i] ^= 0x36 ^ 0x5C;
+    }
+    if (cmox_hash_init(pMidstate->pOuter) != CMOX_HASH_SUCCESS ||
+        cmox_hash_setTagLen(pMidstate->pOuter, CMOX_SHA256_SIZE) != CMOX_HASH_SUCCESS ||
+        cmox_hash_append(pMidstate->pOuter, block, sizeof(block)) != CMOX_HASH_SUCCESS) {
+        memset(block, 0, sizeof(block));
+        stse_platform_hmac_sha256_midstate_clear(pMidstate);
+        return STSE_PLATFORM_HKDF_ERROR;
+    }
+    memset(block, 0, sizeof(block));
+
+    /* - Snapshot both states */
+    memcpy(&pMidstate->inner_midstate, &pMidstate->inner, sizeof(cmox_sha256_handle_t));
+    memcpy(&pMidstate->outer_midstate, &pMidstate->outer, sizeof(cmox_sha256_handle_t));
+
+    return STSE_OK;
+}
+
+void stse_platform_hmac_sha256_midstate_clear(stse_platform_hmac_sha256_midstate_t *pMidstate) {
+    if (pMidstate == NULL) {
+        return;
+    }
+    if (pMidstate->pInner != NULL) {
+        cmox_hash_cleanup(pMidstate->pInner);
+    }
+    if (pMidstate->pOuter != NULL) {
+        cmox_hash_cleanup(pMidstate->pOuter);
+    }
+    memset(pMidstate, 0, sizeof(stse_platform_hmac_sha256_midstate_t));
+}
+
+static stse_ReturnCode_t stse_platform_hmac_sha256_midstate_mac(stse_platform_hmac_sha256_midstate_t *pMidstate,
+                                                                const PLAT_UI8 *pMessage1, PLAT_UI16 message1_length,
+                                                                const PLAT_UI8 *pMessage2, PLAT_UI16 message2_length,
+                                                                const PLAT_UI8 *pMessage3, PLAT_UI16 message3_length,
+                                                                PLAT_UI8 *pMac) {
+    PLAT_UI8 inner_digest[CMOX_SHA256_SIZE];
+    size_t digest_length = 0;
+    cmox_hash_retval_t retval = CMOX_HASH_SUCCESS;
+
+    /* - Inner hash : H((K ^ ipad) || message) restarted from the inner midstate */
+    memcpy(&pMidstate->inner, &pMidstate->inner_midstate, sizeof(cmox_sha256_handle_t));
+    if (message1_length != 0) {
+        retval = cmox_hash_append(pMidstate->pInner, pMessage1, message1_length);
+    }
+    if (retval == CMOX_HASH_SUCCESS && message2_length != 0) {
+        retval = cmox_hash_append(pMidstate->pInner, pMessage2, message2_length);
+    }
+    if (retval == CMOX_HASH_SUCCESS && message3_length != 0) {
+        retval = cmox_hash_append(pMidstate->pInner, pMessage3, message3_length);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_generateTag(pMidstate->pInner, inner_digest, &digest_length);
+    }
+
+    /* - Outer hash : H((K ^ opad) || inner digest) restarted from the outer midstate */
+    if (retval == CMOX_HASH_SUCCESS) {
+        memcpy(&pMidstate->outer, &pMidstate->outer_midstate, sizeof(cmox_sha256_handle_t));
+        retval = cmox_hash_append(pMidstate->pOuter, inner_digest, CMOX_SHA256_SIZE);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_generateTag(pMidstate->pOuter, pMac, &digest_length);
+    }
+    memset(inner_digest, 0, CMOX_SHA256_SIZE);
+
+    if (retval != CMOX_HASH_SUCCESS || digest_length != CMOX_SHA256_SIZE) {
+        return STSE_PLATFORM_HKDF_ERROR;
+    }
+
+    return STSE_OK;
+}
+
 stse_ReturnCode_t stse_platform_hmac_sha256_expand(PLAT_UI8 *pPseudorandom_key, PLAT_UI16 pseudorandom_key_length,
                                                    PLAT_UI8 *pInfo, PLAT_UI16 info_length,
                                                    PLAT_UI8 *pOutput_keying_material, PLAT_UI16 output_keying_material_length) {
-    cmox_mac_retval_t retval;
+    stse_ReturnCode_t ret;
 
     PLAT_UI8 tmp[CMOX_SHA256_SIZE];
     PLAT_UI16 tmp_length = 0;
     PLAT_UI16 out_index = 0;
     PLAT_UI8 n = 0x1;
 
-    cmox_mac_handle_t *pMac_handle;
-    cmox_hmac_handle_t hmac_handle;
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+    stse_platform_hmac_sha256_midstate_t *pMidstate;
+#else
+    stse_platform_hmac_sha256_midstate_t midstate;
+    stse_platform_hmac_sha256_midstate_t *pMidstate = &midstate;
+#endif
 
     /*	RFC 5869 : output keying material must be
 	 * 		- L <= 255*HashLen
@@ -135,30 +386,22 @@ stse_ReturnCode_t stse_platform_hmac_sha256_expand(PLAT_UI8 *pPseudorandom_key,
         return STSE_PLATFORM_HKDF_ERROR;
     }
 
-    pMac_handle = cmox_hmac_construct(&hmac_handle, CMOX_HMAC_SHA256);
-    retval = cmox_mac_init(pMac_handle);
-
-    if (retval != CMOX_MAC_SUCCESS) {
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+    pMidstate = stse_platform_arena_acquire(sizeof(stse_platform_hmac_sha256_midstate_t));
+    if (pMidstate == NULL) {
         return STSE_PLATFORM_HKDF_ERROR;
     }
+#endif
+
+    /* - Derive the PRK pads once for all output blocks */
+    ret = stse_platform_hmac_sha256_midstate_init(pMidstate, pPseudorandom_key, pseudorandom_key_length);
 
-    while (out_index < output_keying_material_length) {
+    /* - T(n) = HMAC-Hash(PRK, T(n-1) | info | n) */
+    while (ret == STSE_OK && out_index < output_keying_material_length) {
         PLAT_UI16 left = output_keying_material_length - out_index;
 
-        retval = cmox_mac_setKey(pMac_handle, pPseudorandom_key, pseudorandom_key_length);
-        if (retval != CMOX_MAC_SUCCESS)
-            break;
-        retval = cmox_mac_append(pMac_handle, tmp, tmp_length);
-        if (retval != CMOX_MAC_SUCCESS)
-            break;
-        retval = cmox_mac_append(pMac_handle, pInfo, info_length);
-        if (retval != CMOX_MAC_SUCCESS)
-            break;
-        retval = cmox_mac_append(pMac_handle, &n, 1);
-        if (retval != CMOX_MAC_SUCCESS)
-            break;
-        retval = cmox_mac_generateTag(pMac_handle, tmp, NULL);
-        if (retval != CMOX_MAC_SUCCESS)
+        ret = stse_platform_hmac_sha256_midstate_mac(pMidstate, tmp, tmp_length, pInfo, info_length, &n, 1, tmp);
+        if (ret != STSE_OK)
             break;
 
         left = left < CMOX_SHA256_SIZE ? left : CMOX_SHA256_SIZE;
@@ -169,14 +412,40 @@ stse_ReturnCode_t stse_platform_hmac_sha256_expand(PLAT_UI8 *pPseudorandom_key,
         n++;
     }
 
-    cmox_mac_cleanup(pMac_handle);
+    stse_platform_hmac_sha256_midstate_clear(pMidstate);
+#ifdef STSE_CONF_PLATFORM_CRYPTO_ARENA
+    stse_platform_arena_release(pMidstate);
+#endif
+    memset(tmp, 0, CMOX_SHA256_SIZE);
 
     /*- Verify MAC compute return */
-    if (retval != CMOX_MAC_SUCCESS) {
-        memset(tmp, 0, CMOX_SHA256_SIZE);
+    if (ret != STSE_OK) {
         memset(pOutput_keying_material, 0, output_keying_material_length);
         return STSE_PLATFORM_HKDF_ERROR;
     }
 
     return STSE_OK;
 }
+
+stse_ReturnCode_t stse_platform_hmac_sha256_extract_expand(PLAT_UI8 *pSalt, PLAT_UI16 salt_length,
+                                                           PLAT_UI8 *pInput_keying_material, PLAT_UI16 input_keying_material_length,
+                                                           PLAT_UI8 *pInfo, PLAT_UI16 info_length,
+                                                           PLAT_UI8 *pOutput_keying_material, PLAT_UI16 output_keying_material_length) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 pseudorandom_key[CMOX_SHA256_SIZE];
+
+    /* - PRK = HMAC-Hash(salt, IKM) */
+    ret = stse_platform_hmac_sha256_extract(pSalt, salt_length,
+                                            pInput_keying_material, input_keying_material_length,
+                                            pseudorandom_key, CMOX_SHA256_SIZE);
+
+    /* - OKM = T(1) | T(2) | ... */
+    if (ret == STSE_OK) {
+        ret = stse_platform_hmac_sha256_expand(pseudorandom_key, CMOX_SHA256_SIZE,
+                                               pInfo, info_length,
+                                               pOutput_keying_material, output_keying_material_length);
+    }
+    memset(pseudorandom_key, 0, CMOX_SHA256_SIZE);
+
+    return ret;
+}
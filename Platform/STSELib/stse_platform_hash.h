@@ -0,0 +1,111 @@
+/******************************************************************************
+ * \file	stse_platform_hash.h
+ * \brief   STSecureElement HASH platform file (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_PLATFORM_HASH_H
+#define STSE_PLATFORM_HASH_H
+
+#include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
+#include "core/stse_platform.h"
+#include "stse_conf.h"
+#include "stselib.h"
+
+/* Incremental hash context : the message is appended in any number of chunks
+ * (e.g. as a frame is received) and the digest is produced by
+ * stse_platform_hash_stream_finish */
+typedef struct {
+    union {
+        cmox_sha1_handle_t sha1;
+        cmox_sha256_handle_t sha256;
+        cmox_sha512_handle_t sha512;
+        cmox_sha3_handle_t sha3;
+    } handle;
+    cmox_hash_handle_t *pHash;
+    PLAT_UI16 digest_length;
+} stse_platform_hash_stream_t;
+
+/*!
+ * \brief	Start an incremental hash computation
+ * \param[out] pStream		Hash stream context
+ * \param[in] hash_algo		Hash algorithm
+ * \result  STSE_OK on success ; STSE_PLATFORM_HASH_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_hash_stream_init(stse_platform_hash_stream_t *pStream,
+                                                 stse_hash_algorithm_t hash_algo);
+
+/*!
+ * \brief	Append a message chunk to an incremental hash computation
+ * \param[in,out] pStream	Hash stream context
+ * \param[in] pChunk		Message chunk
+ * \param[in] chunk_length	Message chunk length
+ * \result  STSE_OK on success ; STSE_PLATFORM_HASH_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_hash_stream_append(stse_platform_hash_stream_t *pStream,
+                                                   const PLAT_UI8 *pChunk, PLAT_UI16 chunk_length);
+
+/*!
+ * \brief	Produce the digest and release the hash stream context
+ * \param[in,out] pStream	Hash stream context
+ * \param[out] pHash		Digest buffer
+ * \param[in,out] hash_length	Digest buffer size in ; digest length out
+ * \result  STSE_OK on success ; STSE_PLATFORM_HASH_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_hash_stream_finish(stse_platform_hash_stream_t *pStream,
+                                                   PLAT_UI8 *pHash, PLAT_UI16 *hash_length);
+
+#define STSE_PLATFORM_HMAC_SHA256_BLOCK_SIZE 64U
+
+/* HMAC-SHA256 midstates : SHA-256 states after absorbing the (K ^ ipad) and
+ * (K ^ opad) blocks, computed once per key. Each MAC restores the snapshots
+ * into the working handles instead of re-deriving the pads (HKDF expand runs
+ * one MAC per 32-byte output block with the same PRK) */
+typedef struct {
+    cmox_sha256_handle_t inner;          /* Working inner hash */
+    cmox_sha256_handle_t outer;          /* Working outer hash */
+    cmox_sha256_handle_t inner_midstate; /* Inner hash state after K ^ ipad (restored in place) */
+    cmox_sha256_handle_t outer_midstate; /* Outer hash state after K ^ opad (restored in place) */
+    cmox_hash_handle_t *pInner;
+    cmox_hash_handle_t *pOuter;
+} stse_platform_hmac_sha256_midstate_t;
+
+/*!
+ * \brief	Compute the HMAC-SHA256 inner and outer midstates of a key
+ * \param[out] pMidstate	HMAC-SHA256 midstate context
+ * \param[in] pKey			HMAC key
+ * \param[in] key_length	HMAC key length
+ * \result  STSE_OK on success ; STSE_PLATFORM_HKDF_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_hmac_sha256_midstate_init(stse_platform_hmac_sha256_midstate_t *pMidstate,
+                                                          const PLAT_UI8 *pKey, PLAT_UI16 key_length);
+
+/*!
+ * \brief	Release an HMAC-SHA256 midstate context and zeroize the key material
+ * \param[in,out] pMidstate	HMAC-SHA256 midstate context
+ */
+void stse_platform_hmac_sha256_midstate_clear(stse_platform_hmac_sha256_midstate_t *pMidstate);
+
+/*!
+ * \brief	HKDF-SHA256 (RFC 5869) extract and expand in a single call
+ * \details	The pseudorandom key is kept in a local buffer (zeroized on exit)
+ *          instead of being returned to the caller between both steps
+ * \result  STSE_OK on success ; STSE_PLATFORM_HKDF_ERROR otherwise
+ */
+stse_ReturnCode_t stse_platform_hmac_sha256_extract_expand(PLAT_UI8 *pSalt, PLAT_UI16 salt_length,
+                                                           PLAT_UI8 *pInput_keying_material, PLAT_UI16 input_keying_material_length,
+                                                           PLAT_UI8 *pInfo, PLAT_UI16 info_length,
+                                                           PLAT_UI8 *pOutput_keying_material, PLAT_UI16 output_keying_material_length);
+
+#endif /* STSE_PLATFORM_HASH_H */
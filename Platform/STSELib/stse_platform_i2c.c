@@ -17,6 +17,8 @@
 
 #include "core/stse_platform.h"
 #include "drivers/i2c/I2C.h"
+#include "stse_platform_crc.h"
+#include "stse_platform_i2c.h"
 #include <stdlib.h>
 
 //#define STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
@@ -29,6 +31,200 @@ static PLAT_UI8 I2c_buffer[755U]; // Set to A120 max input buffer size + 2 bytes
 static PLAT_UI16 i2c_frame_size;
 static volatile PLAT_UI16 i2c_frame_offset;
 
+#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+#define STSE_PLATFORM_I2C_BUFFER pI2c_buffer
+#else
+#define STSE_PLATFORM_I2C_BUFFER I2c_buffer
+#endif
+
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE) || defined(STSE_CONF_PLATFORM_I2C_RECEIVE_CRC)
+/* Response frame : header[1] | length[2] | payload | CRC[2] (MSB first),
+ * the CRC covers header and payload */
+#define STSE_PLATFORM_I2C_RSP_HEADER_SIZE 1U
+#define STSE_PLATFORM_I2C_RSP_LENGTH_SIZE 2U
+#define STSE_PLATFORM_I2C_RSP_CRC_SIZE 2U
+#define STSE_PLATFORM_I2C_RSP_MIN_SIZE \
+    (STSE_PLATFORM_I2C_RSP_HEADER_SIZE + STSE_PLATFORM_I2C_RSP_LENGTH_SIZE + STSE_PLATFORM_I2C_RSP_CRC_SIZE)
+
+static crc16_ctx_t i2c_crc_ctx;
+static PLAT_UI8 i2c_crc_check;
+static PLAT_UI8 i2c_crc_fault;
+static PLAT_UI8 *pI2c_crc_header;
+#ifdef STSE_CONF_PLATFORM_I2C_RECEIVE_CRC
+static i2c_crc_window_t i2c_crc_window;
+static i2c_crc_window_t *pI2c_crc_window;
+#endif
+
+static stse_ReturnCode_t _stse_platform_i2c_crc_verify(void) {
+    PLAT_UI8 *pCrc = STSE_PLATFORM_I2C_BUFFER + i2c_frame_size - STSE_PLATFORM_I2C_RSP_CRC_SIZE;
+    PLAT_UI16 crc = crc16_ctx_final(&i2c_crc_ctx);
+
+    /* - Compare accumulated CRC with the received CRC field */
+    if (i2c_crc_fault || (pCrc[0] != (PLAT_UI8)(crc >> 8)) || (pCrc[1] != (PLAT_UI8)crc)) {
+        return STSE_CORE_FRAME_CRC_ERROR;
+    }
+
+    /* - Core CRC pass over the received elements skipped */
+    stse_platform_crc16_receive_verified(pI2c_crc_header, crc);
+
+    return STSE_OK;
+}
+#endif
+
+#ifdef STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE
+static PLAT_UI16 _stse_platform_i2c_crc_run(PLAT_UI16 offset, PLAT_UI16 length, PLAT_UI8 *pCovered) {
+    PLAT_UI16 boundary;
+
+    /* - Number of bytes from offset sharing the same CRC coverage */
+    if (!i2c_crc_check) {
+        *pCovered = 0;
+        return length;
+    }
+    if (offset < STSE_PLATFORM_I2C_RSP_HEADER_SIZE) {
+        *pCovered = 1;
+        boundary = STSE_PLATFORM_I2C_RSP_HEADER_SIZE;
+    } else if (offset < (STSE_PLATFORM_I2C_RSP_HEADER_SIZE + STSE_PLATFORM_I2C_RSP_LENGTH_SIZE)) {
+        *pCovered = 0;
+        boundary = STSE_PLATFORM_I2C_RSP_HEADER_SIZE + STSE_PLATFORM_I2C_RSP_LENGTH_SIZE;
+    } else if (offset < (i2c_frame_size - STSE_PLATFORM_I2C_RSP_CRC_SIZE)) {
+        *pCovered = 1;
+        boundary = i2c_frame_size - STSE_PLATFORM_I2C_RSP_CRC_SIZE;
+    } else {
+        *pCovered = 0;
+        boundary = i2c_frame_size;
+    }
+
+    return ((boundary - offset) < length) ? (boundary - offset) : length;
+}
+
+static void _stse_platform_i2c_crc_copy(PLAT_UI8 *pData, PLAT_UI16 length) {
+    PLAT_UI8 *pSource = STSE_PLATFORM_I2C_BUFFER + i2c_frame_offset;
+    PLAT_UI16 offset = i2c_frame_offset;
+    PLAT_UI16 run;
+    PLAT_UI8 covered;
+
+    /* - Copy the fragment and accumulate its covered bytes in the same pass */
+    while (length != 0) {
+        run = _stse_platform_i2c_crc_run(offset, length, &covered);
+        if (covered && (pData != NULL)) {
+            crc16_ctx_copy_update(&i2c_crc_ctx, pData, pSource, run);
+        } else if (covered) {
+            if (crc16_ctx_update(&i2c_crc_ctx, pSource, run) != 0) {
+                i2c_crc_fault = 1;
+            }
+        } else if (pData != NULL) {
+            memcpy(pData, pSource, run);
+        }
+        if (pData != NULL) {
+            pData += run;
+        }
+        pSource += run;
+        offset += run;
+        length -= run;
+    }
+}
+#endif
+
+#ifdef STSE_CONF_PLATFORM_I2C_RECEIVE_CRC
+#define STSE_PLATFORM_I2C_CRC_WINDOW pI2c_crc_window
+#else
+#define STSE_PLATFORM_I2C_CRC_WINDOW NULL
+#endif
+
+/* Response area hashed while the frame is received (see
+ * stse_platform_i2c_receive_hash_arm) */
+static struct {
+    stse_platform_hash_stream_t stream;
+    stse_hash_algorithm_t algo;
+    PLAT_UI16 offset;
+    PLAT_UI16 end;
+    PLAT_UI8 armed;
+    PLAT_UI8 received; /* Digest of the frame being read, CRC not checked yet */
+    PLAT_UI8 digest[STSE_PLATFORM_I2C_DIGEST_MAX_SIZE];
+    PLAT_UI16 digest_length; /* 0 : no digest */
+} i2c_rx_hash;
+
+static void _stse_platform_i2c_receive_hash_drop(void) {
+    memset(i2c_rx_hash.digest, 0, sizeof(i2c_rx_hash.digest));
+    i2c_rx_hash.digest_length = 0;
+    i2c_rx_hash.received = 0;
+}
+
+static void _stse_platform_i2c_receive_hash_disarm(void) {
+    PLAT_UI8 digest[STSE_PLATFORM_I2C_DIGEST_MAX_SIZE];
+    PLAT_UI16 digest_length = sizeof(digest);
+
+    /* - Release the hash stream of a frame never received */
+    if (i2c_rx_hash.armed) {
+        stse_platform_hash_stream_finish(&i2c_rx_hash.stream, digest, &digest_length);
+        i2c_rx_hash.armed = 0;
+    }
+    _stse_platform_i2c_receive_hash_drop();
+}
+
+static PLAT_I8 _stse_platform_i2c_read_hashed(PLAT_UI8 devAddr,
+                                              PLAT_UI16 speed,
+                                              PLAT_UI8 *pFrame,
+                                              PLAT_UI16 frameLength,
+                                              i2c_crc_window_t *pWindow) {
+    stse_ReturnCode_t hash_ret = STSE_OK;
+    i2c_xfer_status_t status = I2C_XFER_ERROR;
+    PLAT_UI16 hashed = i2c_rx_hash.offset;
+    PLAT_UI16 crc_fed = 0;
+    PLAT_UI16 available;
+    PLAT_UI16 hash_available;
+
+    /* - Start interrupt driven reception */
+    if (i2c_read_it_start(I2C1, devAddr, speed, pFrame, frameLength) == 0) {
+        stse_platform_timeout_ms_start(STSE_PLATFORM_I2C_RECEIVE_TIMEOUT_MS);
+        do {
+            status = i2c_read_it_status();
+            available = i2c_read_it_progress();
+
+            /* - Hash the landed part of the area by chunks while the next bytes are received */
+            hash_available = (available < i2c_rx_hash.end) ? available : i2c_rx_hash.end;
+            if ((hash_ret == STSE_OK) && (hash_available > hashed) &&
+                (((PLAT_UI16)(hash_available - hashed) >= STSE_PLATFORM_I2C_PIPELINE_CHUNK_SIZE) ||
+                 (hash_available == i2c_rx_hash.end))) {
+                hash_ret = stse_platform_hash_stream_append(&i2c_rx_hash.stream, pFrame + hashed, hash_available - hashed);
+                hashed = hash_available;
+            }
+
+            /* - Response CRC accumulated the same way */
+            if ((pWindow != NULL) &&
+                (((PLAT_UI16)(available - crc_fed) >= I2C_CRC_CHUNK_SIZE) || (status != I2C_XFER_BUSY))) {
+                i2c_crc_feed(pWindow, pFrame, crc_fed, available);
+                crc_fed = available;
+            }
+
+            /* - Abort when the frame is not received in time */
+            if ((status == I2C_XFER_BUSY) && stse_platform_timeout_ms_get_status()) {
+                i2c_read_it_abort();
+                status = I2C_XFER_ERROR;
+            }
+        } while (status == I2C_XFER_BUSY);
+    }
+
+    if (status != I2C_XFER_DONE) {
+        /* - Bus error : hashing restarted on the frame read again by the core */
+        _stse_platform_i2c_receive_hash_disarm();
+        i2c_rx_hash.armed = (stse_platform_hash_stream_init(&i2c_rx_hash.stream, i2c_rx_hash.algo) == STSE_OK);
+        return -1;
+    }
+
+    /* - Digest released to the caller once the frame CRC is checked */
+    i2c_rx_hash.armed = 0;
+    i2c_rx_hash.digest_length = sizeof(i2c_rx_hash.digest);
+    if ((stse_platform_hash_stream_finish(&i2c_rx_hash.stream, i2c_rx_hash.digest, &i2c_rx_hash.digest_length) != STSE_OK) ||
+        (hash_ret != STSE_OK)) {
+        _stse_platform_i2c_receive_hash_drop();
+    } else {
+        i2c_rx_hash.received = 1;
+    }
+
+    return 0;
+}
+
 stse_ReturnCode_t stse_platform_i2c_init(PLAT_UI8 busID) {
     (void)busID;
     return (stse_ReturnCode_t)i2c_init(I2C1);
@@ -162,12 +358,42 @@ stse_ReturnCode_t stse_platform_i2c_receive_start(
     }
 #endif
 
-    /* - Read full Frame */
-#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
-    ret = i2c_read(I2C1, devAddr, speed, pI2c_buffer, i2c_frame_size);
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE) || defined(STSE_CONF_PLATFORM_I2C_RECEIVE_CRC)
+    /* - Response CRC checked by the PAL on complete frames only */
+    crc16_ctx_init(&i2c_crc_ctx);
+    i2c_crc_check = (frameLength >= STSE_PLATFORM_I2C_RSP_MIN_SIZE);
+    i2c_crc_fault = 0;
+    pI2c_crc_header = NULL;
+    stse_platform_crc16_receive_verified(NULL, 0);
+#endif
+#ifdef STSE_CONF_PLATFORM_I2C_RECEIVE_CRC
+    /* - Accumulate response CRC on header and payload while receiving */
+    if (i2c_crc_check) {
+        i2c_crc_window.pCtx = &i2c_crc_ctx;
+        i2c_crc_window.skip_offset = STSE_PLATFORM_I2C_RSP_HEADER_SIZE;
+        i2c_crc_window.skip_length = STSE_PLATFORM_I2C_RSP_LENGTH_SIZE;
+        i2c_crc_window.end = frameLength - STSE_PLATFORM_I2C_RSP_CRC_SIZE;
+        pI2c_crc_window = &i2c_crc_window;
+    } else {
+        pI2c_crc_window = NULL;
+    }
+#endif
+
+    /* - Read full Frame (armed area hashed while it is received) */
+    if (i2c_rx_hash.armed && (frameLength >= i2c_rx_hash.end)) {
+        ret = _stse_platform_i2c_read_hashed(devAddr, speed, STSE_PLATFORM_I2C_BUFFER, i2c_frame_size,
+                                             STSE_PLATFORM_I2C_CRC_WINDOW);
+    } else {
+#if defined(STSE_CONF_PLATFORM_I2C_RECEIVE_CRC) && defined(STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION)
+        ret = i2c_read_crc(I2C1, devAddr, speed, pI2c_buffer, i2c_frame_size, pI2c_crc_window);
+#elif defined(STSE_CONF_PLATFORM_I2C_RECEIVE_CRC)
+        ret = i2c_read_crc(I2C1, devAddr, speed, I2c_buffer, i2c_frame_size, pI2c_crc_window);
+#elif defined(STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION)
+        ret = i2c_read(I2C1, devAddr, speed, pI2c_buffer, i2c_frame_size);
 #else
-    ret = i2c_read(I2C1, devAddr, speed, I2c_buffer, i2c_frame_size);
+        ret = i2c_read(I2C1, devAddr, speed, I2c_buffer, i2c_frame_size);
 #endif
+    }
     if (ret != 0) {
         return STSE_PLATFORM_BUS_ACK_ERROR;
     }
@@ -193,14 +419,28 @@ stse_ReturnCode_t stse_platform_i2c_receive_continue(
         if ((i2c_frame_size - i2c_frame_offset) < data_size) {
             return STSE_PLATFORM_BUFFER_ERR;
         }
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE) || defined(STSE_CONF_PLATFORM_I2C_RECEIVE_CRC)
+        /* Response header element (start of the core CRC pass) */
+        if (i2c_frame_offset == 0) {
+            pI2c_crc_header = pData;
+        }
+#endif
 
         /* Copy buffer content */
-#ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE)
+        _stse_platform_i2c_crc_copy(pData, data_size);
+#elif defined(STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION)
         memcpy(pData, (pI2c_buffer + i2c_frame_offset), data_size);
 #else
         memcpy(pData, (I2c_buffer + i2c_frame_offset), data_size);
 #endif
     }
+#ifdef STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE
+    else if ((i2c_frame_size - i2c_frame_offset) >= data_size) {
+        /* Skipped bytes (i.e. length field) */
+        _stse_platform_i2c_crc_copy(NULL, data_size);
+    }
+#endif
 
     i2c_frame_offset += data_size;
 
@@ -218,6 +458,21 @@ stse_ReturnCode_t stse_platform_i2c_receive_stop(
     /*- Copy last element*/
     ret = stse_platform_i2c_receive_continue(busID, devAddr, speed, pData, data_size);
 
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE) || defined(STSE_CONF_PLATFORM_I2C_RECEIVE_CRC)
+    /*- Check the accumulated CRC once the whole frame is read */
+    if ((ret == STSE_OK) && i2c_crc_check && (i2c_frame_offset == i2c_frame_size)) {
+        ret = _stse_platform_i2c_crc_verify();
+    }
+#endif
+
+    /*- Digest of the hashed area kept on a valid frame only */
+    if (i2c_rx_hash.received) {
+        i2c_rx_hash.received = 0;
+        if (ret != STSE_OK) {
+            _stse_platform_i2c_receive_hash_drop();
+        }
+    }
+
     i2c_frame_offset = 0;
 
 #ifdef STSE_PLATFORM_I2C_DYNAMIC_BUFFER_ALLOCATION
@@ -226,3 +481,68 @@ stse_ReturnCode_t stse_platform_i2c_receive_stop(
 #endif
     return ret;
 }
+
+stse_ReturnCode_t stse_platform_i2c_receive_hash_arm(PLAT_UI16 hash_offset,
+                                                     PLAT_UI16 hash_length,
+                                                     stse_hash_algorithm_t hash_algo) {
+    stse_ReturnCode_t ret;
+
+    if ((PLAT_UI32)hash_offset + hash_length > 0xFFFFU) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
+    /* - Drop a previous arm and its digest */
+    _stse_platform_i2c_receive_hash_disarm();
+
+    ret = stse_platform_hash_stream_init(&i2c_rx_hash.stream, hash_algo);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+    i2c_rx_hash.algo = hash_algo;
+    i2c_rx_hash.offset = hash_offset;
+    i2c_rx_hash.end = hash_offset + hash_length;
+    i2c_rx_hash.armed = 1;
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_i2c_receive_hash_get(PLAT_UI8 *pHash, PLAT_UI16 *pHash_length) {
+    stse_ReturnCode_t ret = STSE_OK;
+
+    /* - Digest of a response received completely with a valid CRC only */
+    if (i2c_rx_hash.digest_length == 0 || i2c_rx_hash.received) {
+        ret = STSE_PLATFORM_HASH_ERROR;
+    } else if (pHash == NULL || pHash_length == NULL || *pHash_length < i2c_rx_hash.digest_length) {
+        ret = STSE_PLATFORM_BUFFER_ERR;
+    } else {
+        memcpy(pHash, i2c_rx_hash.digest, i2c_rx_hash.digest_length);
+        *pHash_length = i2c_rx_hash.digest_length;
+    }
+
+    /* - End of the armed command */
+    _stse_platform_i2c_receive_hash_disarm();
+
+    return ret;
+}
+
+stse_ReturnCode_t stse_platform_i2c_receive_verify(stse_ecc_key_type_t key_type,
+                                                   const PLAT_UI8 *pPubKey,
+                                                   PLAT_UI8 *pSignature) {
+    stse_ReturnCode_t ret;
+    PLAT_UI8 digest[STSE_PLATFORM_I2C_DIGEST_MAX_SIZE];
+    PLAT_UI16 digest_length = sizeof(digest);
+
+    /* - Ed25519 signs the message itself : the pipelined digest can't be verified */
+    if (key_type == STSE_ECC_KT_ED25519 || pPubKey == NULL || pSignature == NULL) {
+        _stse_platform_i2c_receive_hash_disarm();
+        return STSE_PLATFORM_INVALID_PARAMETER;
+    }
+
+    ret = stse_platform_i2c_receive_hash_get(digest, &digest_length);
+    if (ret == STSE_OK) {
+        ret = stse_platform_ecc_verify(key_type, pPubKey, digest, digest_length, pSignature);
+    }
+    memset(digest, 0, sizeof(digest));
+
+    return ret;
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * \file	stse_platform_i2c.h
+ * \brief   STSecureElement Services platform (header)
+ * \author  STMicroelectronics - CS application team
+ *
+ ******************************************************************************
+ * \attention
+ *
+ * <h2><center>&copy; COPYRIGHT 2022 STMicroelectronics</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef STSE_PLATFORM_I2C_H
+#define STSE_PLATFORM_I2C_H
+
+#include "core/stse_platform.h"
+#include "stse_platform_ecc.h"
+#include "stse_platform_hash.h"
+
+/* Pipelined receive : when a response area is armed, the next response frame
+ * covering it is received under interrupt by stse_platform_i2c_receive_start
+ * while the area is hashed, STSE_PLATFORM_I2C_PIPELINE_CHUNK_SIZE landed bytes
+ * at a time. Only the tail of the area is left to hash once the last byte is
+ * received. The frame then goes through the regular receive_continue /
+ * receive_stop path (framing and response CRC unchanged) */
+#define STSE_PLATFORM_I2C_PIPELINE_CHUNK_SIZE 64U
+
+/* Pipelined receive timeout (ms) : the transfer is aborted when the frame is
+ * not received in time */
+#define STSE_PLATFORM_I2C_RECEIVE_TIMEOUT_MS 500U
+
+/* Largest digest produced by the pipelined receive (SHA-512) */
+#define STSE_PLATFORM_I2C_DIGEST_MAX_SIZE 64U
+
+/*!
+ * \brief	Hash a response area while the next response frame is received
+ * \details	To be called before the STSELib command whose response carries the
+ *          area. Offsets are relative to the response frame (header byte at
+ *          0, length field at 1, payload from 3). Shorter frames (i.e. the
+ *          core length read) are received as usual and leave the area armed,
+ *          as do bus errors retried by the core. The arm ends with
+ *          stse_platform_i2c_receive_hash_get, to be called once the command
+ *          returns, whatever its status
+ * \param[in] hash_offset	Offset of the hashed area in the response frame
+ * \param[in] hash_length	Length of the hashed area
+ * \param[in] hash_algo		Hash algorithm
+ * \result  STSE_OK on success ; stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_i2c_receive_hash_arm(PLAT_UI16 hash_offset,
+                                                     PLAT_UI16 hash_length,
+                                                     stse_hash_algorithm_t hash_algo);
+
+/*!
+ * \brief	Get the digest of the armed response area and end the arm
+ * \details	The digest is available once receive_stop accepted the frame. With
+ *          a PAL response CRC mode (STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE or
+ *          STSE_CONF_PLATFORM_I2C_RECEIVE_CRC) a frame with a CRC error has no
+ *          digest ; otherwise the CRC is checked by the core and the digest
+ *          shall only be used when the command succeeded
+ * \param[out] pHash			Digest buffer
+ * \param[in,out] pHash_length	Digest buffer size in ; digest length out
+ * \result  STSE_OK on success ; STSE_PLATFORM_HASH_ERROR when no digest was
+ *          produced ; stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_i2c_receive_hash_get(PLAT_UI8 *pHash, PLAT_UI16 *pHash_length);
+
+/*!
+ * \brief	Verify a signature over the armed response area
+ * \details	Signature verification of the digest produced while the response
+ *          was received (ends the arm). Ed25519 is not supported (the
+ *          signature covers the message, not its digest)
+ * \param[in] key_type		Public key type
+ * \param[in] pPubKey		Public key
+ * \param[in] pSignature	Signature (i.e. taken from the command response)
+ * \result  STSE_OK when the signature is valid ; stse_ReturnCode_t error code otherwise
+ */
+stse_ReturnCode_t stse_platform_i2c_receive_verify(stse_ecc_key_type_t key_type,
+                                                   const PLAT_UI8 *pPubKey,
+                                                   PLAT_UI8 *pSignature);
+
+#endif /* STSE_PLATFORM_I2C_H */
@@ -22,9 +22,20 @@
 #ifdef STSE_CONF_USE_ST1WIRE
 
 #define STSE_PLATFORM_ST1WIRE_BUFFER_LENGTH 752U
+
+/* Streaming mode : frames are sent/received byte per byte straight from/to the
+ * caller fragments instead of going through st1wire_buffer (blocking engine only) */
+//#define STSE_PLATFORM_ST1WIRE_STREAMING
+
+#if defined(STSE_PLATFORM_ST1WIRE_STREAMING) && defined(ST1WIRE_ASYNC_ENGINE)
+#error "STSE_PLATFORM_ST1WIRE_STREAMING requires the ST1Wire blocking engine"
+#endif
+
+#ifndef STSE_PLATFORM_ST1WIRE_STREAMING
 static PLAT_UI8 st1wire_buffer[STSE_PLATFORM_ST1WIRE_BUFFER_LENGTH];
 static PLAT_UI16 st1wire_frame_size;
 static volatile PLAT_UI16 st1wire_frame_offset;
+#endif
 
 stse_ReturnCode_t stse_platform_st1wire_init(PLAT_UI8 busID) {
     st1wire_ReturnCode_t ret;
@@ -49,6 +60,125 @@ stse_ReturnCode_t stse_platform_st1wire_wake(PLAT_UI8 busID,
     return (STSE_OK);
 }
 
+#ifdef STSE_PLATFORM_ST1WIRE_STREAMING
+stse_ReturnCode_t stse_platform_st1wire_send_start(
+    PLAT_UI8 busID,
+    PLAT_UI8 devAddr,
+    PLAT_UI16 speed,
+    PLAT_UI16 FrameLength) {
+    /* - Send start of frame and length header */
+    if (st1wire_SendFrameStart(busID, devAddr, speed, FrameLength) != ST1WIRE_OK) {
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_st1wire_send_continue(
+    PLAT_UI8 busID,
+    PLAT_UI8 devAddr,
+    PLAT_UI16 speed,
+    PLAT_UI8 *pData,
+    PLAT_UI16 data_size) {
+    (void)devAddr;
+    (void)speed;
+
+    if (st1wire_SendFrameContinue(busID, pData, data_size) != ST1WIRE_OK) {
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_st1wire_send_stop(
+    PLAT_UI8 busID,
+    PLAT_UI8 devAddr,
+    PLAT_UI16 speed,
+    PLAT_UI8 *pData,
+    PLAT_UI16 data_size) {
+    stse_ReturnCode_t ret;
+
+    ret = stse_platform_st1wire_send_continue(
+        busID,
+        devAddr,
+        speed,
+        pData,
+        data_size);
+
+    /* - Get frame acknowledge */
+    if ((ret == STSE_OK) && (st1wire_SendFrameStop(busID) != ST1WIRE_OK)) {
+        ret = STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    return ret;
+}
+
+stse_ReturnCode_t stse_platform_st1wire_receive_start(
+    PLAT_UI8 busID,
+    PLAT_UI8 devAddr,
+    PLAT_UI16 speed,
+    PLAT_UI16 frameLength) {
+    st1wire_ReturnCode_t ret;
+    PLAT_UI16 received_length;
+
+    /* - Read frame header, payload is received by the continue/stop calls */
+    ret = st1wire_ReceiveFrameStart(
+        busID,
+        devAddr,
+        speed,
+        frameLength,
+        &received_length);
+
+    if (ret == ST1WIRE_FRAME_OVERFLOW) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+    if (ret != ST1WIRE_OK) {
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_st1wire_receive_continue(
+    PLAT_UI8 busID,
+    PLAT_UI8 devAddr,
+    PLAT_UI16 speed,
+    PLAT_UI8 *pData,
+    PLAT_UI16 data_size) {
+    st1wire_ReturnCode_t ret;
+    (void)devAddr;
+    (void)speed;
+
+    ret = st1wire_ReceiveFrameContinue(busID, pData, data_size);
+
+    if (ret == ST1WIRE_INVALID_PARAMETER) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+    if (ret != ST1WIRE_OK) {
+        return STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    return STSE_OK;
+}
+
+stse_ReturnCode_t stse_platform_st1wire_receive_stop(
+    PLAT_UI8 busID,
+    PLAT_UI8 devAddr,
+    PLAT_UI16 speed,
+    PLAT_UI8 *pData,
+    PLAT_UI16 data_size) {
+    stse_ReturnCode_t ret;
+
+    /*- Receive last element*/
+    ret = stse_platform_st1wire_receive_continue(busID, devAddr, speed, pData, data_size);
+
+    if ((st1wire_ReceiveFrameStop(busID) != ST1WIRE_OK) && (ret == STSE_OK)) {
+        ret = STSE_PLATFORM_BUS_ACK_ERROR;
+    }
+
+    return ret;
+}
+#else
 stse_ReturnCode_t stse_platform_st1wire_send_start(
     PLAT_UI8 busID,
     PLAT_UI8 devAddr,
@@ -141,8 +271,12 @@ stse_ReturnCode_t stse_platform_st1wire_receive_start(
         devAddr,
         speed,
         st1wire_buffer,
+        STSE_PLATFORM_ST1WIRE_BUFFER_LENGTH,
         &st1wire_frame_size);
 
+    if (ret == ST1WIRE_FRAME_OVERFLOW) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
     if (ret != 0) {
         return STSE_PLATFORM_BUS_ACK_ERROR;
     }
@@ -192,4 +326,5 @@ stse_ReturnCode_t stse_platform_st1wire_receive_stop(
 
     return (STSE_OK);
 }
+#endif /* STSE_PLATFORM_ST1WIRE_STREAMING */
 #endif
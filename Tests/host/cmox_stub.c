@@ -0,0 +1,839 @@
+/* Host implementation of the CMOX API subset declared in
+ * stubs/Middleware/STM32_Cryptographic/include/cmox_crypto.h.
+ * Block cipher and hash primitives come from OpenSSL libcrypto, the modes and
+ * constructions the platform layer relies on are written out here after the
+ * NIST / RFC specifications so that they can be checked against published
+ * known-answer vectors. */
+
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+#include <string.h>
+
+#include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
+
+#define AES_BLOCK 16U
+
+/* Number of AES key expansions (key handle setKey or one-shot CBC / ECB / CMAC
+ * call) since start-up, observed by the tests */
+unsigned long cmox_stub_aes_key_schedules;
+
+static const EVP_CIPHER *_aes_cipher(size_t key_length, int cbc) {
+    switch (key_length) {
+    case 16U:
+        return cbc ? EVP_aes_128_cbc() : EVP_aes_128_ecb();
+    case 24U:
+        return cbc ? EVP_aes_192_cbc() : EVP_aes_192_ecb();
+    case 32U:
+        return cbc ? EVP_aes_256_cbc() : EVP_aes_256_ecb();
+    default:
+        return NULL;
+    }
+}
+
+static int _aes_crypt(int encrypt, int cbc, const uint8_t *pKey, size_t key_length, const uint8_t *pIv,
+                      const uint8_t *pIn, size_t length, uint8_t *pOut) {
+    const EVP_CIPHER *cipher = _aes_cipher(key_length, cbc);
+    EVP_CIPHER_CTX *ctx;
+    int out_length = 0;
+    int ok;
+
+    if ((cipher == NULL) || ((length % AES_BLOCK) != 0U)) {
+        return 0;
+    }
+    ctx = EVP_CIPHER_CTX_new();
+    ok = EVP_CipherInit_ex(ctx, cipher, NULL, pKey, pIv, encrypt) && EVP_CIPHER_CTX_set_padding(ctx, 0) &&
+         EVP_CipherUpdate(ctx, pOut, &out_length, pIn, (int)length);
+    EVP_CIPHER_CTX_free(ctx);
+    return ok && ((size_t)out_length == length);
+}
+
+static void _aes_encrypt_block(const uint8_t *pKey, size_t key_length, const uint8_t *pIn, uint8_t *pOut) {
+    _aes_crypt(1, 0, pKey, key_length, NULL, pIn, AES_BLOCK, pOut);
+}
+
+/* ------------------------------------------------ SP 800-90A CTR_DRBG --- */
+
+#define DRBG_KEY_LEN 32U
+#define DRBG_SEED_LEN (DRBG_KEY_LEN + AES_BLOCK)
+#define DRBG_MAX_INPUT 512U
+
+static const int ctr_drbg_aes256_tag;
+cmox_ctr_drbg_impl_t CMOX_CTR_DRBG_AES256 = &ctr_drbg_aes256_tag;
+
+static void _drbg_bcc(const uint8_t *pKey, const uint8_t *pData, size_t length, uint8_t *pOut) {
+    uint8_t chain[AES_BLOCK] = {0};
+    size_t i, j;
+
+    for (i = 0; i < length; i += AES_BLOCK) {
+        for (j = 0; j < AES_BLOCK; j++) {
+            chain[j] ^= pData[i + j];
+        }
+        _aes_encrypt_block(pKey, DRBG_KEY_LEN, chain, chain);
+    }
+    memcpy(pOut, chain, AES_BLOCK);
+}
+
+/* Block_Cipher_df (SP 800-90A 10.3.2) returning seedlen bytes */
+static void _drbg_df(const uint8_t *pInput, size_t length, uint8_t *pOut) {
+    uint8_t s[AES_BLOCK + 8U + DRBG_MAX_INPUT + AES_BLOCK];
+    uint8_t key[DRBG_KEY_LEN];
+    uint8_t temp[DRBG_SEED_LEN];
+    uint8_t *x = &temp[DRBG_KEY_LEN];
+    size_t s_length;
+    uint32_t i;
+
+    /* - S = IV || L || N || input || 0x80 || pad */
+    memset(s, 0, sizeof(s));
+    s[AES_BLOCK + 0] = (uint8_t)(length >> 24);
+    s[AES_BLOCK + 1] = (uint8_t)(length >> 16);
+    s[AES_BLOCK + 2] = (uint8_t)(length >> 8);
+    s[AES_BLOCK + 3] = (uint8_t)length;
+    s[AES_BLOCK + 7] = DRBG_SEED_LEN;
+    memcpy(&s[AES_BLOCK + 8U], pInput, length);
+    s[AES_BLOCK + 8U + length] = 0x80;
+    s_length = AES_BLOCK + 8U + length + 1U;
+    s_length = (s_length + AES_BLOCK - 1U) & ~(size_t)(AES_BLOCK - 1U);
+
+    for (i = 0; i < DRBG_KEY_LEN; i++) {
+        key[i] = (uint8_t)i;
+    }
+    for (i = 0; i < DRBG_SEED_LEN / AES_BLOCK; i++) {
+        s[3] = (uint8_t)i;
+        _drbg_bcc(key, s, s_length, &temp[i * AES_BLOCK]);
+    }
+
+    /* - Derive seedlen bytes with the new key */
+    memcpy(key, temp, DRBG_KEY_LEN);
+    for (i = 0; i < DRBG_SEED_LEN / AES_BLOCK; i++) {
+        _aes_encrypt_block(key, DRBG_KEY_LEN, x, &pOut[i * AES_BLOCK]);
+        x = &pOut[i * AES_BLOCK];
+    }
+}
+
+static void _drbg_increment(uint8_t *pV) {
+    int i;
+
+    for (i = AES_BLOCK - 1; i >= 0; i--) {
+        if (++pV[i] != 0) {
+            break;
+        }
+    }
+}
+
+static void _drbg_update(cmox_ctr_drbg_handle_t *pCtx, const uint8_t *pProvided) {
+    uint8_t temp[DRBG_SEED_LEN];
+    uint32_t i;
+
+    for (i = 0; i < DRBG_SEED_LEN; i += AES_BLOCK) {
+        _drbg_increment(pCtx->v);
+        _aes_encrypt_block(pCtx->key, DRBG_KEY_LEN, pCtx->v, &temp[i]);
+    }
+    for (i = 0; i < DRBG_SEED_LEN; i++) {
+        temp[i] ^= pProvided[i];
+    }
+    memcpy(pCtx->key, temp, DRBG_KEY_LEN);
+    memcpy(pCtx->v, &temp[DRBG_KEY_LEN], AES_BLOCK);
+}
+
+cmox_drbg_handle_t *cmox_ctr_drbg_construct(cmox_ctr_drbg_handle_t *P_pThis, cmox_ctr_drbg_impl_t P_impl) {
+    if ((P_pThis == NULL) || (P_impl != CMOX_CTR_DRBG_AES256)) {
+        return NULL;
+    }
+    memset(P_pThis, 0, sizeof(*P_pThis));
+    P_pThis->super.impl = P_impl;
+    return &P_pThis->super;
+}
+
+cmox_drbg_retval_t cmox_drbg_init(cmox_drbg_handle_t *P_pThis,
+                                  const uint8_t *P_pEntropy,
+                                  size_t P_EntropyLen,
+                                  const uint8_t *P_pPersonalization,
+                                  size_t P_PersonalizationLen,
+                                  const uint8_t *P_pNonce,
+                                  size_t P_NonceLen) {
+    cmox_ctr_drbg_handle_t *pCtx = (cmox_ctr_drbg_handle_t *)P_pThis;
+    uint8_t seed_material[DRBG_MAX_INPUT];
+    uint8_t seed[DRBG_SEED_LEN];
+
+    if ((pCtx == NULL) || (P_EntropyLen + P_NonceLen + P_PersonalizationLen > DRBG_MAX_INPUT)) {
+        return CMOX_DRBG_ERR_BAD_PARAMETER;
+    }
+    if (P_EntropyLen < DRBG_KEY_LEN) {
+        return CMOX_DRBG_ERR_BAD_ENTROPY_SIZE;
+    }
+    memcpy(seed_material, P_pEntropy, P_EntropyLen);
+    memcpy(&seed_material[P_EntropyLen], P_pNonce, P_NonceLen);
+    if (P_PersonalizationLen > 0U) {
+        memcpy(&seed_material[P_EntropyLen + P_NonceLen], P_pPersonalization, P_PersonalizationLen);
+    }
+    _drbg_df(seed_material, P_EntropyLen + P_NonceLen + P_PersonalizationLen, seed);
+
+    memset(pCtx->key, 0, sizeof(pCtx->key));
+    memset(pCtx->v, 0, sizeof(pCtx->v));
+    _drbg_update(pCtx, seed);
+    pCtx->reseed_counter = 1;
+    pCtx->instantiated = 1;
+
+    return CMOX_DRBG_SUCCESS;
+}
+
+cmox_drbg_retval_t cmox_drbg_reseed(cmox_drbg_handle_t *P_pThis,
+                                    const uint8_t *P_pEntropy,
+                                    size_t P_EntropyLen,
+                                    const uint8_t *P_pAdditionalInput,
+                                    size_t P_AdditionalInputLen) {
+    cmox_ctr_drbg_handle_t *pCtx = (cmox_ctr_drbg_handle_t *)P_pThis;
+    uint8_t seed_material[DRBG_MAX_INPUT];
+    uint8_t seed[DRBG_SEED_LEN];
+
+    if ((pCtx == NULL) || (pCtx->instantiated == 0U) || (P_EntropyLen + P_AdditionalInputLen > DRBG_MAX_INPUT)) {
+        return CMOX_DRBG_ERR_BAD_PARAMETER;
+    }
+    if (P_EntropyLen < DRBG_KEY_LEN) {
+        return CMOX_DRBG_ERR_BAD_ENTROPY_SIZE;
+    }
+    memcpy(seed_material, P_pEntropy, P_EntropyLen);
+    if (P_AdditionalInputLen > 0U) {
+        memcpy(&seed_material[P_EntropyLen], P_pAdditionalInput, P_AdditionalInputLen);
+    }
+    _drbg_df(seed_material, P_EntropyLen + P_AdditionalInputLen, seed);
+    _drbg_update(pCtx, seed);
+    pCtx->reseed_counter = 1;
+
+    return CMOX_DRBG_SUCCESS;
+}
+
+cmox_drbg_retval_t cmox_drbg_generate(cmox_drbg_handle_t *P_pThis,
+                                      const uint8_t *P_pAdditionalInput,
+                                      size_t P_AdditionalInputLen,
+                                      uint8_t *P_pOutput,
+                                      size_t P_OutputLen) {
+    cmox_ctr_drbg_handle_t *pCtx = (cmox_ctr_drbg_handle_t *)P_pThis;
+    uint8_t additional[DRBG_SEED_LEN] = {0};
+    uint8_t block[AES_BLOCK];
+    size_t offset, n;
+
+    if ((pCtx == NULL) || (pCtx->instantiated == 0U) || (P_AdditionalInputLen > DRBG_MAX_INPUT) ||
+        (P_OutputLen > 0x10000U)) {
+        return CMOX_DRBG_ERR_BAD_PARAMETER;
+    }
+    if (P_AdditionalInputLen > 0U) {
+        _drbg_df(P_pAdditionalInput, P_AdditionalInputLen, additional);
+        _drbg_update(pCtx, additional);
+    }
+    for (offset = 0; offset < P_OutputLen; offset += n) {
+        _drbg_increment(pCtx->v);
+        _aes_encrypt_block(pCtx->key, DRBG_KEY_LEN, pCtx->v, block);
+        n = ((P_OutputLen - offset) < AES_BLOCK) ? (P_OutputLen - offset) : AES_BLOCK;
+        memcpy(&P_pOutput[offset], block, n);
+    }
+    _drbg_update(pCtx, additional);
+    pCtx->reseed_counter++;
+
+    return CMOX_DRBG_SUCCESS;
+}
+
+cmox_drbg_retval_t cmox_drbg_cleanup(cmox_drbg_handle_t *P_pThis) {
+    if (P_pThis == NULL) {
+        return CMOX_DRBG_ERR_BAD_PARAMETER;
+    }
+    memset(P_pThis, 0, sizeof(cmox_ctr_drbg_handle_t));
+    return CMOX_DRBG_SUCCESS;
+}
+
+/* ------------------------------------------------------ FIPS 180-4 SHA-256 --- */
+
+static const int sha256_tag;
+cmox_hash_algo_t CMOX_SHA256_ALGO = &sha256_tag;
+
+/* Called with the length of each appended message chunk (i.e. to charge the
+ * hashing time to a simulated time base) */
+void (*cmox_stub_hash_hook)(size_t length);
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+#define ROR32(x, n) (((x) >> (n)) | ((x) << (32U - (n))))
+
+static void _sha256_compress(uint32_t *pState, const uint8_t *pBlock) {
+    uint32_t w[64], a, b, c, d, e, f, g, h, t1, t2;
+    uint32_t i;
+
+    for (i = 0; i < 16U; i++) {
+        w[i] = ((uint32_t)pBlock[4U * i] << 24) | ((uint32_t)pBlock[4U * i + 1U] << 16) |
+               ((uint32_t)pBlock[4U * i + 2U] << 8) | pBlock[4U * i + 3U];
+    }
+    for (i = 16; i < 64U; i++) {
+        w[i] = (ROR32(w[i - 2U], 17) ^ ROR32(w[i - 2U], 19) ^ (w[i - 2U] >> 10)) + w[i - 7U] +
+               (ROR32(w[i - 15U], 7) ^ ROR32(w[i - 15U], 18) ^ (w[i - 15U] >> 3)) + w[i - 16U];
+    }
+    a = pState[0], b = pState[1], c = pState[2], d = pState[3];
+    e = pState[4], f = pState[5], g = pState[6], h = pState[7];
+    for (i = 0; i < 64U; i++) {
+        t1 = h + (ROR32(e, 6) ^ ROR32(e, 11) ^ ROR32(e, 25)) + ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];
+        t2 = (ROR32(a, 2) ^ ROR32(a, 13) ^ ROR32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g, g = f, f = e, e = d + t1;
+        d = c, c = b, b = a, a = t1 + t2;
+    }
+    pState[0] += a, pState[1] += b, pState[2] += c, pState[3] += d;
+    pState[4] += e, pState[5] += f, pState[6] += g, pState[7] += h;
+}
+
+cmox_hash_handle_t *cmox_sha256_construct(cmox_sha256_handle_t *P_pThis) {
+    if (P_pThis == NULL) {
+        return NULL;
+    }
+    memset(P_pThis, 0, sizeof(*P_pThis));
+    P_pThis->super.algo = CMOX_SHA256_ALGO;
+    return &P_pThis->super;
+}
+
+cmox_hash_retval_t cmox_hash_init(cmox_hash_handle_t *P_pThis) {
+    static const uint32_t iv[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    if ((P_pThis == NULL) || (P_pThis->algo != CMOX_SHA256_ALGO)) {
+        return CMOX_HASH_ERR_BAD_PARAMETER;
+    }
+    memcpy(P_pThis->state, iv, sizeof(iv));
+    P_pThis->length = 0;
+    P_pThis->block_length = 0;
+    P_pThis->tag_length = CMOX_SHA256_SIZE;
+    return CMOX_HASH_SUCCESS;
+}
+
+cmox_hash_retval_t cmox_hash_setTagLen(cmox_hash_handle_t *P_pThis, size_t P_tagLen) {
+    if ((P_pThis == NULL) || (P_tagLen == 0U) || (P_tagLen > CMOX_SHA256_SIZE)) {
+        return CMOX_HASH_ERR_BAD_PARAMETER;
+    }
+    P_pThis->tag_length = P_tagLen;
+    return CMOX_HASH_SUCCESS;
+}
+
+cmox_hash_retval_t cmox_hash_append(cmox_hash_handle_t *P_pThis, const uint8_t *P_pInputMessage, size_t P_inputMessageLen) {
+    if ((P_pThis == NULL) || ((P_pInputMessage == NULL) && (P_inputMessageLen != 0U))) {
+        return CMOX_HASH_ERR_BAD_PARAMETER;
+    }
+    if (cmox_stub_hash_hook != NULL) {
+        cmox_stub_hash_hook(P_inputMessageLen);
+    }
+    P_pThis->length += P_inputMessageLen;
+    while (P_inputMessageLen-- > 0U) {
+        P_pThis->block[P_pThis->block_length++] = *P_pInputMessage++;
+        if (P_pThis->block_length == sizeof(P_pThis->block)) {
+            _sha256_compress(P_pThis->state, P_pThis->block);
+            P_pThis->block_length = 0;
+        }
+    }
+    return CMOX_HASH_SUCCESS;
+}
+
+cmox_hash_retval_t cmox_hash_generateTag(cmox_hash_handle_t *P_pThis, uint8_t *P_pDigest, size_t *P_pDigestLen) {
+    uint64_t bit_length;
+    uint8_t digest[CMOX_SHA256_SIZE];
+    uint32_t i;
+
+    if ((P_pThis == NULL) || (P_pDigest == NULL)) {
+        return CMOX_HASH_ERR_BAD_PARAMETER;
+    }
+    bit_length = P_pThis->length * 8U;
+    P_pThis->block[P_pThis->block_length++] = 0x80;
+    if (P_pThis->block_length > 56U) {
+        memset(&P_pThis->block[P_pThis->block_length], 0, 64U - P_pThis->block_length);
+        _sha256_compress(P_pThis->state, P_pThis->block);
+        P_pThis->block_length = 0;
+    }
+    memset(&P_pThis->block[P_pThis->block_length], 0, 56U - P_pThis->block_length);
+    for (i = 0; i < 8U; i++) {
+        P_pThis->block[56U + i] = (uint8_t)(bit_length >> (56U - (8U * i)));
+    }
+    _sha256_compress(P_pThis->state, P_pThis->block);
+    for (i = 0; i < 8U; i++) {
+        digest[4U * i] = (uint8_t)(P_pThis->state[i] >> 24);
+        digest[4U * i + 1U] = (uint8_t)(P_pThis->state[i] >> 16);
+        digest[4U * i + 2U] = (uint8_t)(P_pThis->state[i] >> 8);
+        digest[4U * i + 3U] = (uint8_t)P_pThis->state[i];
+    }
+    memcpy(P_pDigest, digest, P_pThis->tag_length);
+    if (P_pDigestLen != NULL) {
+        *P_pDigestLen = P_pThis->tag_length;
+    }
+    return CMOX_HASH_SUCCESS;
+}
+
+cmox_hash_retval_t cmox_hash_cleanup(cmox_hash_handle_t *P_pThis) {
+    if (P_pThis == NULL) {
+        return CMOX_HASH_ERR_BAD_PARAMETER;
+    }
+    memset(P_pThis, 0, sizeof(*P_pThis));
+    return CMOX_HASH_SUCCESS;
+}
+
+cmox_hash_retval_t cmox_hash_compute(cmox_hash_algo_t P_algo,
+                                     const uint8_t *P_pPlaintext,
+                                     size_t P_plaintextLen,
+                                     uint8_t *P_pDigest,
+                                     const size_t P_expectedDigestLen,
+                                     size_t *P_pComputedDigestLen) {
+    cmox_sha256_handle_t handle;
+    cmox_hash_handle_t *pHash = cmox_sha256_construct(&handle);
+    cmox_hash_retval_t retval;
+
+    if (P_algo != CMOX_SHA256_ALGO) {
+        return CMOX_HASH_ERR_BAD_PARAMETER;
+    }
+    retval = cmox_hash_init(pHash);
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_setTagLen(pHash, P_expectedDigestLen);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_append(pHash, P_pPlaintext, P_plaintextLen);
+    }
+    if (retval == CMOX_HASH_SUCCESS) {
+        retval = cmox_hash_generateTag(pHash, P_pDigest, P_pComputedDigestLen);
+    }
+    cmox_hash_cleanup(pHash);
+    return retval;
+}
+
+/* ------------------------------------------------------- RFC 2104 HMAC --- */
+
+static const int hmac_sha256_tag, cmac_aes_tag;
+cmox_mac_algo_t CMOX_HMAC_SHA256_ALGO = &hmac_sha256_tag;
+cmox_mac_algo_t CMOX_CMAC_AESSMALL_ALGO = &cmac_aes_tag;
+
+static cmox_mac_retval_t _hmac_sha256(const uint8_t *pKey, size_t key_length, const uint8_t *pInput, size_t input_length,
+                                      uint8_t *pTag, size_t tag_length) {
+    uint8_t block[64] = {0};
+    uint8_t digest[CMOX_SHA256_SIZE];
+    cmox_sha256_handle_t handle;
+    cmox_hash_handle_t *pHash = cmox_sha256_construct(&handle);
+    uint32_t i;
+
+    if (tag_length > CMOX_SHA256_SIZE) {
+        return CMOX_MAC_ERR_BAD_PARAMETER;
+    }
+    if (key_length > sizeof(block)) {
+        cmox_hash_compute(CMOX_SHA256_ALGO, pKey, key_length, block, CMOX_SHA256_SIZE, NULL);
+    } else if (key_length > 0U) {
+        memcpy(block, pKey, key_length);
+    }
+    for (i = 0; i < sizeof(block); i++) {
+        block[i] ^= 0x36;
+    }
+    cmox_hash_init(pHash);
+    cmox_hash_append(pHash, block, sizeof(block));
+    cmox_hash_append(pHash, pInput, input_length);
+    cmox_hash_generateTag(pHash, digest, NULL);
+    for (i = 0; i < sizeof(block); i++) {
+        block[i] ^= 0x36 ^ 0x5C;
+    }
+    cmox_hash_init(pHash);
+    cmox_hash_append(pHash, block, sizeof(block));
+    cmox_hash_append(pHash, digest, sizeof(digest));
+    cmox_hash_generateTag(pHash, digest, NULL);
+    memcpy(pTag, digest, tag_length);
+
+    return CMOX_MAC_SUCCESS;
+}
+
+/* AES-CMAC from the OpenSSL EVP_MAC provider (reference for the platform CMAC) */
+static cmox_mac_retval_t _cmac_aes(const uint8_t *pKey, size_t key_length, const uint8_t *pInput, size_t input_length,
+                                   uint8_t *pTag, size_t tag_length) {
+    static const char *names[] = {"AES-128-CBC", "AES-192-CBC", "AES-256-CBC"};
+    EVP_MAC *mac = EVP_MAC_fetch(NULL, "CMAC", NULL);
+    EVP_MAC_CTX *ctx = EVP_MAC_CTX_new(mac);
+    OSSL_PARAM params[2];
+    uint8_t tag[AES_BLOCK];
+    size_t length = 0;
+    int ok;
+
+    if ((tag_length == 0U) || (tag_length > AES_BLOCK) || (_aes_cipher(key_length, 1) == NULL)) {
+        EVP_MAC_CTX_free(ctx);
+        EVP_MAC_free(mac);
+        return CMOX_MAC_ERR_BAD_PARAMETER;
+    }
+    params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_CIPHER, (char *)names[(key_length - 16U) / 8U], 0);
+    params[1] = OSSL_PARAM_construct_end();
+    ok = EVP_MAC_init(ctx, pKey, key_length, params) && EVP_MAC_update(ctx, pInput, input_length) &&
+         EVP_MAC_final(ctx, tag, &length, sizeof(tag));
+    EVP_MAC_CTX_free(ctx);
+    EVP_MAC_free(mac);
+    if (!ok) {
+        return CMOX_MAC_ERR_BAD_PARAMETER;
+    }
+    cmox_stub_aes_key_schedules++;
+    memcpy(pTag, tag, tag_length);
+    return CMOX_MAC_SUCCESS;
+}
+
+cmox_mac_retval_t cmox_mac_compute(cmox_mac_algo_t P_algo,
+                                   const uint8_t *P_pInput,
+                                   size_t P_inputLen,
+                                   const uint8_t *P_pKey,
+                                   size_t P_keyLen,
+                                   const uint8_t *P_pCustomData,
+                                   size_t P_customDataLen,
+                                   uint8_t *P_pTag,
+                                   size_t P_expectedTagLen,
+                                   size_t *P_pComputedTagLen) {
+    cmox_mac_retval_t retval = CMOX_MAC_ERR_BAD_PARAMETER;
+
+    if (P_algo == CMOX_HMAC_SHA256_ALGO) {
+        retval = _hmac_sha256(P_pKey, P_keyLen, P_pInput, P_inputLen, P_pTag, P_expectedTagLen);
+    } else if (P_algo == CMOX_CMAC_AESSMALL_ALGO) {
+        retval = _cmac_aes(P_pKey, P_keyLen, P_pInput, P_inputLen, P_pTag, P_expectedTagLen);
+    }
+    if ((retval == CMOX_MAC_SUCCESS) && (P_pComputedTagLen != NULL)) {
+        *P_pComputedTagLen = P_expectedTagLen;
+    }
+    return retval;
+}
+
+cmox_mac_retval_t cmox_mac_verify(cmox_mac_algo_t P_algo,
+                                  const uint8_t *P_pInput,
+                                  size_t P_inputLen,
+                                  const uint8_t *P_pKey,
+                                  size_t P_keyLen,
+                                  const uint8_t *P_pCustomData,
+                                  size_t P_customDataLen,
+                                  const uint8_t *P_pExpectedTag,
+                                  size_t P_tagLen) {
+    uint8_t tag[CMOX_SHA256_SIZE];
+
+    if ((P_tagLen > sizeof(tag)) ||
+        (cmox_mac_compute(P_algo, P_pInput, P_inputLen, P_pKey, P_keyLen, P_pCustomData, P_customDataLen, tag, P_tagLen,
+                          NULL) != CMOX_MAC_SUCCESS)) {
+        return CMOX_MAC_ERR_BAD_PARAMETER;
+    }
+    return (memcmp(tag, P_pExpectedTag, P_tagLen) == 0) ? CMOX_MAC_AUTH_SUCCESS : CMOX_MAC_AUTH_FAIL;
+}
+
+/* ------------------------------------------------------------ AES modes --- */
+
+static const int aes_cbc_enc_tag, aes_cbc_dec_tag, aes_ecb_enc_tag, aes_ecb_dec_tag;
+cmox_cipher_algo_t CMOX_AESSMALL_CBC_ENC_ALGO = &aes_cbc_enc_tag;
+cmox_cipher_algo_t CMOX_AESSMALL_CBC_DEC_ALGO = &aes_cbc_dec_tag;
+cmox_cipher_algo_t CMOX_AESSMALL_ECB_ENC_ALGO = &aes_ecb_enc_tag;
+cmox_cipher_algo_t CMOX_AESSMALL_ECB_DEC_ALGO = &aes_ecb_dec_tag;
+cmox_ecb_impl_t CMOX_AESSMALL_ECB_ENC = &aes_ecb_enc_tag;
+cmox_ecb_impl_t CMOX_AESSMALL_ECB_DEC = &aes_ecb_dec_tag;
+
+cmox_cipher_handle_t *cmox_ecb_construct(cmox_ecb_handle_t *P_pThis, cmox_ecb_impl_t P_impl) {
+    if ((P_pThis == NULL) || ((P_impl != CMOX_AESSMALL_ECB_ENC) && (P_impl != CMOX_AESSMALL_ECB_DEC))) {
+        return NULL;
+    }
+    memset(P_pThis, 0, sizeof(*P_pThis));
+    P_pThis->super.impl = P_impl;
+    return &P_pThis->super;
+}
+
+cmox_cipher_retval_t cmox_cipher_init(cmox_cipher_handle_t *P_pThis) {
+    return (P_pThis != NULL) ? CMOX_CIPHER_SUCCESS : CMOX_CIPHER_ERR_BAD_PARAMETER;
+}
+
+cmox_cipher_retval_t cmox_cipher_setKey(cmox_cipher_handle_t *P_pThis, const uint8_t *P_pKey, size_t P_keyLen) {
+    if ((P_pThis == NULL) || (P_pKey == NULL) || (_aes_cipher(P_keyLen, 0) == NULL)) {
+        return CMOX_CIPHER_ERR_BAD_PARAMETER;
+    }
+    memcpy(P_pThis->key, P_pKey, P_keyLen);
+    P_pThis->key_length = P_keyLen;
+    P_pThis->keyed = 1;
+    cmox_stub_aes_key_schedules++;
+    return CMOX_CIPHER_SUCCESS;
+}
+
+cmox_cipher_retval_t cmox_cipher_append(cmox_cipher_handle_t *P_pThis,
+                                        const uint8_t *P_pInput,
+                                        size_t P_inputLen,
+                                        uint8_t *P_pOutput,
+                                        size_t *P_pOutputLen) {
+    if ((P_pThis == NULL) || (P_pThis->keyed == 0U) || (P_pOutputLen == NULL) || (*P_pOutputLen < P_inputLen)) {
+        return CMOX_CIPHER_ERR_BAD_PARAMETER;
+    }
+    if (!_aes_crypt(P_pThis->impl == CMOX_AESSMALL_ECB_ENC, 0, P_pThis->key, P_pThis->key_length, NULL, P_pInput,
+                    P_inputLen, P_pOutput)) {
+        return CMOX_CIPHER_ERR_BAD_OPERATION;
+    }
+    *P_pOutputLen = P_inputLen;
+    return CMOX_CIPHER_SUCCESS;
+}
+
+cmox_cipher_retval_t cmox_cipher_cleanup(cmox_cipher_handle_t *P_pThis) {
+    if (P_pThis == NULL) {
+        return CMOX_CIPHER_ERR_BAD_PARAMETER;
+    }
+    memset(P_pThis, 0, sizeof(*P_pThis));
+    return CMOX_CIPHER_SUCCESS;
+}
+
+static cmox_cipher_retval_t _cipher_oneshot(int encrypt, cmox_cipher_algo_t P_algo, const uint8_t *P_pInput,
+                                            size_t P_inputLen, const uint8_t *P_pKey, size_t P_keyLen,
+                                            const uint8_t *P_pIv, uint8_t *P_pOutput, size_t *P_pOutputLen) {
+    int cbc = (P_algo == CMOX_AESSMALL_CBC_ENC_ALGO) || (P_algo == CMOX_AESSMALL_CBC_DEC_ALGO);
+
+    if ((P_pOutputLen == NULL) || (*P_pOutputLen < P_inputLen)) {
+        return CMOX_CIPHER_ERR_BAD_PARAMETER;
+    }
+    if (!_aes_crypt(encrypt, cbc, P_pKey, P_keyLen, cbc ? P_pIv : NULL, P_pInput, P_inputLen, P_pOutput)) {
+        return CMOX_CIPHER_ERR_BAD_PARAMETER;
+    }
+    cmox_stub_aes_key_schedules++;
+    *P_pOutputLen = P_inputLen;
+    return CMOX_CIPHER_SUCCESS;
+}
+
+cmox_cipher_retval_t cmox_cipher_encrypt(cmox_cipher_algo_t P_algo,
+                                         const uint8_t *P_pInput,
+                                         size_t P_inputLen,
+                                         const uint8_t *P_pKey,
+                                         size_t P_keyLen,
+                                         const uint8_t *P_pIv,
+                                         size_t P_ivLen,
+                                         uint8_t *P_pOutput,
+                                         size_t *P_pOutputLen) {
+    if ((P_algo != CMOX_AESSMALL_CBC_ENC_ALGO) && (P_algo != CMOX_AESSMALL_ECB_ENC_ALGO)) {
+        return CMOX_CIPHER_ERR_BAD_PARAMETER;
+    }
+    return _cipher_oneshot(1, P_algo, P_pInput, P_inputLen, P_pKey, P_keyLen, P_pIv, P_pOutput, P_pOutputLen);
+}
+
+cmox_cipher_retval_t cmox_cipher_decrypt(cmox_cipher_algo_t P_algo,
+                                         const uint8_t *P_pInput,
+                                         size_t P_inputLen,
+                                         const uint8_t *P_pKey,
+                                         size_t P_keyLen,
+                                         const uint8_t *P_pIv,
+                                         size_t P_ivLen,
+                                         uint8_t *P_pOutput,
+                                         size_t *P_pOutputLen) {
+    if ((P_algo != CMOX_AESSMALL_CBC_DEC_ALGO) && (P_algo != CMOX_AESSMALL_ECB_DEC_ALGO)) {
+        return CMOX_CIPHER_ERR_BAD_PARAMETER;
+    }
+    return _cipher_oneshot(0, P_algo, P_pInput, P_inputLen, P_pKey, P_keyLen, P_pIv, P_pOutput, P_pOutputLen);
+}
+
+/* ------------------------------------------------------------------ ECC --- */
+
+/* Curve arithmetic is not modelled : the public key is the private key masked
+ * with a constant and a signature is the public key masked with the digest, so
+ * that the platform layer plumbing (implementation selection, key / signature
+ * lengths, engine construction) can be checked on the host */
+typedef struct {
+    size_t priv_key_length;
+    size_t pub_key_length;
+    size_t sig_length;
+} ecc_curve_t;
+
+static const ecc_curve_t ecc_p256 = {32, 64, 64}, ecc_p384 = {48, 96, 96}, ecc_p521 = {66, 132, 132};
+static const ecc_curve_t ecc_bp256 = {32, 64, 64}, ecc_bp384 = {48, 96, 96}, ecc_bp512 = {64, 128, 128};
+static const ecc_curve_t ecc_c25519 = {32, 32, 0}, ecc_ed25519 = {64, 32, 64};
+static const ecc_curve_t ecc_p256_fast = {32, 64, 64}, ecc_p384_fast = {48, 96, 96}, ecc_p521_fast = {66, 132, 132};
+static const ecc_curve_t ecc_bp256_fast = {32, 64, 64}, ecc_bp384_fast = {48, 96, 96}, ecc_bp512_fast = {64, 128, 128};
+static const ecc_curve_t ecc_ed25519_fast = {64, 32, 64};
+
+cmox_ecc_impl_t CMOX_ECC_SECP256R1_LOWMEM = &ecc_p256, CMOX_ECC_SECP256R1_HIGHMEM = &ecc_p256_fast;
+cmox_ecc_impl_t CMOX_ECC_SECP384R1_LOWMEM = &ecc_p384, CMOX_ECC_SECP384R1_HIGHMEM = &ecc_p384_fast;
+cmox_ecc_impl_t CMOX_ECC_SECP521R1_LOWMEM = &ecc_p521, CMOX_ECC_SECP521R1_HIGHMEM = &ecc_p521_fast;
+cmox_ecc_impl_t CMOX_ECC_BPP256R1_LOWMEM = &ecc_bp256, CMOX_ECC_BPP256R1_HIGHMEM = &ecc_bp256_fast;
+cmox_ecc_impl_t CMOX_ECC_BPP384R1_LOWMEM = &ecc_bp384, CMOX_ECC_BPP384R1_HIGHMEM = &ecc_bp384_fast;
+cmox_ecc_impl_t CMOX_ECC_BPP512R1_LOWMEM = &ecc_bp512, CMOX_ECC_BPP512R1_HIGHMEM = &ecc_bp512_fast;
+cmox_ecc_impl_t CMOX_ECC_CURVE25519 = &ecc_c25519;
+cmox_ecc_impl_t CMOX_ECC_ED25519_OPT_LOWMEM = &ecc_ed25519, CMOX_ECC_ED25519_OPT_HIGHMEM = &ecc_ed25519_fast;
+
+static const int math_small_tag, math_fast_tag;
+cmox_math_funcs_t CMOX_MATH_FUNCS_SMALL = &math_small_tag;
+cmox_math_funcs_t CMOX_MATH_FUNCS_FAST = &math_fast_tag;
+
+/* Parameters of the last ECC operation (checked by the tests) */
+cmox_ecc_impl_t cmox_stub_ecc_impl;
+cmox_math_funcs_t cmox_stub_ecc_math;
+size_t cmox_stub_ecc_buffer_length;
+uint8_t *cmox_stub_ecc_buffer;
+uint8_t *cmox_stub_ecc_priv_key; /* Private key output of the last key generation */
+
+#define ECC_PUB_KEY_MASK 0x5AU
+#define ECC_MATH_SCRATCH 0xC3U
+
+static const ecc_curve_t *_ecc_curve(cmox_ecc_handle_t *pCtx, cmox_ecc_impl_t impl) {
+    cmox_stub_ecc_impl = impl;
+    if ((pCtx == NULL) || (pCtx->pBuffer == NULL) || (impl == NULL)) {
+        return NULL;
+    }
+    cmox_stub_ecc_math = pCtx->math;
+    cmox_stub_ecc_buffer_length = pCtx->buffer_length;
+    cmox_stub_ecc_buffer = pCtx->pBuffer;
+    /* Curve arithmetic scratch (key material intermediates on target) */
+    memset(pCtx->pBuffer, ECC_MATH_SCRATCH, pCtx->buffer_length);
+    return (const ecc_curve_t *)impl;
+}
+
+static void _ecc_pub_key(const ecc_curve_t *pCurve, const uint8_t *pPrivKey, uint8_t *pPubKey) {
+    size_t i;
+
+    for (i = 0; i < pCurve->pub_key_length; i++) {
+        pPubKey[i] = pPrivKey[i % pCurve->priv_key_length] ^ ECC_PUB_KEY_MASK;
+    }
+}
+
+static void _ecc_signature(const ecc_curve_t *pCurve, const uint8_t *pPubKey, const uint8_t *pDigest,
+                           size_t digest_length, uint8_t *pSignature) {
+    size_t i;
+
+    for (i = 0; i < pCurve->sig_length; i++) {
+        pSignature[i] = pPubKey[i % pCurve->pub_key_length] ^ ((digest_length > 0) ? pDigest[i % digest_length] : 0U);
+    }
+}
+
+void cmox_ecc_construct(cmox_ecc_handle_t *P_pEccCtx, const cmox_math_funcs_t P_Math, uint8_t *P_pBuf, size_t P_BufLen) {
+    P_pEccCtx->math = P_Math;
+    P_pEccCtx->pBuffer = P_pBuf;
+    P_pEccCtx->buffer_length = P_BufLen;
+}
+
+void cmox_ecc_cleanup(cmox_ecc_handle_t *P_pEccCtx) {
+    memset(P_pEccCtx, 0, sizeof(*P_pEccCtx));
+}
+
+cmox_ecc_retval_t cmox_ecdsa_keyGen(cmox_ecc_handle_t *P_pEccCtx,
+                                    const cmox_ecc_impl_t P_CurveParams,
+                                    const uint8_t *P_pRandom,
+                                    size_t P_RandomLen,
+                                    uint8_t *P_pPrivKey,
+                                    size_t *P_pPrivKeyLen,
+                                    uint8_t *P_pPubKey,
+                                    size_t *P_pPubKeyLen) {
+    const ecc_curve_t *pCurve = _ecc_curve(P_pEccCtx, P_CurveParams);
+
+    if ((pCurve == NULL) || (P_RandomLen < pCurve->priv_key_length)) {
+        return CMOX_ECC_ERR_BAD_PARAMETERS;
+    }
+    memcpy(P_pPrivKey, P_pRandom, pCurve->priv_key_length);
+    cmox_stub_ecc_priv_key = P_pPrivKey;
+    _ecc_pub_key(pCurve, P_pPrivKey, P_pPubKey);
+    if (P_pPrivKeyLen != NULL) {
+        *P_pPrivKeyLen = pCurve->priv_key_length;
+    }
+    if (P_pPubKeyLen != NULL) {
+        *P_pPubKeyLen = pCurve->pub_key_length;
+    }
+    return CMOX_ECC_SUCCESS;
+}
+
+cmox_ecc_retval_t cmox_eddsa_keyGen(cmox_ecc_handle_t *P_pEccCtx,
+                                    const cmox_ecc_impl_t P_CurveParams,
+                                    const uint8_t *P_pRandom,
+                                    size_t P_RandomLen,
+                                    uint8_t *P_pPrivKey,
+                                    size_t *P_pPrivKeyLen,
+                                    uint8_t *P_pPubKey,
+                                    size_t *P_pPubKeyLen) {
+    return cmox_ecdsa_keyGen(P_pEccCtx, P_CurveParams, P_pRandom, P_RandomLen, P_pPrivKey, P_pPrivKeyLen,
+                             P_pPubKey, P_pPubKeyLen);
+}
+
+cmox_ecc_retval_t cmox_ecdsa_sign(cmox_ecc_handle_t *P_pEccCtx,
+                                  const cmox_ecc_impl_t P_CurveParams,
+                                  const uint8_t *P_pRandom,
+                                  size_t P_RandomLen,
+                                  const uint8_t *P_pPrivKey,
+                                  size_t P_PrivKeyLen,
+                                  const uint8_t *P_pDigest,
+                                  size_t P_DigestLen,
+                                  uint8_t *P_pSignature,
+                                  size_t *P_pSignatureLen) {
+    const ecc_curve_t *pCurve = _ecc_curve(P_pEccCtx, P_CurveParams);
+    uint8_t pub_key[132];
+
+    if ((pCurve == NULL) || (pCurve->sig_length == 0) || (P_PrivKeyLen != pCurve->priv_key_length)) {
+        return CMOX_ECC_ERR_BAD_PARAMETERS;
+    }
+    _ecc_pub_key(pCurve, P_pPrivKey, pub_key);
+    _ecc_signature(pCurve, pub_key, P_pDigest, P_DigestLen, P_pSignature);
+    if (P_pSignatureLen != NULL) {
+        *P_pSignatureLen = pCurve->sig_length;
+    }
+    return CMOX_ECC_SUCCESS;
+}
+
+cmox_ecc_retval_t cmox_eddsa_sign(cmox_ecc_handle_t *P_pEccCtx,
+                                  const cmox_ecc_impl_t P_CurveParams,
+                                  const uint8_t *P_pPrivKey,
+                                  size_t P_PrivKeyLen,
+                                  const uint8_t *P_pMessage,
+                                  size_t P_MessageLen,
+                                  uint8_t *P_pSignature,
+                                  size_t *P_pSignatureLen) {
+    return cmox_ecdsa_sign(P_pEccCtx, P_CurveParams, NULL, 0, P_pPrivKey, P_PrivKeyLen, P_pMessage, P_MessageLen,
+                           P_pSignature, P_pSignatureLen);
+}
+
+cmox_ecc_retval_t cmox_ecdsa_verify(cmox_ecc_handle_t *P_pEccCtx,
+                                    const cmox_ecc_impl_t P_CurveParams,
+                                    const uint8_t *P_pPubKey,
+                                    size_t P_PubKeyLen,
+                                    const uint8_t *P_pDigest,
+                                    size_t P_DigestLen,
+                                    const uint8_t *P_pSignature,
+                                    size_t P_SignatureLen,
+                                    uint32_t *P_pFaultCheck) {
+    const ecc_curve_t *pCurve = _ecc_curve(P_pEccCtx, P_CurveParams);
+    uint8_t signature[132];
+
+    if ((pCurve == NULL) || (pCurve->sig_length == 0) ||
+        (P_PubKeyLen != pCurve->pub_key_length) || (P_SignatureLen != pCurve->sig_length)) {
+        return CMOX_ECC_ERR_BAD_PARAMETERS;
+    }
+    _ecc_signature(pCurve, P_pPubKey, P_pDigest, P_DigestLen, signature);
+    if (memcmp(signature, P_pSignature, P_SignatureLen) != 0) {
+        return CMOX_ECC_AUTH_FAIL;
+    }
+    if (P_pFaultCheck != NULL) {
+        *P_pFaultCheck = CMOX_ECC_AUTH_SUCCESS;
+    }
+    return CMOX_ECC_AUTH_SUCCESS;
+}
+
+cmox_ecc_retval_t cmox_eddsa_verify(cmox_ecc_handle_t *P_pEccCtx,
+                                    const cmox_ecc_impl_t P_CurveParams,
+                                    const uint8_t *P_pPubKey,
+                                    size_t P_PubKeyLen,
+                                    const uint8_t *P_pMessage,
+                                    size_t P_MessageLen,
+                                    const uint8_t *P_pSignature,
+                                    size_t P_SignatureLen,
+                                    uint32_t *P_pFaultCheck) {
+    return cmox_ecdsa_verify(P_pEccCtx, P_CurveParams, P_pPubKey, P_PubKeyLen, P_pMessage, P_MessageLen,
+                             P_pSignature, P_SignatureLen, P_pFaultCheck);
+}
+
+cmox_ecc_retval_t cmox_ecdh(cmox_ecc_handle_t *P_pEccCtx,
+                            const cmox_ecc_impl_t P_CurveParams,
+                            const uint8_t *P_pPrivKey,
+                            size_t P_PrivKeyLen,
+                            const uint8_t *P_pPubKey,
+                            size_t P_PubKeyLen,
+                            uint8_t *P_pSharedSecret,
+                            size_t *P_pSharedSecretLen) {
+    const ecc_curve_t *pCurve = _ecc_curve(P_pEccCtx, P_CurveParams);
+    size_t i;
+
+    if ((pCurve == NULL) || (P_PrivKeyLen != pCurve->priv_key_length) || (P_PubKeyLen == 0)) {
+        return CMOX_ECC_ERR_BAD_PARAMETERS;
+    }
+    for (i = 0; i < pCurve->pub_key_length; i++) {
+        P_pSharedSecret[i] = P_pPrivKey[i % P_PrivKeyLen] ^ P_pPubKey[i % P_PubKeyLen];
+    }
+    if (P_pSharedSecretLen != NULL) {
+        *P_pSharedSecretLen = pCurve->pub_key_length;
+    }
+    return CMOX_ECC_SUCCESS;
+}
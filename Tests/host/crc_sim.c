@@ -0,0 +1,124 @@
+/* CRC calculation unit host model (see crc_sim.h) */
+
+#include "crc_sim.h"
+#include "stm32l4xx.h"
+#include <stddef.h>
+#include <string.h>
+
+CRC_TypeDef stub_crc;
+uint32_t stub_primask;
+
+uint32_t sim_crc_byte_writes;
+uint32_t sim_crc_word_writes;
+uint32_t sim_crc_restores;
+unsigned sim_crc_errors;
+
+static uint16_t sim_crc_state;
+static uint32_t sim_crc_irq_writes;
+static void (*sim_crc_irq_handler)(void);
+
+static uint32_t _sim_reverse(uint32_t value, uint8_t bits) {
+    return __RBIT(value) >> (32U - bits);
+}
+
+static void _sim_crc_data(uint32_t value, uint8_t size) {
+    uint8_t rev_in = (uint8_t)((stub_crc.CR & CRC_CR_REV_IN_Msk) >> CRC_CR_REV_IN_Pos);
+    uint8_t bits = (uint8_t)(size * 8U);
+    uint32_t data = 0;
+    uint8_t i;
+
+    /* - Input reversal by byte, half-word or word (whole value when narrower) */
+    if (rev_in == 0U) {
+        data = value;
+    } else {
+        uint8_t unit = (uint8_t)(8U << (rev_in - 1U));
+
+        if (unit > bits) {
+            unit = bits;
+        }
+        for (i = 0; i < bits; i = (uint8_t)(i + unit)) {
+            data |= _sim_reverse((value >> i) & (uint32_t)((1ULL << unit) - 1U), unit) << i;
+        }
+    }
+
+    /* - Most significant bit first, 16-bit polynomial */
+    for (i = bits; i > 0U; i--) {
+        uint8_t feedback = (uint8_t)(((sim_crc_state >> 15) ^ (data >> (i - 1U))) & 1U);
+
+        sim_crc_state = (uint16_t)(sim_crc_state << 1);
+        if (feedback) {
+            sim_crc_state ^= (uint16_t)stub_crc.POL;
+        }
+    }
+}
+
+void sim_crc_reset(void) {
+    memset(&stub_crc, 0, sizeof(stub_crc));
+    stub_crc.INIT = 0xFFFFFFFFU;
+    stub_crc.POL = 0x04C11DB7U;
+    sim_crc_state = 0xFFFF;
+    sim_crc_byte_writes = 0;
+    sim_crc_word_writes = 0;
+    sim_crc_restores = 0;
+    sim_crc_errors = 0;
+    sim_crc_irq_handler = NULL;
+    stub_primask = 0;
+}
+
+void sim_crc_irq(uint32_t write, void (*pHandler)(void)) {
+    sim_crc_irq_writes = write;
+    sim_crc_irq_handler = pHandler;
+}
+
+void stub_reg_write(volatile void *pReg, uint32_t value, uint8_t size) {
+    void (*pHandler)(void);
+
+    if (pReg == (volatile void *)&stub_crc.DR) {
+        _sim_crc_data(value, size);
+        if (size == 1U) {
+            sim_crc_byte_writes++;
+        } else {
+            sim_crc_word_writes++;
+        }
+        /* - Pending interrupt taken once unmasked */
+        if (sim_crc_irq_handler != NULL && sim_crc_irq_writes != 0U) {
+            sim_crc_irq_writes--;
+        }
+        if (sim_crc_irq_handler != NULL && sim_crc_irq_writes == 0U && stub_primask == 0U) {
+            pHandler = sim_crc_irq_handler;
+            sim_crc_irq_handler = NULL;
+            pHandler();
+        }
+    } else if (pReg == (volatile void *)&stub_crc.CR) {
+        if (size != 4U || ((value & CRC_CR_POLYSIZE_Msk) >> CRC_CR_POLYSIZE_Pos) != 0b01U) {
+            sim_crc_errors++;
+        }
+        if (value & CRC_CR_RESET) {
+            sim_crc_state = (uint16_t)stub_crc.INIT;
+            if ((uint16_t)stub_crc.INIT != 0xFFFFU) {
+                sim_crc_restores++;
+            }
+            value &= ~CRC_CR_RESET;
+        }
+        stub_crc.CR = value;
+    } else if (size == 4U) {
+        *(volatile uint32_t *)pReg = value;
+    } else if (size == 2U) {
+        *(volatile uint16_t *)pReg = (uint16_t)value;
+    } else {
+        *(volatile uint8_t *)pReg = (uint8_t)value;
+    }
+}
+
+uint32_t stub_reg_read(volatile void *pReg, uint8_t size) {
+    if (pReg == (volatile void *)&stub_crc.DR) {
+        return (stub_crc.CR & CRC_CR_REV_OUT_Msk) ? _sim_reverse(sim_crc_state, 16) : sim_crc_state;
+    }
+    if (size == 4U) {
+        return *(volatile uint32_t *)pReg;
+    }
+    if (size == 2U) {
+        return *(volatile uint16_t *)pReg;
+    }
+    return *(volatile uint8_t *)pReg;
+}
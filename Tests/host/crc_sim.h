@@ -0,0 +1,31 @@
+/* CRC calculation unit host model shared by the hardware CRC16 driver tests.
+ *
+ * The CRC register accesses of the driver (WRITE_REG / READ_REG, see
+ * stubs/stm32l4xx.h) are applied to a 16-bit polynomial unit model : 8-bit and
+ * 32-bit data register writes with the CR input reversal mode, output
+ * reversal of the data register reads, INIT loaded on CR RESET.
+ * An interrupt handler can be run between two data register writes, as long
+ * as PRIMASK is cleared. */
+#ifndef CRC_SIM_H
+#define CRC_SIM_H
+
+#include <stdint.h>
+
+/* Data register writes and unit state restores (RESET with INIT not at its
+ * default value) since the last sim_crc_reset */
+extern uint32_t sim_crc_byte_writes;
+extern uint32_t sim_crc_word_writes;
+extern uint32_t sim_crc_restores;
+
+/* Accesses the model does not support (other polynomial size, partial writes
+ * of control registers...) */
+extern unsigned sim_crc_errors;
+
+/* Registers and counters at their reset value */
+void sim_crc_reset(void);
+
+/* Run pHandler (once) right after the data register write number `write`
+ * (counted from this call), or later when PRIMASK is set at that point */
+void sim_crc_irq(uint32_t write, void (*pHandler)(void));
+
+#endif /* CRC_SIM_H */
@@ -0,0 +1,216 @@
+/* I2C host bus model (see i2c_sim.h) */
+
+#include "i2c_sim.h"
+#include "Drivers/delay_ms/delay_ms.h"
+#include <string.h>
+
+I2C_TypeDef stub_i2c1;
+uint32_t stub_primask;
+
+uint64_t sim_i2c_now_ns;
+uint32_t sim_i2c_byte_ns;
+uint32_t sim_i2c_poll_ns;
+uint8_t sim_i2c_host_bytes[SIM_I2C_BYTES_MAX];
+size_t sim_i2c_host_byte_count;
+unsigned sim_i2c_irqs;
+
+static uint8_t sim_i2c_response[SIM_I2C_BYTES_MAX];
+static size_t sim_i2c_response_length;
+static size_t sim_i2c_response_index;
+static uint64_t sim_i2c_bus_ns; /* End of the last byte on the bus */
+static uint64_t sim_i2c_deadline_ns;
+static uint8_t sim_i2c_nack;
+
+/* Interrupt driven read transfer */
+static uint8_t sim_i2c_it;         /* Transfer started under interrupt (RXDR served from the landed bytes) */
+static uint8_t sim_i2c_it_running; /* Bytes still shifted in */
+static uint8_t sim_i2c_it_pending; /* Event interrupt raised while masked */
+static size_t sim_i2c_it_landed;
+static uint32_t sim_i2c_it_nbytes; /* Bytes left in the NBYTES chunk */
+static uint64_t sim_i2c_it_next_ns; /* End of the next byte */
+
+void I2C1_EV_IRQHandler(void);
+
+static void _sim_i2c_byte(void) {
+    /* - Bytes back to back on the bus, the host waits for the next one */
+    if (sim_i2c_bus_ns < sim_i2c_now_ns) {
+        sim_i2c_bus_ns = sim_i2c_now_ns;
+    }
+    sim_i2c_bus_ns += sim_i2c_byte_ns;
+    sim_i2c_now_ns = sim_i2c_bus_ns;
+}
+
+static void _sim_i2c_irq(void) {
+    /* - Event interrupt taken once PRIMASK is cleared */
+    if (!sim_i2c_it_pending || stub_primask != 0U) {
+        return;
+    }
+    sim_i2c_it_pending = 0;
+    I2C1_EV_IRQHandler();
+    sim_i2c_irqs++;
+
+    /* - Flags cleared through ICR, TCR cleared by the NBYTES reload */
+    stub_i2c1.ISR &= ~(stub_i2c1.ICR & (I2C_ICR_NACKCF | I2C_ICR_STOPCF));
+    stub_i2c1.ICR = 0;
+    if (stub_i2c1.ISR & I2C_ISR_TCR) {
+        stub_i2c1.ISR &= ~I2C_ISR_TCR;
+        sim_i2c_it_nbytes = (stub_i2c1.CR2 & I2C_CR2_NBYTES_Msk) >> I2C_CR2_NBYTES_Pos;
+    }
+}
+
+static void _sim_i2c_it_byte(void) {
+    sim_i2c_now_ns = sim_i2c_it_next_ns;
+    sim_i2c_it_pending = 1;
+
+    /* - Address not acknowledged : STOP generated (AUTOEND) */
+    if (sim_i2c_nack) {
+        stub_i2c1.ISR |= I2C_ISR_NACKF | I2C_ISR_STOPF;
+        sim_i2c_it_running = 0;
+        return;
+    }
+
+    /* - Byte shifted in, end of the NBYTES chunk : reload or STOP */
+    sim_i2c_it_landed++;
+    stub_i2c1.ISR |= I2C_ISR_RXNE;
+    if (--sim_i2c_it_nbytes == 0) {
+        if (stub_i2c1.CR2 & I2C_CR2_RELOAD) {
+            stub_i2c1.ISR |= I2C_ISR_TCR;
+        } else {
+            stub_i2c1.ISR |= I2C_ISR_STOPF;
+            sim_i2c_it_running = 0;
+        }
+    }
+    sim_i2c_it_next_ns += sim_i2c_byte_ns;
+}
+
+static void _sim_i2c_advance(uint64_t duration_ns) {
+    uint64_t end_ns = sim_i2c_now_ns + duration_ns;
+
+    /* - Read transfer started with the reception interrupts enabled */
+    if (!sim_i2c_it_running && (stub_i2c1.CR1 & I2C_CR1_RXIE) && (stub_i2c1.CR2 & I2C_CR2_START)) {
+        stub_i2c1.CR2 &= ~I2C_CR2_START;
+        stub_i2c1.ISR = I2C_ISR_TXE;
+        stub_i2c1.ICR = 0;
+        sim_i2c_it = 1;
+        sim_i2c_it_running = 1;
+        sim_i2c_it_landed = 0;
+        sim_i2c_it_nbytes = (stub_i2c1.CR2 & I2C_CR2_NBYTES_Msk) >> I2C_CR2_NBYTES_Pos;
+        /* - Address byte, then the first data byte */
+        sim_i2c_it_next_ns = ((sim_i2c_bus_ns > sim_i2c_now_ns) ? sim_i2c_bus_ns : sim_i2c_now_ns) +
+                             (sim_i2c_nack ? 1U : 2U) * (uint64_t)sim_i2c_byte_ns;
+    }
+
+    /* - Bytes landed meanwhile, one event interrupt each */
+    while (sim_i2c_it_running && sim_i2c_it_next_ns <= end_ns) {
+        if (stub_i2c1.CR2 & I2C_CR2_STOP) {
+            /* - Transfer aborted by the host */
+            stub_i2c1.CR2 &= ~I2C_CR2_STOP;
+            sim_i2c_it_running = 0;
+            break;
+        }
+        _sim_i2c_it_byte();
+        _sim_i2c_irq();
+        sim_i2c_bus_ns = sim_i2c_now_ns;
+    }
+    sim_i2c_now_ns = end_ns;
+    _sim_i2c_irq();
+}
+
+void sim_i2c_reset(void) {
+    memset(&stub_i2c1, 0, sizeof(stub_i2c1));
+    stub_i2c1.ISR = I2C_ISR_TXE;
+    sim_i2c_now_ns = 0;
+    sim_i2c_byte_ns = 22500;
+    sim_i2c_poll_ns = 250;
+    sim_i2c_host_byte_count = 0;
+    sim_i2c_response_length = 0;
+    sim_i2c_response_index = 0;
+    sim_i2c_bus_ns = 0;
+    sim_i2c_deadline_ns = 0;
+    sim_i2c_nack = 0;
+    sim_i2c_it = 0;
+    sim_i2c_it_running = 0;
+    sim_i2c_it_pending = 0;
+    sim_i2c_irqs = 0;
+}
+
+void sim_i2c_cpu(uint64_t duration_ns) {
+    _sim_i2c_advance(duration_ns);
+}
+
+void sim_i2c_respond(const uint8_t *pFrame, size_t length) {
+    if (pFrame == NULL) {
+        /* - Address not acknowledged, STOP generated (AUTOEND) */
+        stub_i2c1.ISR = I2C_ISR_TXE | I2C_ISR_NACKF | I2C_ISR_STOPF;
+        sim_i2c_response_length = 0;
+    } else {
+        stub_i2c1.ISR = I2C_ISR_TXE | I2C_ISR_RXNE | I2C_ISR_TCR;
+        memcpy(sim_i2c_response, pFrame, length);
+        sim_i2c_response_length = length;
+    }
+    sim_i2c_nack = (pFrame == NULL);
+    sim_i2c_response_index = 0;
+    sim_i2c_it = 0;
+}
+
+void stub_reg_write(volatile void *pReg, uint32_t value, uint8_t size) {
+    if (pReg == (volatile void *)&stub_i2c1.TXDR) {
+        _sim_i2c_byte();
+        if (sim_i2c_host_byte_count < SIM_I2C_BYTES_MAX) {
+            sim_i2c_host_bytes[sim_i2c_host_byte_count++] = (uint8_t)value;
+        }
+    } else if (size == 4U) {
+        *(volatile uint32_t *)pReg = value;
+    } else if (size == 2U) {
+        *(volatile uint16_t *)pReg = (uint16_t)value;
+    } else {
+        *(volatile uint8_t *)pReg = (uint8_t)value;
+    }
+}
+
+uint32_t stub_reg_read(volatile void *pReg, uint8_t size) {
+    if (pReg == (volatile void *)&stub_i2c1.RXDR && sim_i2c_it) {
+        /* - Landed byte, RXNE cleared once all are read */
+        if (sim_i2c_response_index + 1U >= sim_i2c_it_landed) {
+            stub_i2c1.ISR &= ~I2C_ISR_RXNE;
+        }
+        if (sim_i2c_response_index >= sim_i2c_response_length) {
+            sim_i2c_response_index++;
+            return 0xFF;
+        }
+        return sim_i2c_response[sim_i2c_response_index++];
+    }
+    if (pReg == (volatile void *)&stub_i2c1.RXDR) {
+        _sim_i2c_byte();
+        /* - Bus released high past the end of the response */
+        if (sim_i2c_response_index >= sim_i2c_response_length) {
+            return 0xFF;
+        }
+        return sim_i2c_response[sim_i2c_response_index++];
+    }
+    if (size == 4U) {
+        return *(volatile uint32_t *)pReg;
+    }
+    if (size == 2U) {
+        return *(volatile uint16_t *)pReg;
+    }
+    return *(volatile uint8_t *)pReg;
+}
+
+/* ---------- Delay services used by the I2C PAL ---------- */
+
+void delay_ms_init(void) {
+}
+
+void delay_ms(uint16_t ms) {
+    _sim_i2c_advance((uint64_t)ms * 1000000);
+}
+
+void timeout_ms_start(uint16_t ms) {
+    sim_i2c_deadline_ns = sim_i2c_now_ns + (uint64_t)ms * 1000000;
+}
+
+uint8_t timeout_ms_get_status(void) {
+    _sim_i2c_advance(sim_i2c_poll_ns);
+    return sim_i2c_now_ns >= sim_i2c_deadline_ns;
+}
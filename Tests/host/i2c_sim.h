@@ -0,0 +1,43 @@
+/* I2C host bus model shared by the I2C driver and PAL tests.
+ *
+ * One target device on I2C1 : the bytes the driver writes to TXDR are
+ * recorded, read transfers are served from the queued device response
+ * (NACK when no response is queued). Each byte takes sim_i2c_byte_ns on the
+ * bus ; simulated time only advances in the RXDR / TXDR accesses, in the
+ * delay_ms / timeout_ms services (sim_i2c_poll_ns per timeout poll) and in
+ * sim_i2c_cpu (CPU work charged by the tests).
+ *
+ * A read started with the reception interrupts enabled (CR1 RXIE) runs in the
+ * background : each byte lands sim_i2c_byte_ns after the previous one, sets
+ * RXNE (TCR at the end of an NBYTES chunk with RELOAD, STOPF at the end of the
+ * transfer) and calls I2C1_EV_IRQHandler, deferred while PRIMASK is set.
+ * Setting CR2 STOP aborts the transfer. */
+#ifndef I2C_SIM_H
+#define I2C_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SIM_I2C_BYTES_MAX 1024
+
+extern uint64_t sim_i2c_now_ns;
+extern uint32_t sim_i2c_byte_ns;
+extern uint32_t sim_i2c_poll_ns;
+
+/* Bytes written by the host */
+extern uint8_t sim_i2c_host_bytes[SIM_I2C_BYTES_MAX];
+extern size_t sim_i2c_host_byte_count;
+
+/* Event interrupts taken */
+extern unsigned sim_i2c_irqs;
+
+/* Time origin, no response queued, 400 kHz bus (9 clocks per byte) */
+void sim_i2c_reset(void);
+
+/* Response served to the next read transfer (NULL : NACK) */
+void sim_i2c_respond(const uint8_t *pFrame, size_t length);
+
+/* Advance time by CPU work (interrupt driven transfer running meanwhile) */
+void sim_i2c_cpu(uint64_t duration_ns);
+
+#endif /* I2C_SIM_H */
@@ -0,0 +1,244 @@
+/* ST1Wire host bus model (see st1wire_sim.h) */
+
+#include "st1wire_sim.h"
+#include "Drivers/delay_ms/delay_ms.h"
+#include "Drivers/delay_us/delay_us.h"
+#include <string.h>
+
+#define SIM_SEGMENTS_MAX 18
+#define SIM_PULSES_MAX 16
+
+typedef struct {
+    /* Host side */
+    uint8_t host_out;
+    uint8_t host_odr;
+    uint8_t level;
+    uint64_t last_rise_ns;
+    uint64_t last_fall_ns;
+    uint64_t high_ns;
+    uint32_t falls;
+    uint64_t pulses[SIM_PULSES_MAX][2]; /* High, low widths since the last release */
+    size_t pulse_count;
+    /* Device side */
+    uint8_t attached;
+    uint8_t ack;
+    uint32_t long_ns, short_ns, ack_wait_ns, ack_ns;
+    uint8_t queue[SIM_BYTES_MAX];
+    size_t queue_head, queue_count;
+    uint64_t script_start_ns;
+    uint64_t script_ns[SIM_SEGMENTS_MAX]; /* Segment durations, odd segments low */
+    size_t script_count;
+} sim_pin_t;
+
+GPIO_TypeDef stub_gpioa;
+GPIO_TypeDef stub_gpiob;
+uint32_t stub_primask;
+
+uint64_t sim_now_ns;
+uint32_t sim_poll_ns;
+uint8_t sim_host_bytes[SIM_PINS][SIM_BYTES_MAX];
+size_t sim_host_byte_count[SIM_PINS];
+unsigned sim_timing_errors;
+sim_edge_t sim_trace[SIM_TRACE_MAX];
+size_t sim_trace_count;
+
+static sim_pin_t sim_pins[SIM_PINS];
+static uint64_t sim_deadline_ns;
+static uint64_t sim_expect_long_ns, sim_expect_short_ns;
+
+static uint8_t _sim_device_low(const sim_pin_t *pPin) {
+    uint64_t t;
+    size_t i;
+
+    if (pPin->script_count == 0 || sim_now_ns < pPin->script_start_ns) {
+        return 0;
+    }
+    t = sim_now_ns - pPin->script_start_ns;
+    for (i = 0; i < pPin->script_count; i++) {
+        if (t < pPin->script_ns[i]) {
+            return (i & 1) != 0;
+        }
+        t -= pPin->script_ns[i];
+    }
+    return 0;
+}
+
+static void _sim_script_segment(sim_pin_t *pPin, uint64_t duration_ns) {
+    pPin->script_ns[pPin->script_count++] = duration_ns;
+}
+
+static void _sim_check_width(uint64_t width_ns, uint64_t expected_ns) {
+    if (sim_expect_long_ns != 0 && width_ns != expected_ns) {
+        sim_timing_errors++;
+    }
+}
+
+static void _sim_release(uint8_t index) {
+    sim_pin_t *pPin = &sim_pins[index];
+    uint64_t(*pBits)[2];
+    uint8_t byte = 0;
+    size_t i;
+
+    pPin->script_count = 0;
+    pPin->script_start_ns = sim_now_ns;
+
+    if (pPin->attached && pPin->falls >= 9 && pPin->pulse_count >= 9) {
+        /* - Host byte : sync bit then 8 bits MSB first ('1' : long high) */
+        pBits = &pPin->pulses[pPin->pulse_count - 9];
+        _sim_check_width(pBits[0][1], sim_expect_long_ns);
+        for (i = 1; i < 9; i++) {
+            byte = (uint8_t)((byte << 1) | (pBits[i][0] > pBits[i][1]));
+            _sim_check_width(pBits[i][0], (pBits[i][0] > pBits[i][1]) ? sim_expect_long_ns : sim_expect_short_ns);
+            _sim_check_width(pBits[i][1], (pBits[i][0] > pBits[i][1]) ? sim_expect_short_ns : sim_expect_long_ns);
+        }
+        if (sim_host_byte_count[index] < SIM_BYTES_MAX) {
+            sim_host_bytes[index][sim_host_byte_count[index]++] = byte;
+        }
+        if (pPin->ack) {
+            _sim_script_segment(pPin, pPin->ack_wait_ns);
+            _sim_script_segment(pPin, pPin->ack_ns);
+        }
+    } else if (pPin->attached && pPin->falls >= 1 && pPin->queue_count > 0) {
+        /* - Host sync bit : answer the next queued byte */
+        byte = pPin->queue[pPin->queue_head++];
+        pPin->queue_count--;
+        for (i = 0; i < 8; i++) {
+            if (byte & (0x80 >> i)) {
+                _sim_script_segment(pPin, pPin->long_ns);
+                _sim_script_segment(pPin, pPin->short_ns);
+            } else {
+                _sim_script_segment(pPin, pPin->short_ns);
+                _sim_script_segment(pPin, pPin->long_ns);
+            }
+        }
+    }
+    pPin->falls = 0;
+    pPin->pulse_count = 0;
+}
+
+static void _sim_apply(void) {
+    uint32_t bsrr = stub_gpioa.BSRR;
+    uint32_t idr = 0;
+    sim_pin_t *pPin;
+    uint8_t i, out, odr, level;
+
+    /* - Bit set / reset register applied to the output data register */
+    stub_gpioa.ODR = (stub_gpioa.ODR | (bsrr & 0xFFFF)) & ~(bsrr >> 16);
+    stub_gpioa.BSRR = 0;
+
+    for (i = 0; i < SIM_PINS; i++) {
+        pPin = &sim_pins[i];
+        out = ((stub_gpioa.MODER >> (i * 2)) & 0b11) == 0b01;
+        odr = (stub_gpioa.ODR >> i) & 1;
+
+        /* - Host edges while driving the line */
+        if ((pPin->host_out || out) && odr != pPin->host_odr) {
+            if (odr == 0) {
+                pPin->high_ns = sim_now_ns - pPin->last_rise_ns;
+                pPin->last_fall_ns = sim_now_ns;
+                pPin->falls++;
+            } else {
+                if (pPin->pulse_count == SIM_PULSES_MAX) {
+                    memmove(pPin->pulses[0], pPin->pulses[1], sizeof(pPin->pulses) - sizeof(pPin->pulses[0]));
+                    pPin->pulse_count--;
+                }
+                pPin->pulses[pPin->pulse_count][0] = pPin->high_ns;
+                pPin->pulses[pPin->pulse_count][1] = sim_now_ns - pPin->last_fall_ns;
+                pPin->pulse_count++;
+                pPin->last_rise_ns = sim_now_ns;
+            }
+        } else if (!pPin->host_out && out && odr) {
+            pPin->last_rise_ns = sim_now_ns;
+        }
+        pPin->host_odr = odr;
+        if (pPin->host_out && !out) {
+            _sim_release(i);
+        }
+        pPin->host_out = out;
+
+        /* - Open drain lines with pull-up */
+        level = !(out && !odr) && !_sim_device_low(pPin);
+        if (level != pPin->level) {
+            pPin->level = level;
+            if (sim_trace_count < SIM_TRACE_MAX) {
+                sim_trace[sim_trace_count++] = (sim_edge_t){sim_now_ns, i, level};
+            }
+        }
+        idr |= (uint32_t)level << i;
+    }
+    stub_gpioa.IDR = idr;
+}
+
+static void _sim_step(uint64_t duration_ns) {
+    _sim_apply();
+    sim_now_ns += duration_ns;
+    _sim_apply();
+}
+
+void sim_reset(void) {
+    uint8_t i;
+
+    memset(&stub_gpioa, 0, sizeof(stub_gpioa));
+    memset(sim_pins, 0, sizeof(sim_pins));
+    memset(sim_host_byte_count, 0, sizeof(sim_host_byte_count));
+    sim_now_ns = 0;
+    sim_poll_ns = 250;
+    sim_deadline_ns = 0;
+    sim_timing_errors = 0;
+    sim_trace_count = 0;
+    sim_expect_long_ns = 0;
+    sim_expect_short_ns = 0;
+    for (i = 0; i < SIM_PINS; i++) {
+        sim_pins[i].level = 1;
+        sim_device_timing(i, 14, 4, 4, 14);
+    }
+    stub_gpioa.IDR = 0xFFFF;
+}
+
+void sim_expect_timing(uint32_t long_us, uint32_t short_us) {
+    sim_expect_long_ns = (uint64_t)long_us * 1000;
+    sim_expect_short_ns = (uint64_t)short_us * 1000;
+}
+
+void sim_device_attach(uint8_t pin, uint8_t ack) {
+    sim_pins[pin].attached = 1;
+    sim_pins[pin].ack = ack;
+}
+
+void sim_device_queue(uint8_t pin, const uint8_t *pBytes, size_t length) {
+    sim_pin_t *pPin = &sim_pins[pin];
+
+    memmove(pPin->queue, &pPin->queue[pPin->queue_head], pPin->queue_count);
+    pPin->queue_head = 0;
+    memcpy(&pPin->queue[pPin->queue_count], pBytes, length);
+    pPin->queue_count += length;
+}
+
+void sim_device_timing(uint8_t pin, uint32_t long_us, uint32_t short_us, uint32_t ack_wait_us, uint32_t ack_us) {
+    sim_pins[pin].long_ns = long_us * 1000;
+    sim_pins[pin].short_ns = short_us * 1000;
+    sim_pins[pin].ack_wait_ns = ack_wait_us * 1000;
+    sim_pins[pin].ack_ns = ack_us * 1000;
+}
+
+/* ---------- Delay services used by the ST1Wire platform layer ---------- */
+
+void delay_us_init(void) {
+}
+
+void delay_ms_init(void) {
+}
+
+void delay_us(uint16_t us) {
+    _sim_step((uint64_t)us * 1000);
+}
+
+void timeout_us_start(uint16_t us) {
+    _sim_apply();
+    sim_deadline_ns = sim_now_ns + (uint64_t)us * 1000;
+}
+
+uint8_t timeout_us_get_status(void) {
+    _sim_step(sim_poll_ns);
+    return sim_now_ns >= sim_deadline_ns;
+}
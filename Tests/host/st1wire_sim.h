@@ -0,0 +1,52 @@
+/* ST1Wire host bus model shared by the ST1Wire driver tests.
+ *
+ * GPIOA lines with a pull-up, driven by the platform layer through the BSRR
+ * and MODER registers and by simulated target devices. Simulated time only
+ * advances in the delay_us / timeout_us services the platform layer relies
+ * on : a delay advances it by its duration, each timeout poll by
+ * sim_poll_ns (i.e. the duration of one iteration of a polling loop). */
+#ifndef ST1WIRE_SIM_H
+#define ST1WIRE_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SIM_PINS 16
+#define SIM_BYTES_MAX 64
+#define SIM_TRACE_MAX 8192
+
+typedef struct {
+    uint64_t time_ns;
+    uint8_t pin;
+    uint8_t level;
+} sim_edge_t;
+
+extern uint64_t sim_now_ns;
+extern uint32_t sim_poll_ns;
+
+/* Bytes sent by the host, decoded by the devices from the pulse widths */
+extern uint8_t sim_host_bytes[SIM_PINS][SIM_BYTES_MAX];
+extern size_t sim_host_byte_count[SIM_PINS];
+
+/* Host pulses not matching the expected long / short widths */
+extern unsigned sim_timing_errors;
+
+/* Line level changes (host and devices) */
+extern sim_edge_t sim_trace[SIM_TRACE_MAX];
+extern size_t sim_trace_count;
+
+/* Time origin, released lines, no device attached, 2-Contact timings */
+void sim_reset(void);
+
+/* Host pulse widths checked by the devices (us) */
+void sim_expect_timing(uint32_t long_us, uint32_t short_us);
+
+/* Device on a GPIOA pin : acknowledges the host bytes when ack is set and
+ * answers each host sync bit with the next queued byte (silent when empty) */
+void sim_device_attach(uint8_t pin, uint8_t ack);
+void sim_device_queue(uint8_t pin, const uint8_t *pBytes, size_t length);
+
+/* Device pulse widths (us) : transmitted bits, wait before ack, ack pulse */
+void sim_device_timing(uint8_t pin, uint32_t long_us, uint32_t short_us, uint32_t ack_wait_us, uint32_t ack_us);
+
+#endif /* ST1WIRE_SIM_H */
@@ -0,0 +1,8 @@
+/* Host stand-in for the "Drivers/i2c/i2c.h" include path of the I2C driver :
+ * forwards to the platform I2C driver (-I Platform/Drivers/i2c) */
+#ifndef STUB_DRIVERS_I2C_H
+#define STUB_DRIVERS_I2C_H
+
+#include <I2C.h>
+
+#endif /* STUB_DRIVERS_I2C_H */
@@ -0,0 +1,296 @@
+/* Host stand-in for the CMOX cryptographic library : the subset of the API used
+ * by the platform abstraction layer, implemented in cmox_stub.c on top of a
+ * reference AES / SHA (OpenSSL libcrypto) */
+#ifndef CMOX_CRYPTO_H
+#define CMOX_CRYPTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ---------------------------------------------------------------- DRBG --- */
+
+typedef uint32_t cmox_drbg_retval_t;
+#define CMOX_DRBG_SUCCESS 0x00040000u
+#define CMOX_DRBG_ERR_BAD_PARAMETER 0x00040001u
+#define CMOX_DRBG_ERR_BAD_ENTROPY_SIZE 0x00040003u
+
+typedef const void *cmox_ctr_drbg_impl_t;
+extern cmox_ctr_drbg_impl_t CMOX_CTR_DRBG_AES256;
+
+typedef struct {
+    cmox_ctr_drbg_impl_t impl;
+} cmox_drbg_handle_t;
+
+typedef struct {
+    cmox_drbg_handle_t super;
+    uint8_t key[32];
+    uint8_t v[16];
+    uint32_t reseed_counter;
+    uint32_t instantiated;
+} cmox_ctr_drbg_handle_t;
+
+cmox_drbg_handle_t *cmox_ctr_drbg_construct(cmox_ctr_drbg_handle_t *P_pThis, cmox_ctr_drbg_impl_t P_impl);
+cmox_drbg_retval_t cmox_drbg_init(cmox_drbg_handle_t *P_pThis,
+                                  const uint8_t *P_pEntropy,
+                                  size_t P_EntropyLen,
+                                  const uint8_t *P_pPersonalization,
+                                  size_t P_PersonalizationLen,
+                                  const uint8_t *P_pNonce,
+                                  size_t P_NonceLen);
+cmox_drbg_retval_t cmox_drbg_reseed(cmox_drbg_handle_t *P_pThis,
+                                    const uint8_t *P_pEntropy,
+                                    size_t P_EntropyLen,
+                                    const uint8_t *P_pAdditionalInput,
+                                    size_t P_AdditionalInputLen);
+cmox_drbg_retval_t cmox_drbg_generate(cmox_drbg_handle_t *P_pThis,
+                                      const uint8_t *P_pAdditionalInput,
+                                      size_t P_AdditionalInputLen,
+                                      uint8_t *P_pOutput,
+                                      size_t P_OutputLen);
+cmox_drbg_retval_t cmox_drbg_cleanup(cmox_drbg_handle_t *P_pThis);
+
+/* ---------------------------------------------------------------- Hash --- */
+
+typedef uint32_t cmox_hash_retval_t;
+#define CMOX_HASH_SUCCESS 0x00020000u
+#define CMOX_HASH_ERR_BAD_PARAMETER 0x00020002u
+#define CMOX_HASH_ERR_BAD_OPERATION 0x00020003u
+
+#define CMOX_SHA256_SIZE 32u
+
+typedef const void *cmox_hash_algo_t;
+extern cmox_hash_algo_t CMOX_SHA256_ALGO;
+
+/* Hash state is held by value : handles can be snapshot and restored with memcpy */
+typedef struct {
+    cmox_hash_algo_t algo;
+    uint32_t state[8];
+    uint64_t length;
+    uint8_t block[64];
+    uint32_t block_length;
+    size_t tag_length;
+} cmox_hash_handle_t;
+
+typedef struct {
+    cmox_hash_handle_t super;
+} cmox_sha256_handle_t;
+typedef cmox_sha256_handle_t cmox_sha1_handle_t;
+typedef cmox_sha256_handle_t cmox_sha512_handle_t;
+typedef cmox_sha256_handle_t cmox_sha3_handle_t;
+
+cmox_hash_handle_t *cmox_sha256_construct(cmox_sha256_handle_t *P_pThis);
+cmox_hash_retval_t cmox_hash_init(cmox_hash_handle_t *P_pThis);
+cmox_hash_retval_t cmox_hash_setTagLen(cmox_hash_handle_t *P_pThis, size_t P_tagLen);
+cmox_hash_retval_t cmox_hash_append(cmox_hash_handle_t *P_pThis, const uint8_t *P_pInputMessage, size_t P_inputMessageLen);
+cmox_hash_retval_t cmox_hash_generateTag(cmox_hash_handle_t *P_pThis, uint8_t *P_pDigest, size_t *P_pDigestLen);
+cmox_hash_retval_t cmox_hash_cleanup(cmox_hash_handle_t *P_pThis);
+cmox_hash_retval_t cmox_hash_compute(cmox_hash_algo_t P_algo,
+                                     const uint8_t *P_pPlaintext,
+                                     size_t P_plaintextLen,
+                                     uint8_t *P_pDigest,
+                                     const size_t P_expectedDigestLen,
+                                     size_t *P_pComputedDigestLen);
+
+/* ----------------------------------------------------------------- MAC --- */
+
+typedef uint32_t cmox_mac_retval_t;
+#define CMOX_MAC_SUCCESS 0x00030000u
+#define CMOX_MAC_ERR_BAD_PARAMETER 0x00030001u
+#define CMOX_MAC_AUTH_SUCCESS 0x0003C726u
+#define CMOX_MAC_AUTH_FAIL 0x00036E1Eu
+
+typedef const void *cmox_mac_algo_t;
+extern cmox_mac_algo_t CMOX_HMAC_SHA256_ALGO;
+extern cmox_mac_algo_t CMOX_CMAC_AESSMALL_ALGO;
+
+cmox_mac_retval_t cmox_mac_compute(cmox_mac_algo_t P_algo,
+                                   const uint8_t *P_pInput,
+                                   size_t P_inputLen,
+                                   const uint8_t *P_pKey,
+                                   size_t P_keyLen,
+                                   const uint8_t *P_pCustomData,
+                                   size_t P_customDataLen,
+                                   uint8_t *P_pTag,
+                                   size_t P_expectedTagLen,
+                                   size_t *P_pComputedTagLen);
+
+cmox_mac_retval_t cmox_mac_verify(cmox_mac_algo_t P_algo,
+                                  const uint8_t *P_pInput,
+                                  size_t P_inputLen,
+                                  const uint8_t *P_pKey,
+                                  size_t P_keyLen,
+                                  const uint8_t *P_pCustomData,
+                                  size_t P_customDataLen,
+                                  const uint8_t *P_pExpectedTag,
+                                  size_t P_tagLen);
+
+/* -------------------------------------------------------------- Cipher --- */
+
+typedef uint32_t cmox_cipher_retval_t;
+#define CMOX_CIPHER_SUCCESS 0x00010000u
+#define CMOX_CIPHER_ERR_BAD_PARAMETER 0x00010001u
+#define CMOX_CIPHER_ERR_BAD_OPERATION 0x00010003u
+
+typedef const void *cmox_cipher_algo_t;
+typedef const void *cmox_ecb_impl_t;
+extern cmox_cipher_algo_t CMOX_AESSMALL_CBC_ENC_ALGO, CMOX_AESSMALL_CBC_DEC_ALGO;
+extern cmox_cipher_algo_t CMOX_AESSMALL_ECB_ENC_ALGO, CMOX_AESSMALL_ECB_DEC_ALGO;
+extern cmox_ecb_impl_t CMOX_AESSMALL_ECB_ENC, CMOX_AESSMALL_ECB_DEC;
+
+/* Single block AES handle : the key is held by value */
+typedef struct {
+    cmox_ecb_impl_t impl;
+    uint8_t key[32];
+    size_t key_length;
+    uint32_t keyed;
+} cmox_cipher_handle_t;
+
+typedef struct {
+    cmox_cipher_handle_t super;
+} cmox_ecb_handle_t;
+
+cmox_cipher_handle_t *cmox_ecb_construct(cmox_ecb_handle_t *P_pThis, cmox_ecb_impl_t P_impl);
+cmox_cipher_retval_t cmox_cipher_init(cmox_cipher_handle_t *P_pThis);
+cmox_cipher_retval_t cmox_cipher_setKey(cmox_cipher_handle_t *P_pThis, const uint8_t *P_pKey, size_t P_keyLen);
+cmox_cipher_retval_t cmox_cipher_append(cmox_cipher_handle_t *P_pThis,
+                                        const uint8_t *P_pInput,
+                                        size_t P_inputLen,
+                                        uint8_t *P_pOutput,
+                                        size_t *P_pOutputLen);
+cmox_cipher_retval_t cmox_cipher_cleanup(cmox_cipher_handle_t *P_pThis);
+cmox_cipher_retval_t cmox_cipher_encrypt(cmox_cipher_algo_t P_algo,
+                                         const uint8_t *P_pInput,
+                                         size_t P_inputLen,
+                                         const uint8_t *P_pKey,
+                                         size_t P_keyLen,
+                                         const uint8_t *P_pIv,
+                                         size_t P_ivLen,
+                                         uint8_t *P_pOutput,
+                                         size_t *P_pOutputLen);
+cmox_cipher_retval_t cmox_cipher_decrypt(cmox_cipher_algo_t P_algo,
+                                         const uint8_t *P_pInput,
+                                         size_t P_inputLen,
+                                         const uint8_t *P_pKey,
+                                         size_t P_keyLen,
+                                         const uint8_t *P_pIv,
+                                         size_t P_ivLen,
+                                         uint8_t *P_pOutput,
+                                         size_t *P_pOutputLen);
+
+/* ----------------------------------------------------------------- ECC --- */
+
+typedef uint32_t cmox_ecc_retval_t;
+#define CMOX_ECC_SUCCESS 0x00060000u
+#define CMOX_ECC_ERR_BAD_PARAMETERS 0x00060001u
+#define CMOX_ECC_ERR_WRONG_RANDOM 0x00060006u
+#define CMOX_ECC_AUTH_SUCCESS 0x0006C726u
+#define CMOX_ECC_AUTH_FAIL 0x00066E1Eu
+
+typedef const void *cmox_math_funcs_t;
+extern cmox_math_funcs_t CMOX_MATH_FUNCS_SMALL, CMOX_MATH_FUNCS_FAST;
+
+typedef const void *cmox_ecc_impl_t;
+extern cmox_ecc_impl_t CMOX_ECC_SECP256R1_LOWMEM, CMOX_ECC_SECP256R1_HIGHMEM;
+extern cmox_ecc_impl_t CMOX_ECC_SECP384R1_LOWMEM, CMOX_ECC_SECP384R1_HIGHMEM;
+extern cmox_ecc_impl_t CMOX_ECC_SECP521R1_LOWMEM, CMOX_ECC_SECP521R1_HIGHMEM;
+extern cmox_ecc_impl_t CMOX_ECC_BPP256R1_LOWMEM, CMOX_ECC_BPP256R1_HIGHMEM;
+extern cmox_ecc_impl_t CMOX_ECC_BPP384R1_LOWMEM, CMOX_ECC_BPP384R1_HIGHMEM;
+extern cmox_ecc_impl_t CMOX_ECC_BPP512R1_LOWMEM, CMOX_ECC_BPP512R1_HIGHMEM;
+extern cmox_ecc_impl_t CMOX_ECC_CURVE25519;
+extern cmox_ecc_impl_t CMOX_ECC_ED25519_OPT_LOWMEM, CMOX_ECC_ED25519_OPT_HIGHMEM;
+
+#define CMOX_ECC_SECP256R1_PRIVKEY_LEN 32u
+#define CMOX_ECC_SECP384R1_PRIVKEY_LEN 48u
+#define CMOX_ECC_SECP521R1_PRIVKEY_LEN 66u
+#define CMOX_ECC_BPP256R1_PRIVKEY_LEN 32u
+#define CMOX_ECC_BPP384R1_PRIVKEY_LEN 48u
+#define CMOX_ECC_BPP512R1_PRIVKEY_LEN 64u
+#define CMOX_ECC_CURVE25519_PRIVKEY_LEN 32u
+#define CMOX_ECC_ED25519_PRIVKEY_LEN 64u
+#define CMOX_ECC_SECP256R1_PUBKEY_LEN 64u
+#define CMOX_ECC_SECP384R1_PUBKEY_LEN 96u
+#define CMOX_ECC_SECP521R1_PUBKEY_LEN 132u
+#define CMOX_ECC_BPP256R1_PUBKEY_LEN 64u
+#define CMOX_ECC_BPP384R1_PUBKEY_LEN 96u
+#define CMOX_ECC_BPP512R1_PUBKEY_LEN 128u
+#define CMOX_ECC_CURVE25519_PUBKEY_LEN 32u
+#define CMOX_ECC_ED25519_PUBKEY_LEN 32u
+#define CMOX_ECC_SECP256R1_SIG_LEN 64u
+#define CMOX_ECC_SECP384R1_SIG_LEN 96u
+#define CMOX_ECC_SECP521R1_SIG_LEN 132u
+#define CMOX_ECC_BPP256R1_SIG_LEN 64u
+#define CMOX_ECC_BPP384R1_SIG_LEN 96u
+#define CMOX_ECC_BPP512R1_SIG_LEN 128u
+#define CMOX_ECC_ED25519_SIG_LEN 64u
+
+/* ECC handle : records the construction parameters (no curve arithmetic) */
+typedef struct {
+    cmox_math_funcs_t math;
+    uint8_t *pBuffer;
+    size_t buffer_length;
+} cmox_ecc_handle_t;
+
+void cmox_ecc_construct(cmox_ecc_handle_t *P_pEccCtx, const cmox_math_funcs_t P_Math, uint8_t *P_pBuf, size_t P_BufLen);
+void cmox_ecc_cleanup(cmox_ecc_handle_t *P_pEccCtx);
+cmox_ecc_retval_t cmox_ecdsa_keyGen(cmox_ecc_handle_t *P_pEccCtx,
+                                    const cmox_ecc_impl_t P_CurveParams,
+                                    const uint8_t *P_pRandom,
+                                    size_t P_RandomLen,
+                                    uint8_t *P_pPrivKey,
+                                    size_t *P_pPrivKeyLen,
+                                    uint8_t *P_pPubKey,
+                                    size_t *P_pPubKeyLen);
+cmox_ecc_retval_t cmox_eddsa_keyGen(cmox_ecc_handle_t *P_pEccCtx,
+                                    const cmox_ecc_impl_t P_CurveParams,
+                                    const uint8_t *P_pRandom,
+                                    size_t P_RandomLen,
+                                    uint8_t *P_pPrivKey,
+                                    size_t *P_pPrivKeyLen,
+                                    uint8_t *P_pPubKey,
+                                    size_t *P_pPubKeyLen);
+cmox_ecc_retval_t cmox_ecdsa_sign(cmox_ecc_handle_t *P_pEccCtx,
+                                  const cmox_ecc_impl_t P_CurveParams,
+                                  const uint8_t *P_pRandom,
+                                  size_t P_RandomLen,
+                                  const uint8_t *P_pPrivKey,
+                                  size_t P_PrivKeyLen,
+                                  const uint8_t *P_pDigest,
+                                  size_t P_DigestLen,
+                                  uint8_t *P_pSignature,
+                                  size_t *P_pSignatureLen);
+cmox_ecc_retval_t cmox_eddsa_sign(cmox_ecc_handle_t *P_pEccCtx,
+                                  const cmox_ecc_impl_t P_CurveParams,
+                                  const uint8_t *P_pPrivKey,
+                                  size_t P_PrivKeyLen,
+                                  const uint8_t *P_pMessage,
+                                  size_t P_MessageLen,
+                                  uint8_t *P_pSignature,
+                                  size_t *P_pSignatureLen);
+cmox_ecc_retval_t cmox_ecdsa_verify(cmox_ecc_handle_t *P_pEccCtx,
+                                    const cmox_ecc_impl_t P_CurveParams,
+                                    const uint8_t *P_pPubKey,
+                                    size_t P_PubKeyLen,
+                                    const uint8_t *P_pDigest,
+                                    size_t P_DigestLen,
+                                    const uint8_t *P_pSignature,
+                                    size_t P_SignatureLen,
+                                    uint32_t *P_pFaultCheck);
+cmox_ecc_retval_t cmox_eddsa_verify(cmox_ecc_handle_t *P_pEccCtx,
+                                    const cmox_ecc_impl_t P_CurveParams,
+                                    const uint8_t *P_pPubKey,
+                                    size_t P_PubKeyLen,
+                                    const uint8_t *P_pMessage,
+                                    size_t P_MessageLen,
+                                    const uint8_t *P_pSignature,
+                                    size_t P_SignatureLen,
+                                    uint32_t *P_pFaultCheck);
+cmox_ecc_retval_t cmox_ecdh(cmox_ecc_handle_t *P_pEccCtx,
+                            const cmox_ecc_impl_t P_CurveParams,
+                            const uint8_t *P_pPrivKey,
+                            size_t P_PrivKeyLen,
+                            const uint8_t *P_pPubKey,
+                            size_t P_PubKeyLen,
+                            uint8_t *P_pSharedSecret,
+                            size_t *P_pSharedSecretLen);
+
+#endif /* CMOX_CRYPTO_H */
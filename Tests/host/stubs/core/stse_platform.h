@@ -0,0 +1,79 @@
+/* Host stand-in for the STSELib core platform header: PLAT_* types and the
+ * return codes used by the platform abstraction layer */
+#ifndef STSE_PLATFORM_H
+#define STSE_PLATFORM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define STSE_CONF_USE_I2C
+
+#define PLAT_UI8 uint8_t
+#define PLAT_UI16 uint16_t
+#define PLAT_UI32 uint32_t
+#define PLAT_UI64 uint64_t
+#define PLAT_I8 int8_t
+#define PLAT_I16 int16_t
+#define PLAT_I32 int32_t
+
+typedef enum {
+    STSE_OK = 0,
+    STSE_PLATFORM_SERVICES_INIT_ERROR,
+    STSE_PLATFORM_BUFFER_ERR,
+    STSE_PLATFORM_BUS_ACK_ERROR,
+    STSE_PLATFORM_INVALID_PARAMETER,
+    STSE_PLATFORM_ECC_VERIFY_ERROR,
+    STSE_PLATFORM_ECC_SIGN_ERROR,
+    STSE_PLATFORM_HASH_ERROR,
+    STSE_PLATFORM_AES_CMAC_COMPUTE_ERROR,
+    STSE_PLATFORM_AES_CMAC_VERIFY_ERROR,
+    STSE_PLATFORM_AES_CBC_ENCRYPT_ERROR,
+    STSE_PLATFORM_AES_CBC_DECRYPT_ERROR,
+    STSE_PLATFORM_AES_ECB_ENCRYPT_ERROR,
+    STSE_PLATFORM_AES_ECB_DECRYPT_ERROR,
+    STSE_PLATFORM_ECC_GENERATE_KEY_PAIR_ERROR,
+    STSE_PLATFORM_ECC_ECDH_ERROR,
+    STSE_PLATFORM_KEYWRAP_ERROR,
+    STSE_PLATFORM_HKDF_ERROR,
+    STSE_PLATFORM_GENERATE_RANDOM_ERROR,
+    STSE_PLATFORM_CRYPTO_INIT_ERROR,
+    STSE_CORE_FRAME_CRC_ERROR
+} stse_ReturnCode_t;
+
+/* Platform services implemented by the platform abstraction layer */
+void stse_platform_Delay_ms(PLAT_UI32 delay_val);
+void stse_platform_timeout_ms_start(PLAT_UI16 timeout_val);
+PLAT_UI8 stse_platform_timeout_ms_get_status(void);
+
+stse_ReturnCode_t stse_platform_hmac_sha256_extract(PLAT_UI8 *pSalt, PLAT_UI16 salt_length,
+                                                    PLAT_UI8 *pInput_keying_material, PLAT_UI16 input_keying_material_length,
+                                                    PLAT_UI8 *pPseudorandom_key, PLAT_UI16 pseudorandom_key_expected_length);
+stse_ReturnCode_t stse_platform_hmac_sha256_expand(PLAT_UI8 *pPseudorandom_key, PLAT_UI16 pseudorandom_key_length,
+                                                   PLAT_UI8 *pInfo, PLAT_UI16 info_length,
+                                                   PLAT_UI8 *pOutput_keying_material, PLAT_UI16 output_keying_material_length);
+
+stse_ReturnCode_t stse_platform_aes_cmac_init(const PLAT_UI8 *pKey, PLAT_UI16 key_length, PLAT_UI16 exp_tag_size);
+stse_ReturnCode_t stse_platform_aes_cmac_append(PLAT_UI8 *pInput, PLAT_UI16 length);
+stse_ReturnCode_t stse_platform_aes_cmac_compute_finish(PLAT_UI8 *pTag, PLAT_UI8 *pTag_length);
+stse_ReturnCode_t stse_platform_aes_cmac_verify_finish(PLAT_UI8 *pTag);
+stse_ReturnCode_t stse_platform_aes_cmac_compute(const PLAT_UI8 *pPayload, PLAT_UI16 payload_length,
+                                                 const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                                 PLAT_UI16 exp_tag_size, PLAT_UI8 *pTag, PLAT_UI16 *pTag_length);
+stse_ReturnCode_t stse_platform_aes_cmac_verify(const PLAT_UI8 *pPayload, PLAT_UI16 payload_length,
+                                                const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                                const PLAT_UI8 *pTag, PLAT_UI16 tag_length);
+stse_ReturnCode_t stse_platform_aes_cbc_enc(const PLAT_UI8 *pPlaintext, PLAT_UI16 plaintext_length,
+                                            PLAT_UI8 *pInitial_value, const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                            PLAT_UI8 *pEncryptedtext, PLAT_UI16 *pEncryptedtext_length);
+stse_ReturnCode_t stse_platform_aes_cbc_dec(const PLAT_UI8 *pEncryptedtext, PLAT_UI16 encryptedtext_length,
+                                            PLAT_UI8 *pInitial_value, const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                            PLAT_UI8 *pPlaintext, PLAT_UI16 *pPlaintext_length);
+stse_ReturnCode_t stse_platform_aes_ecb_enc(const PLAT_UI8 *pPlaintext, PLAT_UI16 plaintext_length,
+                                            const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                            PLAT_UI8 *pEncryptedtext, PLAT_UI16 *pEncryptedtext_length);
+stse_ReturnCode_t stse_platform_aes_ecb_dec(const PLAT_UI8 *pEncryptedtext, PLAT_UI16 encryptedtext_length,
+                                            const PLAT_UI8 *pKey, PLAT_UI16 key_length,
+                                            PLAT_UI8 *pPlaintext, PLAT_UI16 *pPlaintext_length);
+
+#endif /* STSE_PLATFORM_H */
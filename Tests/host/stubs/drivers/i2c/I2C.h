@@ -0,0 +1,8 @@
+/* Host stand-in for the "drivers/i2c/I2C.h" include path of the I2C PAL :
+ * forwards to the platform I2C driver (-I Platform/Drivers/i2c) */
+#ifndef STUB_DRIVERS_I2C_PAL_H
+#define STUB_DRIVERS_I2C_PAL_H
+
+#include <I2C.h>
+
+#endif /* STUB_DRIVERS_I2C_PAL_H */
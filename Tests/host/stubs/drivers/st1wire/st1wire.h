@@ -0,0 +1,8 @@
+/* Host stand-in for the STSELib "drivers/st1wire/st1wire.h" include path :
+ * forwards to the platform ST1Wire driver (-I Platform/Drivers/st1wire) */
+#ifndef STUB_DRIVERS_ST1WIRE_H
+#define STUB_DRIVERS_ST1WIRE_H
+
+#include <st1wire.h>
+
+#endif /* STUB_DRIVERS_ST1WIRE_H */
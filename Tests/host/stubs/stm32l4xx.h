@@ -0,0 +1,150 @@
+/* Host stand-in for the STM32L4 device header */
+#ifndef STM32L4XX_H
+#define STM32L4XX_H
+
+#include <stdint.h>
+
+#define __PACKED __attribute__((packed))
+
+/* Interrupt masking (single context on the host : PRIMASK is only tracked) */
+extern uint32_t stub_primask;
+static inline uint32_t __get_PRIMASK(void) { return stub_primask; }
+static inline void __set_PRIMASK(uint32_t primask) { stub_primask = primask; }
+static inline void __disable_irq(void) { stub_primask = 1U; }
+static inline void __enable_irq(void) { stub_primask = 0U; }
+static inline void __WFI(void) {}
+
+/* Main stack pointer : address of a local of a callee that is not inlined,
+ * i.e. just below the caller frame (pointer sized on the host) */
+static __attribute__((noinline, unused)) uintptr_t __get_MSP(void) {
+    volatile uint8_t stack_mark = 0;
+
+    return (uintptr_t)&stack_mark;
+}
+
+static inline uint32_t __RBIT(uint32_t value) {
+    uint32_t result = 0;
+    uint8_t i;
+
+    for (i = 0; i < 32U; i++) {
+        result = (result << 1) | ((value >> i) & 1U);
+    }
+    return result;
+}
+
+/* Register accessors : routed to the peripheral models of the tests linking
+ * them (see crc_sim.h), plain memory accesses otherwise */
+void stub_reg_write(volatile void *pReg, uint32_t value, uint8_t size);
+uint32_t stub_reg_read(volatile void *pReg, uint8_t size);
+#define WRITE_REG(REG, VAL) stub_reg_write(&(REG), (uint32_t)(VAL), sizeof(REG))
+#define READ_REG(REG) stub_reg_read(&(REG), sizeof(REG))
+#define SET_BIT(REG, BIT) WRITE_REG((REG), READ_REG(REG) | (BIT))
+#define CLEAR_BIT(REG, BIT) WRITE_REG((REG), READ_REG(REG) & ~(BIT))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK) WRITE_REG((REG), (READ_REG(REG) & ~(CLEARMASK)) | (SETMASK))
+
+/* GPIO ports (plain memory : BSRR writes are applied by the test bus model) */
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFR[2];
+    volatile uint32_t BRR;
+    volatile uint32_t ASCR;
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef stub_gpioa;
+extern GPIO_TypeDef stub_gpiob;
+#define GPIOA (&stub_gpioa)
+#define GPIOB (&stub_gpiob)
+#define GPIO_ODR_OD0_Pos 0U
+
+/* CRC calculation unit */
+typedef struct {
+    volatile uint32_t DR;
+    volatile uint32_t IDR;
+    volatile uint32_t CR;
+    uint32_t RESERVED2;
+    volatile uint32_t INIT;
+    volatile uint32_t POL;
+} CRC_TypeDef;
+
+extern CRC_TypeDef stub_crc;
+#define CRC (&stub_crc)
+#define CRC_CR_RESET 0x1U
+#define CRC_CR_POLYSIZE_Pos 3U
+#define CRC_CR_POLYSIZE_Msk (0x3U << CRC_CR_POLYSIZE_Pos)
+#define CRC_CR_REV_IN_Pos 5U
+#define CRC_CR_REV_IN_Msk (0x3U << CRC_CR_REV_IN_Pos)
+#define CRC_CR_REV_OUT_Pos 7U
+#define CRC_CR_REV_OUT_Msk (0x1U << CRC_CR_REV_OUT_Pos)
+
+/* I2C controller (ISR refreshed and RXDR / TXDR accesses served by the test
+ * bus model, see i2c_sim.h) */
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t OAR1;
+    volatile uint32_t OAR2;
+    volatile uint32_t TIMINGR;
+    volatile uint32_t TIMEOUTR;
+    volatile uint32_t ISR;
+    volatile uint32_t ICR;
+    volatile uint32_t PECR;
+    volatile uint32_t RXDR;
+    volatile uint32_t TXDR;
+} I2C_TypeDef;
+
+extern I2C_TypeDef stub_i2c1;
+#define I2C1 (&stub_i2c1)
+#define I2C_CR1_PE (0x1U << 0)
+#define I2C_CR1_RXIE (0x1U << 2)
+#define I2C_CR1_NACKIE (0x1U << 4)
+#define I2C_CR1_STOPIE (0x1U << 5)
+#define I2C_CR1_TCIE (0x1U << 6)
+#define I2C_CR1_ERRIE (0x1U << 7)
+#define I2C_CR1_DNF_Pos 8U
+#define I2C_CR1_ANFOFF_Pos 12U
+#define I2C_CR1_NOSTRETCH_Pos 17U
+#define I2C_CR2_SADD_Pos 0U
+#define I2C_CR2_RD_WRN_Pos 10U
+#define I2C_CR2_ADD10_Pos 11U
+#define I2C_CR2_START (0x1U << 13)
+#define I2C_CR2_STOP (0x1U << 14)
+#define I2C_CR2_NBYTES_Pos 16U
+#define I2C_CR2_NBYTES_Msk (0xFFU << I2C_CR2_NBYTES_Pos)
+#define I2C_CR2_RELOAD (0x1U << 24)
+#define I2C_CR2_AUTOEND_Pos 25U
+#define I2C_TIMINGR_SCLL_Pos 0U
+#define I2C_TIMINGR_SCLH_Pos 8U
+#define I2C_TIMINGR_SDADEL_Pos 16U
+#define I2C_TIMINGR_SCLDEL_Pos 20U
+#define I2C_TIMINGR_PRESC_Pos 28U
+#define I2C_ISR_TXE (0x1U << 0)
+#define I2C_ISR_RXNE (0x1U << 2)
+#define I2C_ISR_NACKF (0x1U << 4)
+#define I2C_ISR_STOPF (0x1U << 5)
+#define I2C_ISR_TCR (0x1U << 7)
+#define I2C_ICR_NACKCF (0x1U << 4)
+#define I2C_ICR_STOPCF (0x1U << 5)
+#define I2C_ICR_BERRCF (0x1U << 8)
+#define I2C_ICR_ARLOCF (0x1U << 9)
+#define I2C_ICR_OVRCF (0x1U << 10)
+
+/* Interrupt controller (no-op) */
+typedef enum {
+    I2C1_EV_IRQn = 31,
+    I2C1_ER_IRQn = 32
+} IRQn_Type;
+
+static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) {
+    (void)IRQn;
+    (void)priority;
+}
+static inline void NVIC_EnableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+
+#endif /* STM32L4XX_H */
@@ -0,0 +1,6 @@
+/* Host stand-in for Application/stse_conf.h : configuration knobs under test
+ * are passed on the compiler command line by the Makefile */
+#ifndef STSE_CONF_H
+#define STSE_CONF_H
+
+#endif /* STSE_CONF_H */
@@ -0,0 +1,43 @@
+/* Host stand-in for the STSELib umbrella header */
+#ifndef STSELIB_H
+#define STSELIB_H
+
+#include "core/stse_platform.h"
+
+typedef enum {
+    STSE_ECC_KT_NIST_P_256,
+    STSE_ECC_KT_NIST_P_384,
+    STSE_ECC_KT_NIST_P_521,
+    STSE_ECC_KT_BP_P_256,
+    STSE_ECC_KT_BP_P_384,
+    STSE_ECC_KT_BP_P_512,
+    STSE_ECC_KT_CURVE25519,
+    STSE_ECC_KT_ED25519
+} stse_ecc_key_type_t;
+
+/* ECC platform services implemented by the platform abstraction layer */
+stse_ReturnCode_t stse_platform_ecc_verify(stse_ecc_key_type_t key_type, const PLAT_UI8 *pPubKey,
+                                           PLAT_UI8 *pDigest, PLAT_UI16 digestLen, PLAT_UI8 *pSignature);
+stse_ReturnCode_t stse_platform_ecc_sign(stse_ecc_key_type_t key_type, PLAT_UI8 *pPrivKey,
+                                         PLAT_UI8 *pDigest, PLAT_UI16 digestLen, PLAT_UI8 *pSignature);
+stse_ReturnCode_t stse_platform_ecc_ecdh(stse_ecc_key_type_t key_type, const PLAT_UI8 *pPubKey,
+                                         const PLAT_UI8 *pPrivKey, PLAT_UI8 *pSharedSecret);
+stse_ReturnCode_t stse_platform_ecc_generate_key_pair(stse_ecc_key_type_t key_type, PLAT_UI8 *pPrivKey,
+                                                      PLAT_UI8 *pPubKey);
+
+typedef enum {
+    STSE_SHA_1,
+    STSE_SHA_224,
+    STSE_SHA_256,
+    STSE_SHA_384,
+    STSE_SHA_512,
+    STSE_SHA3_256,
+    STSE_SHA3_384,
+    STSE_SHA3_512
+} stse_hash_algorithm_t;
+
+stse_ReturnCode_t stse_platform_hash_compute(stse_hash_algorithm_t hash_algo,
+                                             PLAT_UI8 *pPayload, PLAT_UI16 payload_length,
+                                             PLAT_UI8 *pHash, PLAT_UI16 *hash_length);
+
+#endif /* STSELIB_H */
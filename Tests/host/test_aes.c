@@ -0,0 +1,253 @@
+/* AES host tests :
+ * - NIST SP 800-38B appendix D CMAC examples (AES-128 / AES-256) through the
+ *   one-shot, key handle, streaming context and legacy streaming services
+ * - NIST SP 800-38A F.2.1 / F.2.5 CBC examples through the one-shot and key
+ *   handle services, and the fused encrypt-then-MAC / verify-then-decrypt
+ * - Session bound key cache : hits, isolation and zeroization on close */
+
+#include "stse_platform_aes.h"
+#include "test_host.h"
+
+extern unsigned long cmox_stub_aes_key_schedules;
+
+static const char nist_key128[] = "2b7e151628aed2a6abf7158809cf4f3c";
+static const char nist_key256[] = "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4";
+static const char nist_message[] =
+    "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+    "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+static const char nist_iv[] = "000102030405060708090a0b0c0d0e0f";
+
+typedef struct {
+    const char *pKey;
+    PLAT_UI16 message_length;
+    const char *pTag;
+} cmac_vector_t;
+
+/* SP 800-38B D.1 (AES-128) and D.3 (AES-256), examples 1 to 4 */
+static const cmac_vector_t cmac_vectors[] = {
+    {nist_key128, 0, "bb1d6929e95937287fa37d129b756746"},
+    {nist_key128, 16, "070a16b46b4d4144f79bdd9dd04a287c"},
+    {nist_key128, 40, "dfa66747de9ae63030ca32611497c827"},
+    {nist_key128, 64, "51f0bebf7e3b9d92fc49741779363cfe"},
+    {nist_key256, 0, "028962f61b7bf89efc6b551f4667d983"},
+    {nist_key256, 16, "28a7023f452e8f82bd4bf28d8c37c35c"},
+    {nist_key256, 40, "aaf3d8f1de5640c232f5b169b9c911e6"},
+    {nist_key256, 64, "e1992190549f6ed5696a2c056c315410"},
+};
+
+typedef struct {
+    const char *pKey;
+    const char *pCiphertext;
+} cbc_vector_t;
+
+/* SP 800-38A F.2.1 (CBC-AES128.Encrypt) and F.2.5 (CBC-AES256.Encrypt) */
+static const cbc_vector_t cbc_vectors[] = {
+    {nist_key128,
+     "7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2"
+     "73bed6b8e3c1743b7116e69e222295163ff1caa1681fac09120eca307586e1a7"},
+    {nist_key256,
+     "f58c4c04d6e5f1ba779eabfb5f7bfbd69cfc4e967edb808d679f777bc6702c7d"
+     "39f23369a9d9bacfa530e26304231461b2eb05e2c39be9fcda6c19078c6a9d1b"},
+};
+
+static uint8_t message[64];
+
+static void test_cmac(const cmac_vector_t *pVector) {
+    uint8_t key[32], expected[16], tag[16];
+    PLAT_UI16 key_length = (PLAT_UI16)test_hex_decode(pVector->pKey, key, sizeof(key));
+    PLAT_UI16 tag_length = sizeof(tag);
+    PLAT_UI8 ctx_tag_length;
+    stse_platform_aes_key_t aes_key;
+    stse_platform_aes_cmac_ctx_t ctx;
+    PLAT_UI16 i;
+
+    test_hex_decode(pVector->pTag, expected, sizeof(expected));
+
+    /* - One-shot services */
+    TEST_CHECK(stse_platform_aes_cmac_compute(message, pVector->message_length, key, key_length, 16, tag, &tag_length) == STSE_OK);
+    TEST_CHECK(tag_length == 16U);
+    TEST_CHECK_MEM(tag, expected, sizeof(tag));
+    TEST_CHECK(stse_platform_aes_cmac_verify(message, pVector->message_length, key, key_length, expected, 16) == STSE_OK);
+    tag[0] = expected[0] ^ 0x01;
+    TEST_CHECK(stse_platform_aes_cmac_verify(message, pVector->message_length, key, key_length, tag, 16) ==
+               STSE_PLATFORM_AES_CMAC_VERIFY_ERROR);
+
+    /* - Key handle */
+    TEST_CHECK(stse_platform_aes_key_init(&aes_key, key, key_length) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_key_cmac_compute(&aes_key, message, pVector->message_length, 8, tag, &tag_length) == STSE_OK);
+    TEST_CHECK(tag_length == 8U);
+    TEST_CHECK_MEM(tag, expected, 8U);
+    TEST_CHECK(stse_platform_aes_key_cmac_verify(&aes_key, message, pVector->message_length, expected, 16) == STSE_OK);
+
+    /* - Streaming context, message appended one byte at a time */
+    TEST_CHECK(stse_platform_aes_cmac_ctx_init_with_key(&ctx, &aes_key, 16) == STSE_OK);
+    for (i = 0; i < pVector->message_length; i++) {
+        TEST_CHECK(stse_platform_aes_cmac_ctx_append(&ctx, &message[i], 1) == STSE_OK);
+    }
+    TEST_CHECK(stse_platform_aes_cmac_ctx_compute_finish(&ctx, tag, &ctx_tag_length) == STSE_OK);
+    TEST_CHECK(ctx_tag_length == 16U);
+    TEST_CHECK_MEM(tag, expected, sizeof(tag));
+    stse_platform_aes_key_clear(&aes_key);
+
+    /* - Legacy streaming API, message appended in two chunks */
+    TEST_CHECK(stse_platform_aes_cmac_init(key, key_length, 16) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_cmac_append(message, pVector->message_length / 2U) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_cmac_append(&message[pVector->message_length / 2U],
+                                             pVector->message_length - (pVector->message_length / 2U)) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_cmac_verify_finish(expected) == STSE_OK);
+}
+
+static void test_cbc(const cbc_vector_t *pVector) {
+    uint8_t key[32], iv[16], expected[64], out[64], back[64];
+    PLAT_UI16 key_length = (PLAT_UI16)test_hex_decode(pVector->pKey, key, sizeof(key));
+    PLAT_UI16 out_length = sizeof(out);
+    PLAT_UI16 back_length = sizeof(back);
+    stse_platform_aes_key_t aes_key;
+
+    test_hex_decode(nist_iv, iv, sizeof(iv));
+    test_hex_decode(pVector->pCiphertext, expected, sizeof(expected));
+
+    /* - One-shot services */
+    TEST_CHECK(stse_platform_aes_cbc_enc(message, sizeof(message), iv, key, key_length, out, &out_length) == STSE_OK);
+    TEST_CHECK(out_length == sizeof(message));
+    TEST_CHECK_MEM(out, expected, sizeof(expected));
+    TEST_CHECK(stse_platform_aes_cbc_dec(expected, sizeof(expected), iv, key, key_length, back, &back_length) == STSE_OK);
+    TEST_CHECK_MEM(back, message, sizeof(message));
+
+    /* - Key handle, in place decryption */
+    TEST_CHECK(stse_platform_aes_key_init(&aes_key, key, key_length) == STSE_OK);
+    out_length = sizeof(out);
+    memset(out, 0, sizeof(out));
+    TEST_CHECK(stse_platform_aes_key_cbc_enc(&aes_key, message, sizeof(message), iv, out, &out_length) == STSE_OK);
+    TEST_CHECK_MEM(out, expected, sizeof(expected));
+    out_length = sizeof(out);
+    TEST_CHECK(stse_platform_aes_key_cbc_dec(&aes_key, out, sizeof(out), iv, out, &out_length) == STSE_OK);
+    TEST_CHECK_MEM(out, message, sizeof(message));
+    stse_platform_aes_key_clear(&aes_key);
+}
+
+static void test_cbc_cmac(void) {
+    uint8_t key[16], iv[16], header[5] = {0x01, 0x02, 0x03, 0x04, 0x05};
+    uint8_t ciphertext[64], plaintext[64], tag[16], expected_tag[16], mac_input[sizeof(header) + 64];
+    PLAT_UI16 length = sizeof(ciphertext);
+    PLAT_UI16 expected_tag_length = sizeof(expected_tag);
+    PLAT_UI8 tag_length;
+    stse_platform_aes_key_t aes_key;
+    stse_platform_aes_cmac_ctx_t ctx;
+
+    test_hex_decode(nist_key128, key, sizeof(key));
+    test_hex_decode(nist_iv, iv, sizeof(iv));
+    TEST_CHECK(stse_platform_aes_key_init(&aes_key, key, sizeof(key)) == STSE_OK);
+
+    /* - Encrypt-then-MAC over header || ciphertext */
+    TEST_CHECK(stse_platform_aes_cmac_ctx_init_with_key(&ctx, &aes_key, 16) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_cmac_ctx_append(&ctx, header, sizeof(header)) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_key_cbc_enc_cmac(&aes_key, &ctx, message, sizeof(message), iv, ciphertext, &length,
+                                                  tag, &tag_length) == STSE_OK);
+    test_hex_decode(cbc_vectors[0].pCiphertext, mac_input, sizeof(mac_input));
+    TEST_CHECK_MEM(ciphertext, mac_input, sizeof(ciphertext));
+    memcpy(mac_input, header, sizeof(header));
+    memcpy(&mac_input[sizeof(header)], ciphertext, sizeof(ciphertext));
+    TEST_CHECK(stse_platform_aes_cmac_compute(mac_input, sizeof(mac_input), key, sizeof(key), 16, expected_tag,
+                                              &expected_tag_length) == STSE_OK);
+    TEST_CHECK(tag_length == 16U);
+    TEST_CHECK_MEM(tag, expected_tag, sizeof(tag));
+
+    /* - Verify-then-decrypt, then a tampered tag leaves no plaintext */
+    length = sizeof(plaintext);
+    TEST_CHECK(stse_platform_aes_cmac_ctx_init_with_key(&ctx, &aes_key, 16) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_cmac_ctx_append(&ctx, header, sizeof(header)) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_key_cmac_verify_cbc_dec(&aes_key, &ctx, ciphertext, sizeof(ciphertext), iv, tag,
+                                                         plaintext, &length) == STSE_OK);
+    TEST_CHECK_MEM(plaintext, message, sizeof(message));
+
+    tag[15] ^= 0x80;
+    length = sizeof(plaintext);
+    TEST_CHECK(stse_platform_aes_cmac_ctx_init_with_key(&ctx, &aes_key, 16) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_cmac_ctx_append(&ctx, header, sizeof(header)) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_key_cmac_verify_cbc_dec(&aes_key, &ctx, ciphertext, sizeof(ciphertext), iv, tag,
+                                                         plaintext, &length) == STSE_PLATFORM_AES_CMAC_VERIFY_ERROR);
+    memset(mac_input, 0, sizeof(plaintext));
+    TEST_CHECK_MEM(plaintext, mac_input, sizeof(plaintext));
+    stse_platform_aes_key_clear(&aes_key);
+}
+
+static void test_key_cache(void) {
+    static const int session_a, session_b;
+    uint8_t key[16], tag[16];
+    PLAT_UI16 tag_length = sizeof(tag);
+    unsigned long schedules;
+
+    test_hex_decode(nist_key128, key, sizeof(key));
+
+    /* - No bound session : every call expands the key */
+    schedules = cmox_stub_aes_key_schedules;
+    TEST_CHECK(stse_platform_aes_cmac_compute(message, 16, key, sizeof(key), 16, tag, &tag_length) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_cmac_compute(message, 16, key, sizeof(key), 16, tag, &tag_length) == STSE_OK);
+    TEST_CHECK(cmox_stub_aes_key_schedules - schedules == 2U);
+
+    /* - Bound session : key expanded once (encryption + decryption schedules), then hit */
+    stse_platform_aes_key_cache_open(&session_a);
+    schedules = cmox_stub_aes_key_schedules;
+    TEST_CHECK(stse_platform_aes_cmac_compute(message, 16, key, sizeof(key), 16, tag, &tag_length) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_cmac_verify(message, 16, key, sizeof(key), tag, 16) == STSE_OK);
+    TEST_CHECK(stse_platform_aes_cmac_compute(message, 40, key, sizeof(key), 16, tag, &tag_length) == STSE_OK);
+    TEST_CHECK(cmox_stub_aes_key_schedules - schedules == 2U);
+
+    /* - A key differing by one bit misses (entries matched on the key digest) */
+    key[15] ^= 0x01;
+    schedules = cmox_stub_aes_key_schedules;
+    TEST_CHECK(stse_platform_aes_cmac_compute(message, 16, key, sizeof(key), 16, tag, &tag_length) == STSE_OK);
+    TEST_CHECK(cmox_stub_aes_key_schedules - schedules == 2U);
+    key[15] ^= 0x01;
+
+    /* - Another session does not share session A keys */
+    stse_platform_aes_key_cache_open(&session_b);
+    schedules = cmox_stub_aes_key_schedules;
+    TEST_CHECK(stse_platform_aes_cmac_compute(message, 16, key, sizeof(key), 16, tag, &tag_length) == STSE_OK);
+    TEST_CHECK(cmox_stub_aes_key_schedules - schedules == 2U);
+
+    /* - Closing session B unbinds it : calls fall back to per call expansion */
+    stse_platform_aes_key_cache_close(&session_b);
+    schedules = cmox_stub_aes_key_schedules;
+    TEST_CHECK(stse_platform_aes_cmac_compute(message, 16, key, sizeof(key), 16, tag, &tag_length) == STSE_OK);
+    TEST_CHECK(cmox_stub_aes_key_schedules - schedules == 1U);
+
+    /* - Reopening session A still hits its keys until it is closed */
+    stse_platform_aes_key_cache_open(&session_a);
+    schedules = cmox_stub_aes_key_schedules;
+    TEST_CHECK(stse_platform_aes_cmac_compute(message, 16, key, sizeof(key), 16, tag, &tag_length) == STSE_OK);
+    TEST_CHECK(cmox_stub_aes_key_schedules - schedules == 0U);
+    stse_platform_aes_key_cache_close(&session_a);
+    stse_platform_aes_key_cache_open(&session_a);
+    TEST_CHECK(stse_platform_aes_cmac_compute(message, 16, key, sizeof(key), 16, tag, &tag_length) == STSE_OK);
+    TEST_CHECK(cmox_stub_aes_key_schedules - schedules == 2U);
+
+    stse_platform_aes_key_cache_flush();
+}
+
+int main(void) {
+    size_t i;
+
+    test_hex_decode(nist_message, message, sizeof(message));
+    for (i = 0; i < sizeof(cmac_vectors) / sizeof(cmac_vectors[0]); i++) {
+        test_cmac(&cmac_vectors[i]);
+    }
+    for (i = 0; i < sizeof(cbc_vectors) / sizeof(cbc_vectors[0]); i++) {
+        test_cbc(&cbc_vectors[i]);
+    }
+    test_cbc_cmac();
+    test_key_cache();
+
+    /* - Same known answers through the session key cache */
+    stse_platform_aes_key_cache_open(message);
+    for (i = 0; i < sizeof(cmac_vectors) / sizeof(cmac_vectors[0]); i++) {
+        test_cmac(&cmac_vectors[i]);
+    }
+    for (i = 0; i < sizeof(cbc_vectors) / sizeof(cbc_vectors[0]); i++) {
+        test_cbc(&cbc_vectors[i]);
+    }
+    stse_platform_aes_key_cache_close(message);
+
+    return test_report("test_aes");
+}
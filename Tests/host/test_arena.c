@@ -0,0 +1,119 @@
+/* Crypto arena host tests :
+ * - stack-ordered acquire / release, block alignment and zeroization
+ * - release refused for any block but the last acquired one
+ * - arena sized for STSE_PLATFORM_ARENA_ECC_ENGINES engines held at the same
+ *   time, engines released in reverse construction order
+ * - interrupt mask restored by acquire / release */
+
+#include "stse_platform_arena.h"
+#include "stse_platform_drbg.h"
+#include "stse_platform_ecc.h"
+#include "stse_platform_hash.h"
+#include "test_host.h"
+
+uint32_t stub_primask;
+
+stse_ReturnCode_t stse_platform_drbg_generate(stse_platform_drbg_id_t drbg_id, PLAT_UI8 *pOutput, PLAT_UI32 length) {
+    memset(pOutput, 0x5A, length);
+    return STSE_OK;
+}
+
+static int test_is_zero(const PLAT_UI8 *pBuffer, size_t length) {
+    while (length-- > 0) {
+        if (*pBuffer++ != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void test_stack_order(void) {
+    PLAT_UI8 *pFirst, *pSecond, *pThird;
+    PLAT_UI8 foreign[8];
+
+    pFirst = stse_platform_arena_acquire(STSE_PLATFORM_ECC_MATH_BUFFER_SIZE);
+    pSecond = stse_platform_arena_acquire(STSE_PLATFORM_ARENA_ECC_RANDOM_SIZE);
+    pThird = stse_platform_arena_acquire(13);
+    TEST_CHECK(pFirst != NULL && pSecond != NULL && pThird != NULL);
+    TEST_CHECK(((uintptr_t)pFirst % STSE_PLATFORM_ARENA_ALIGN) == 0);
+    TEST_CHECK(((uintptr_t)pSecond % STSE_PLATFORM_ARENA_ALIGN) == 0);
+    TEST_CHECK(((uintptr_t)pThird % STSE_PLATFORM_ARENA_ALIGN) == 0);
+    TEST_CHECK(pSecond >= pFirst + STSE_PLATFORM_ECC_MATH_BUFFER_SIZE);
+    TEST_CHECK(pThird >= pSecond + STSE_PLATFORM_ARENA_ECC_RANDOM_SIZE);
+    TEST_CHECK(stub_primask == 0);
+
+    memset(pSecond, 0xA5, STSE_PLATFORM_ARENA_ECC_RANDOM_SIZE);
+    memset(pThird, 0xA5, 13);
+
+    /* - Only the last acquired block is released */
+    TEST_CHECK(stse_platform_arena_release(pFirst) == STSE_PLATFORM_INVALID_PARAMETER);
+    TEST_CHECK(stse_platform_arena_release(pSecond) == STSE_PLATFORM_INVALID_PARAMETER);
+    TEST_CHECK(stse_platform_arena_release(pThird + 8) == STSE_PLATFORM_INVALID_PARAMETER);
+    TEST_CHECK(stse_platform_arena_release(foreign) == STSE_PLATFORM_INVALID_PARAMETER);
+    TEST_CHECK(stse_platform_arena_release(NULL) == STSE_PLATFORM_INVALID_PARAMETER);
+    TEST_CHECK(stse_platform_arena_release(pThird) == STSE_OK);
+    TEST_CHECK(stse_platform_arena_release(pThird) == STSE_PLATFORM_INVALID_PARAMETER);
+    TEST_CHECK(stse_platform_arena_release(pSecond) == STSE_OK);
+    TEST_CHECK(test_is_zero(pSecond, STSE_PLATFORM_ARENA_ECC_RANDOM_SIZE + 13));
+
+    /* - Released space is handed out again */
+    TEST_CHECK(stse_platform_arena_acquire(STSE_PLATFORM_ARENA_ECC_RANDOM_SIZE) == pSecond);
+    TEST_CHECK(stse_platform_arena_release(pSecond) == STSE_OK);
+    TEST_CHECK(stse_platform_arena_release(pFirst) == STSE_OK);
+    TEST_CHECK(stse_platform_arena_in_use() == 0);
+    TEST_CHECK(stse_platform_arena_release(pFirst) == STSE_PLATFORM_INVALID_PARAMETER);
+    TEST_CHECK(stub_primask == 0);
+}
+
+static void test_exhaustion(void) {
+    PLAT_UI8 *pBlock;
+
+    TEST_CHECK(stse_platform_arena_acquire(0xFFFFFFFFUL) == NULL);
+    TEST_CHECK(stse_platform_arena_acquire(STSE_PLATFORM_ARENA_SIZE + 1U) == NULL);
+    TEST_CHECK(stse_platform_arena_in_use() == 0);
+
+    pBlock = stse_platform_arena_acquire(STSE_PLATFORM_ARENA_SIZE - STSE_PLATFORM_ARENA_ALIGN);
+    TEST_CHECK(pBlock != NULL);
+    TEST_CHECK(stse_platform_arena_acquire(1) == NULL);
+    TEST_CHECK(stse_platform_arena_release(pBlock) == STSE_OK);
+    TEST_CHECK(stse_platform_arena_high_water() >= STSE_PLATFORM_ARENA_SIZE);
+    stse_platform_arena_reset_high_water();
+    TEST_CHECK(stse_platform_arena_high_water() == 0);
+}
+
+static void test_engines(void) {
+    stse_platform_ecc_engine_t engines[STSE_PLATFORM_ARENA_ECC_ENGINES];
+    PLAT_UI8 *pNonce, *pMac;
+    PLAT_UI8 i;
+
+    /* - Every engine holds its math buffer, with room left for a nonce and a MAC */
+    for (i = 0; i < STSE_PLATFORM_ARENA_ECC_ENGINES; i++) {
+        stse_platform_ecc_engine_init(&engines[i]);
+        TEST_CHECK(engines[i].constructed);
+    }
+    pMac = stse_platform_arena_acquire(STSE_PLATFORM_ARENA_MAC_SIZE);
+    pNonce = stse_platform_arena_acquire(STSE_PLATFORM_ARENA_ECC_RANDOM_SIZE);
+    TEST_CHECK(pMac != NULL && pNonce != NULL);
+    TEST_CHECK(stse_platform_arena_release(pNonce) == STSE_OK);
+    TEST_CHECK(stse_platform_arena_release(pMac) == STSE_OK);
+
+    /* - Engines are released in reverse construction order */
+    if (STSE_PLATFORM_ARENA_ECC_ENGINES > 1) {
+        TEST_CHECK(stse_platform_ecc_engine_deinit(&engines[0]) == STSE_PLATFORM_INVALID_PARAMETER);
+        TEST_CHECK(engines[0].constructed);
+    }
+    for (i = STSE_PLATFORM_ARENA_ECC_ENGINES; i > 0; i--) {
+        TEST_CHECK(stse_platform_ecc_engine_deinit(&engines[i - 1]) == STSE_OK);
+        TEST_CHECK(!engines[i - 1].constructed);
+    }
+    TEST_CHECK(stse_platform_ecc_engine_deinit(&engines[0]) == STSE_OK);
+    TEST_CHECK(stse_platform_arena_in_use() == 0);
+}
+
+int main(void) {
+    test_stack_order();
+    test_exhaustion();
+    test_engines();
+
+    return test_report("test_arena");
+}
@@ -0,0 +1,92 @@
+/* Crypto platform benchmark host build : stse_platform_bench.c run over the
+ * CMOX stand-in, cycle counter read from the host monotonic clock (ns), stack
+ * painted under the caller frame on the host stack (make bench prints the
+ * result table).
+ * - every enabled primitive measured without error
+ * - operations using the whole painted area (STSE_PLATFORM_BENCH_STACK_PAINT_SIZE,
+ *   lowered in the test_bench_overflow build) flagged as stack overflow, the
+ *   others measured within it */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "Drivers/cycle_counter/cycle_counter.h"
+#include "stse_platform_bench.h"
+#include "stse_platform_drbg.h"
+#include "test_host.h"
+#include <time.h>
+
+#define TEST_STACK_MARGIN 64U /* Unpainted bytes under the caller frame */
+
+/* Linker script symbols : _Min_Stack_Size at 0 (see Makefile), _estack in the
+ * data segment below the host stack, i.e. painted area never clipped */
+PLAT_UI8 _estack;
+uint32_t stub_primask;
+
+void *_sbrk(ptrdiff_t incr) {
+    static uint8_t heap[1];
+
+    (void)incr;
+    return heap;
+}
+
+void cycle_counter_init(void) {
+}
+
+uint32_t cycle_counter_get(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec);
+}
+
+stse_ReturnCode_t stse_platform_drbg_generate(stse_platform_drbg_id_t drbg_id, PLAT_UI8 *pOutput, PLAT_UI32 length) {
+    static uint8_t seed;
+
+    while (length-- > 0) {
+        *pOutput++ = (uint8_t)(seed++ * 13U + 7U);
+    }
+    return STSE_OK;
+}
+
+static void test_print(const stse_platform_bench_result_t *pResults, PLAT_UI16 count) {
+    PLAT_UI16 i;
+
+    printf("%-28s %-16s %10s %8s %8s\n", "primitive", "variant", "ns/op", "stack", "heap");
+    for (i = 0; i < count; i++) {
+        printf("%-28s %-16s %10lu %s%7lu %8lu\n", pResults[i].pName, pResults[i].pVariant,
+               (unsigned long)pResults[i].cycles, pResults[i].stack_overflow ? ">" : " ",
+               (unsigned long)pResults[i].stack_peak, (unsigned long)pResults[i].heap_peak);
+    }
+}
+
+int main(int argc, char **argv) {
+    static stse_platform_bench_result_t results[STSE_PLATFORM_BENCH_MAX_RESULTS];
+    PLAT_UI16 count = stse_platform_bench_run(results, STSE_PLATFORM_BENCH_MAX_RESULTS);
+    unsigned overflows = 0;
+    PLAT_UI16 i;
+
+    TEST_CHECK(count > 0 && count < STSE_PLATFORM_BENCH_MAX_RESULTS);
+    for (i = 0; i < count; i++) {
+        TEST_CHECK(results[i].status == STSE_OK);
+        TEST_CHECK(results[i].stack_peak >= TEST_STACK_MARGIN);
+        TEST_CHECK(results[i].heap_peak == 0);
+        /* - Overflow : the whole painted area is used */
+        TEST_CHECK(results[i].stack_overflow == (results[i].stack_peak == STSE_PLATFORM_BENCH_STACK_PAINT_SIZE + TEST_STACK_MARGIN));
+        overflows += results[i].stack_overflow;
+        /* - CRC16 engine runs within any painted area */
+        if (strncmp(results[i].pName, "crc16_", 6) == 0) {
+            TEST_CHECK(!results[i].stack_overflow);
+        }
+    }
+#if STSE_PLATFORM_BENCH_STACK_PAINT_SIZE < 1024U
+    /* - Key generation over the CMOX stand-in (OpenSSL) needs more than the painted area */
+    TEST_CHECK(strcmp(results[0].pName, "ecc_generate_key_pair") == 0);
+    TEST_CHECK(results[0].stack_overflow);
+#endif
+
+    if (argc > 1 && strcmp(argv[1], "print") == 0) {
+        test_print(results, count);
+    }
+    printf("Stack painted area : %u bytes, %u overflows\n", (unsigned)STSE_PLATFORM_BENCH_STACK_PAINT_SIZE, overflows);
+    return test_report("test_bench");
+}
@@ -0,0 +1,84 @@
+/* CRC16 host test : the software engine selected by CRC16_SW_SLICING is checked
+ * on random buffers (random lengths, alignments and chunking) against a bitwise
+ * CRC-16 (poly 0x1021 reflected, init 0xFFFF, output complemented) */
+
+#include <stdlib.h>
+
+#include "Drivers/crc16/crc16.h"
+#include "test_host.h"
+
+#define CRC16_TEST_ROUNDS 20000U
+#define CRC16_TEST_MAX_LENGTH 800U
+
+static uint16_t _crc16_reference(const uint8_t *pBuffer, size_t length) {
+    uint16_t crc = CRC_INITVALUE;
+    uint8_t bit;
+
+    while (length-- > 0U) {
+        crc ^= *pBuffer++;
+        for (bit = 0; bit < 8U; bit++) {
+            crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ 0x8408U) : (uint16_t)(crc >> 1);
+        }
+    }
+    return (uint16_t)~crc;
+}
+
+static void test_known_answer(void) {
+    uint8_t check[] = "123456789";
+
+    /* - CRC-16/IBM-SDLC (X.25) check value */
+    TEST_CHECK(crc16_Calculate(check, 9) == 0x906E);
+    TEST_CHECK(_crc16_reference(check, 9) == 0x906E);
+}
+
+static void test_random(void) {
+    static uint8_t source[CRC16_TEST_MAX_LENGTH + 8U];
+    static uint8_t destination[CRC16_TEST_MAX_LENGTH + 8U];
+    unsigned round;
+
+    srand(0x5EED);
+    for (round = 0; round < CRC16_TEST_ROUNDS; round++) {
+        uint16_t length = (uint16_t)(rand() % (CRC16_TEST_MAX_LENGTH + 1U));
+        uint8_t src_offset = (uint8_t)(rand() % 8);
+        uint8_t dst_offset = (uint8_t)(rand() % 8);
+        uint16_t split = (length != 0U) ? (uint16_t)(rand() % (length + 1U)) : 0U;
+        uint8_t *pSource = &source[src_offset];
+        uint8_t *pDestination = &destination[dst_offset];
+        uint16_t expected;
+        crc16_ctx_t ctx;
+        uint16_t i;
+
+        for (i = 0; i < length; i++) {
+            pSource[i] = (uint8_t)rand();
+        }
+        expected = _crc16_reference(pSource, length);
+
+        /* - Single stream API */
+        TEST_CHECK(crc16_Calculate(pSource, length) == expected);
+        crc16_Calculate(pSource, split);
+        TEST_CHECK(crc16_Accumulate(&pSource[split], length - split) == expected);
+
+        /* - Fused copy, same or different word alignment */
+        memset(destination, 0, sizeof(destination));
+        TEST_CHECK(crc16_Copy_Calculate(pDestination, pSource, length) == expected);
+        TEST_CHECK_MEM(pDestination, pSource, length);
+        crc16_Copy_Calculate(pDestination, pSource, split);
+        TEST_CHECK(crc16_Copy_Accumulate(&pDestination[split], &pSource[split], length - split) == expected);
+
+        /* - Context API interleaved with the default stream */
+        crc16_ctx_init(&ctx);
+        crc16_ctx_update(&ctx, pSource, split);
+        crc16_Calculate(source, (uint16_t)(rand() % 64));
+        crc16_ctx_copy_update(&ctx, pDestination, pSource + split, length - split);
+        TEST_CHECK(crc16_ctx_final(&ctx) == expected);
+    }
+}
+
+int main(void) {
+    crc16_Init();
+    test_known_answer();
+    test_random();
+
+    printf("CRC16_SW_SLICING = %d\n", CRC16_SW_SLICING);
+    return test_report("test_crc16");
+}
@@ -0,0 +1,138 @@
+/* Hardware CRC16 host tests (CRC unit model, see crc_sim.h) :
+ * - head bytes, aligned words and tail bytes fed with the byte / word input
+ *   reversal modes, checked against a bitwise CRC-16
+ * - interleaved contexts : unit state saved from DR and restored through
+ *   CRC->INIT = __RBIT(crc) >> 16 and CR RESET on each owner change
+ * - context updated from an interrupt preempting a running feed : computed in
+ *   software, the interrupted feed and the unit ownership left untouched */
+
+#include <stdlib.h>
+
+#include "Drivers/crc16/crc16.h"
+#include "crc_sim.h"
+#include "test_host.h"
+
+#define CRC16_HW_TEST_ROUNDS 2000U
+#define CRC16_HW_TEST_MAX_LENGTH 300U
+
+static uint8_t test_buffer[2][CRC16_HW_TEST_MAX_LENGTH + 8U];
+static crc16_ctx_t test_isr_ctx;
+static uint16_t test_isr_length;
+
+static uint16_t _crc16_reference(uint16_t crc, const uint8_t *pBuffer, size_t length) {
+    uint8_t bit;
+
+    while (length-- > 0U) {
+        crc ^= *pBuffer++;
+        for (bit = 0; bit < 8U; bit++) {
+            crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ 0x8408U) : (uint16_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static void test_isr(void) {
+    crc16_ctx_update(&test_isr_ctx, test_buffer[1], test_isr_length);
+}
+
+static void test_known_answer(void) {
+    uint8_t check[] = "123456789";
+
+    sim_crc_reset();
+    crc16_Init();
+    TEST_CHECK(crc16_Calculate(check, 9) == 0x906E);
+    TEST_CHECK(sim_crc_byte_writes + 4 * sim_crc_word_writes == 9 && sim_crc_word_writes >= 1);
+    TEST_CHECK(sim_crc_errors == 0);
+}
+
+static void test_interleaved(void) {
+    crc16_ctx_t ctx[2];
+    uint16_t expected[2];
+    uint32_t fed = 0;
+    unsigned round;
+    uint8_t i;
+
+    sim_crc_reset();
+    crc16_Init();
+    srand(0xC0DE);
+    for (i = 0; i < 2; i++) {
+        crc16_ctx_init(&ctx[i]);
+        expected[i] = CRC_INITVALUE;
+    }
+
+    for (round = 0; round < CRC16_HW_TEST_ROUNDS; round++) {
+        uint16_t length = (uint16_t)(rand() % (CRC16_HW_TEST_MAX_LENGTH + 1U));
+        uint8_t offset = (uint8_t)(rand() % 8);
+        uint8_t *pChunk = &test_buffer[0][offset];
+        uint16_t j;
+
+        i = (uint8_t)(rand() % 2);
+        for (j = 0; j < length; j++) {
+            pChunk[j] = (uint8_t)rand();
+        }
+        expected[i] = _crc16_reference(expected[i], pChunk, length);
+        if (rand() % 2) {
+            TEST_CHECK(crc16_ctx_update(&ctx[i], pChunk, length) == 0);
+        } else {
+            crc16_ctx_copy_update(&ctx[i], &test_buffer[1][rand() % 8], pChunk, length);
+        }
+        fed += length;
+        TEST_CHECK(ctx[i].crc == expected[i]);
+    }
+    TEST_CHECK((crc16_ctx_final(&ctx[0]) ^ expected[0]) == 0xFFFF);
+    TEST_CHECK((crc16_ctx_final(&ctx[1]) ^ expected[1]) == 0xFFFF);
+
+    /* - Everything fed to the unit, owner changes restored from the contexts */
+    TEST_CHECK(sim_crc_byte_writes + 4 * sim_crc_word_writes == fed);
+    TEST_CHECK(sim_crc_restores > CRC16_HW_TEST_ROUNDS / 4);
+    TEST_CHECK(sim_crc_errors == 0);
+}
+
+static void test_preemption(uint32_t write) {
+    crc16_ctx_t ctx;
+    uint16_t expected;
+    uint16_t isr_expected;
+    uint32_t byte_writes, word_writes;
+    uint16_t j;
+
+    sim_crc_reset();
+    crc16_Init();
+    for (j = 0; j < sizeof(test_buffer[0]); j++) {
+        test_buffer[0][j] = (uint8_t)(j * 7 + 1);
+        test_buffer[1][j] = (uint8_t)(j * 13 + 5);
+    }
+    test_isr_length = 37;
+    crc16_ctx_init(&ctx);
+    crc16_ctx_init(&test_isr_ctx);
+    crc16_ctx_update(&test_isr_ctx, test_buffer[1], 10);
+    isr_expected = _crc16_reference(_crc16_reference(CRC_INITVALUE, test_buffer[1], 10), test_buffer[1], test_isr_length);
+    crc16_ctx_update(&ctx, test_buffer[0], 3);
+    expected = _crc16_reference(_crc16_reference(CRC_INITVALUE, test_buffer[0], 3), &test_buffer[0][3], 101);
+
+    /* - Interrupt in the middle of the feed : no unit access from the handler */
+    byte_writes = sim_crc_byte_writes;
+    word_writes = sim_crc_word_writes;
+    sim_crc_irq(write, test_isr);
+    TEST_CHECK(crc16_ctx_update(&ctx, &test_buffer[0][3], 101) == 0);
+    TEST_CHECK(ctx.crc == expected);
+    TEST_CHECK(test_isr_ctx.crc == isr_expected);
+    TEST_CHECK(sim_crc_byte_writes + 4 * sim_crc_word_writes == byte_writes + 4 * word_writes + 101);
+
+    /* - Preempted context back on the unit, restored from its software state */
+    crc16_ctx_update(&test_isr_ctx, test_buffer[0], 16);
+    TEST_CHECK(test_isr_ctx.crc == _crc16_reference(isr_expected, test_buffer[0], 16));
+    crc16_ctx_update(&ctx, test_buffer[1], 16);
+    TEST_CHECK(ctx.crc == _crc16_reference(expected, test_buffer[1], 16));
+    TEST_CHECK(sim_crc_errors == 0);
+}
+
+int main(void) {
+    test_known_answer();
+    test_interleaved();
+    /* - Preempted during the head bytes, the aligned words and the tail bytes */
+    test_preemption(1);
+    test_preemption(10);
+    test_preemption(26);
+
+    return test_report("test_crc16_hw");
+}
@@ -0,0 +1,225 @@
+/* CTR-DRBG host tests :
+ * - SP 800-90A known-answer vectors in CAVP CTR_DRBG.rsp layout run through the
+ *   CMOX DRBG API (pass the official NIST CTR_DRBG.rsp as first argument to run
+ *   its [AES-256 use df] sections as well)
+ * - stse_platform_drbg instantiate / reseed interval / request chunking checked
+ *   against the same DRBG driven by hand with the hardware RNG stream */
+
+#include <stdlib.h>
+
+#include "Middleware/STM32_Cryptographic/include/cmox_crypto.h"
+#include "stse_platform_drbg.h"
+#include "test_host.h"
+
+#define KAT_MAX_FIELD 128U
+
+/* ------------------------------------------------------------ RNG fake --- */
+
+static uint32_t rng_state = 0x1234567U;
+
+static uint8_t _stream_next(uint32_t *pState) {
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+    return (uint8_t)(*pState >> 24);
+}
+
+static void _stream_fill(uint32_t *pState, uint8_t *pBuffer, uint32_t length) {
+    while (length-- > 0U) {
+        *pBuffer++ = _stream_next(pState);
+    }
+}
+
+void rng_fill(uint8_t *pBuffer, uint32_t length) {
+    _stream_fill(&rng_state, pBuffer, length);
+}
+
+/* ------------------------------------------------------- CAVP vectors --- */
+
+typedef struct {
+    uint8_t value[KAT_MAX_FIELD];
+    size_t length;
+} kat_field_t;
+
+typedef struct {
+    kat_field_t entropy, nonce, personalization, entropy_reseed, additional_reseed;
+    kat_field_t additional[2];
+    kat_field_t returned;
+    unsigned additional_count;
+    int has_reseed;
+} kat_vector_t;
+
+static unsigned _kat_run(const kat_vector_t *pKat) {
+    cmox_ctr_drbg_handle_t ctx;
+    cmox_drbg_handle_t *pDrbg = cmox_ctr_drbg_construct(&ctx, CMOX_CTR_DRBG_AES256);
+    uint8_t out[KAT_MAX_FIELD];
+    unsigned failures = 0;
+
+    failures += cmox_drbg_init(pDrbg, pKat->entropy.value, pKat->entropy.length, pKat->personalization.value,
+                               pKat->personalization.length, pKat->nonce.value, pKat->nonce.length) != CMOX_DRBG_SUCCESS;
+    if (pKat->has_reseed) {
+        failures += cmox_drbg_reseed(pDrbg, pKat->entropy_reseed.value, pKat->entropy_reseed.length,
+                                     pKat->additional_reseed.value, pKat->additional_reseed.length) != CMOX_DRBG_SUCCESS;
+    }
+    failures += cmox_drbg_generate(pDrbg, pKat->additional[0].value, pKat->additional[0].length, out,
+                                   pKat->returned.length) != CMOX_DRBG_SUCCESS;
+    failures += cmox_drbg_generate(pDrbg, pKat->additional[1].value, pKat->additional[1].length, out,
+                                   pKat->returned.length) != CMOX_DRBG_SUCCESS;
+    failures += memcmp(out, pKat->returned.value, pKat->returned.length) != 0;
+    cmox_drbg_cleanup(pDrbg);
+
+    return failures;
+}
+
+static unsigned _kat_file(const char *pPath) {
+    FILE *pFile = fopen(pPath, "r");
+    char line[1024];
+    kat_vector_t kat;
+    int selected = 0;
+    unsigned vectors = 0;
+
+    if (pFile == NULL) {
+        printf("cannot open %s\n", pPath);
+        test_failures++;
+        return 0;
+    }
+    memset(&kat, 0, sizeof(kat));
+    while (fgets(line, sizeof(line), pFile) != NULL) {
+        char *pValue;
+        kat_field_t *pField = NULL;
+
+        line[strcspn(line, "\r\n")] = '\0';
+        /* - Section headers : keep AES-256 with derivation function and no
+         *   prediction resistance, the configuration used by the platform */
+        if (strncmp(line, "[AES-", 5) == 0) {
+            selected = (strcmp(line, "[AES-256 use df]") == 0);
+            continue;
+        }
+        if (strcmp(line, "[PredictionResistance = True]") == 0) {
+            selected = 0;
+            continue;
+        }
+        if (!selected || (line[0] == '#') || (line[0] == '[') || ((pValue = strstr(line, " =")) == NULL)) {
+            continue;
+        }
+        *pValue = '\0';
+        pValue += (pValue[2] == ' ') ? 3 : 2;
+
+        if (strcmp(line, "COUNT") == 0) {
+            memset(&kat, 0, sizeof(kat));
+        } else if (strcmp(line, "EntropyInput") == 0) {
+            pField = &kat.entropy;
+        } else if (strcmp(line, "Nonce") == 0) {
+            pField = &kat.nonce;
+        } else if (strcmp(line, "PersonalizationString") == 0) {
+            pField = &kat.personalization;
+        } else if (strcmp(line, "EntropyInputReseed") == 0) {
+            pField = &kat.entropy_reseed;
+            kat.has_reseed = 1;
+        } else if (strcmp(line, "AdditionalInputReseed") == 0) {
+            pField = &kat.additional_reseed;
+        } else if ((strcmp(line, "AdditionalInput") == 0) && (kat.additional_count < 2U)) {
+            pField = &kat.additional[kat.additional_count++];
+        } else if (strcmp(line, "ReturnedBits") == 0) {
+            kat.returned.length = test_hex_decode(pValue, kat.returned.value, KAT_MAX_FIELD);
+            TEST_CHECK(_kat_run(&kat) == 0U);
+            vectors++;
+        }
+        if (pField != NULL) {
+            pField->length = test_hex_decode(pValue, pField->value, KAT_MAX_FIELD);
+        }
+    }
+    fclose(pFile);
+    printf("%s: %u vectors\n", pPath, vectors);
+    TEST_CHECK(vectors > 0U);
+
+    return vectors;
+}
+
+/* --------------------------------------------------------- Platform --- */
+
+static void _reference_instantiate(cmox_ctr_drbg_handle_t *pCtx, uint32_t *pStream, const char *pPersonalization) {
+    uint8_t entropy[32];
+    uint8_t nonce[16];
+
+    _stream_fill(pStream, entropy, sizeof(entropy));
+    _stream_fill(pStream, nonce, sizeof(nonce));
+    cmox_ctr_drbg_construct(pCtx, CMOX_CTR_DRBG_AES256);
+    cmox_drbg_init(&pCtx->super, entropy, sizeof(entropy), (const uint8_t *)pPersonalization, strlen(pPersonalization),
+                   nonce, sizeof(nonce));
+}
+
+static void _reference_reseed(cmox_ctr_drbg_handle_t *pCtx, uint32_t *pStream) {
+    uint8_t entropy[32];
+
+    _stream_fill(pStream, entropy, sizeof(entropy));
+    cmox_drbg_reseed(&pCtx->super, entropy, sizeof(entropy), NULL, 0);
+}
+
+static void test_platform_reseed_interval(void) {
+    cmox_ctr_drbg_handle_t reference;
+    uint32_t stream = rng_state;
+    uint8_t out[20], expected[20];
+    unsigned i;
+
+    /* - Nonce instance : instantiated on first use, reseeded every
+     *   STSE_PLATFORM_DRBG_NONCE_RESEED_INTERVAL requests */
+    _reference_instantiate(&reference, &stream, "STSE DRBG NONCE");
+    for (i = 0; i < (2U * STSE_PLATFORM_DRBG_NONCE_RESEED_INTERVAL) + 3U; i++) {
+        if ((i > 0U) && ((i % STSE_PLATFORM_DRBG_NONCE_RESEED_INTERVAL) == 0U)) {
+            _reference_reseed(&reference, &stream);
+        }
+        cmox_drbg_generate(&reference.super, NULL, 0, expected, sizeof(expected));
+        TEST_CHECK(stse_platform_drbg_generate(STSE_PLATFORM_DRBG_NONCE, out, sizeof(out)) == STSE_OK);
+        TEST_CHECK_MEM(out, expected, sizeof(out));
+    }
+    TEST_CHECK(stream == rng_state);
+}
+
+static void test_platform_chunking(void) {
+    cmox_ctr_drbg_handle_t reference;
+    uint32_t stream = rng_state;
+    const uint32_t length = 0x10000U + 33U;
+    uint8_t *pOut = malloc(length);
+    uint8_t *pExpected = malloc(length);
+
+    /* - Requests above the SP 800-90A per request limit are split */
+    _reference_instantiate(&reference, &stream, "STSE DRBG PAYLOAD");
+    cmox_drbg_generate(&reference.super, NULL, 0, pExpected, 0x10000U);
+    cmox_drbg_generate(&reference.super, NULL, 0, &pExpected[0x10000U], 33U);
+    TEST_CHECK(stse_platform_drbg_generate(STSE_PLATFORM_DRBG_PAYLOAD, pOut, length) == STSE_OK);
+    TEST_CHECK_MEM(pOut, pExpected, length);
+
+    /* - Forced reseed pulls fresh entropy */
+    _reference_reseed(&reference, &stream);
+    cmox_drbg_generate(&reference.super, NULL, 0, pExpected, 64U);
+    TEST_CHECK(stse_platform_drbg_reseed(STSE_PLATFORM_DRBG_PAYLOAD) == STSE_OK);
+    TEST_CHECK(stse_platform_drbg_generate(STSE_PLATFORM_DRBG_PAYLOAD, pOut, 64U) == STSE_OK);
+    TEST_CHECK_MEM(pOut, pExpected, 64U);
+    TEST_CHECK(stream == rng_state);
+
+    free(pOut);
+    free(pExpected);
+}
+
+static void test_platform_parameters(void) {
+    uint8_t out[4];
+
+    TEST_CHECK(stse_platform_drbg_generate(STSE_PLATFORM_DRBG_COUNT, out, sizeof(out)) == STSE_PLATFORM_INVALID_PARAMETER);
+    TEST_CHECK(stse_platform_drbg_generate(STSE_PLATFORM_DRBG_PAYLOAD, NULL, sizeof(out)) == STSE_PLATFORM_INVALID_PARAMETER);
+    TEST_CHECK(stse_platform_drbg_reseed(STSE_PLATFORM_DRBG_COUNT) == STSE_PLATFORM_INVALID_PARAMETER);
+}
+
+int main(int argc, char *argv[]) {
+    int i;
+
+    _kat_file("vectors/ctr_drbg_aes256_df.rsp");
+    for (i = 1; i < argc; i++) {
+        _kat_file(argv[i]);
+    }
+    test_platform_reseed_interval();
+    test_platform_chunking();
+    test_platform_parameters();
+
+    return test_report("test_drbg");
+}
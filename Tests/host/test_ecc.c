@@ -0,0 +1,365 @@
+/* ECC host tests (configuration to implementation mapping) :
+ * - each enabled STSE_CONF_ECC_* key type selects its CMOX curve in the LOWMEM
+ *   or HIGHMEM variant according to STSE_CONF_PLATFORM_ECC_FAST, disabled key
+ *   types are rejected
+ * - engines are constructed with the matching math functions and a math buffer
+ *   of STSE_PLATFORM_ECC_MATH_BUFFER_SIZE bytes, the size expected for the
+ *   build being passed as TEST_ECC_MATH_BUFFER_SIZE
+ * - key generation, sign and verify round trip through the selected curve
+ *   (curve arithmetic is not modelled by the CMOX stand-in)
+ * - batch verification per item results
+ * - two engines interleaved : each operation runs in the math buffer of its
+ *   engine, key generation / sign / ECDH leave it cleared, verify keeps it
+ * - ephemeral key pool (STSE_CONF_PLATFORM_ECC_KEY_POOL) : refill bounded by the
+ *   empty slots, key pairs taken once then zeroized in the pool, hit / miss /
+ *   refill statistics, flush
+ * - verified signature cache (STSE_CONF_PLATFORM_ECC_VERIFY_CACHE) : positive
+ *   results only, LRU eviction, max age against the cache time base, entry and
+ *   full invalidation, tables accessed with interrupts masked */
+
+#include "stse_platform_drbg.h"
+#include "stse_platform_ecc.h"
+#include "test_host.h"
+
+extern cmox_ecc_impl_t cmox_stub_ecc_impl;
+extern cmox_math_funcs_t cmox_stub_ecc_math;
+extern size_t cmox_stub_ecc_buffer_length;
+extern uint8_t *cmox_stub_ecc_buffer;
+extern uint8_t *cmox_stub_ecc_priv_key;
+
+uint32_t stub_primask;
+
+#ifdef STSE_CONF_PLATFORM_ECC_FAST
+#define TEST_ECC_IMPL(curve) &CMOX_ECC_##curve##_HIGHMEM
+#define TEST_ECC_MATH CMOX_MATH_FUNCS_FAST
+#else
+#define TEST_ECC_IMPL(curve) &CMOX_ECC_##curve##_LOWMEM
+#define TEST_ECC_MATH CMOX_MATH_FUNCS_SMALL
+#endif
+
+typedef struct {
+    stse_ecc_key_type_t key_type;
+    const cmox_ecc_impl_t *pImpl; /* NULL when the key type is not enabled */
+    PLAT_UI8 sign;                /* Signature scheme available on the curve */
+} ecc_mapping_t;
+
+static const ecc_mapping_t ecc_mappings[] = {
+#ifdef STSE_CONF_ECC_NIST_P_256
+    {STSE_ECC_KT_NIST_P_256, TEST_ECC_IMPL(SECP256R1), 1},
+#else
+    {STSE_ECC_KT_NIST_P_256, NULL, 1},
+#endif
+#ifdef STSE_CONF_ECC_NIST_P_384
+    {STSE_ECC_KT_NIST_P_384, TEST_ECC_IMPL(SECP384R1), 1},
+#else
+    {STSE_ECC_KT_NIST_P_384, NULL, 1},
+#endif
+#ifdef STSE_CONF_ECC_NIST_P_521
+    {STSE_ECC_KT_NIST_P_521, TEST_ECC_IMPL(SECP521R1), 1},
+#else
+    {STSE_ECC_KT_NIST_P_521, NULL, 1},
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_256
+    {STSE_ECC_KT_BP_P_256, TEST_ECC_IMPL(BPP256R1), 1},
+#else
+    {STSE_ECC_KT_BP_P_256, NULL, 1},
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_384
+    {STSE_ECC_KT_BP_P_384, TEST_ECC_IMPL(BPP384R1), 1},
+#else
+    {STSE_ECC_KT_BP_P_384, NULL, 1},
+#endif
+#ifdef STSE_CONF_ECC_BRAINPOOL_P_512
+    {STSE_ECC_KT_BP_P_512, TEST_ECC_IMPL(BPP512R1), 1},
+#else
+    {STSE_ECC_KT_BP_P_512, NULL, 1},
+#endif
+#ifdef STSE_CONF_ECC_CURVE_25519
+    {STSE_ECC_KT_CURVE25519, &CMOX_ECC_CURVE25519, 0},
+#else
+    {STSE_ECC_KT_CURVE25519, NULL, 0},
+#endif
+#ifdef STSE_CONF_ECC_EDWARD_25519
+    {STSE_ECC_KT_ED25519, TEST_ECC_IMPL(ED25519_OPT), 1},
+#else
+    {STSE_ECC_KT_ED25519, NULL, 1},
+#endif
+};
+
+/* Deterministic stand-in for the platform DRBG */
+stse_ReturnCode_t stse_platform_drbg_generate(stse_platform_drbg_id_t drbg_id, PLAT_UI8 *pOutput, PLAT_UI32 length) {
+    static PLAT_UI8 counter;
+
+    while (length-- > 0) {
+        *pOutput++ = counter++;
+    }
+    return STSE_OK;
+}
+
+static void test_mapping(const ecc_mapping_t *pMapping) {
+    PLAT_UI8 priv_key[STSE_PLATFORM_ECC_POOL_PRIV_KEY_SIZE];
+    PLAT_UI8 pub_key[STSE_PLATFORM_ECC_POOL_PUB_KEY_SIZE];
+    PLAT_UI8 signature[132] = {0};
+    PLAT_UI8 good_signature[132];
+    stse_platform_ecc_verify_item_t items[2];
+    PLAT_UI8 digest[32] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+    stse_ReturnCode_t ret;
+
+    cmox_stub_ecc_impl = NULL;
+    cmox_stub_ecc_math = NULL;
+    cmox_stub_ecc_buffer_length = 0;
+    ret = stse_platform_ecc_generate_key_pair(pMapping->key_type, priv_key, pub_key);
+
+    if (pMapping->pImpl == NULL) {
+        /* - Disabled key type : no curve selected, operation rejected */
+        TEST_CHECK(ret != STSE_OK);
+        TEST_CHECK(cmox_stub_ecc_impl == NULL);
+        TEST_CHECK(stse_platform_ecc_verify(pMapping->key_type, pub_key, digest, sizeof(digest), signature) != STSE_OK);
+        return;
+    }
+
+    /* - Enabled key type : selected curve variant, math functions and buffer */
+    TEST_CHECK(ret == STSE_OK);
+    TEST_CHECK(cmox_stub_ecc_impl == *pMapping->pImpl);
+    TEST_CHECK(cmox_stub_ecc_math == TEST_ECC_MATH);
+    TEST_CHECK(cmox_stub_ecc_buffer_length == STSE_PLATFORM_ECC_MATH_BUFFER_SIZE);
+
+    if (!pMapping->sign) {
+        return;
+    }
+
+    /* - Sign / verify round trip on the selected curve */
+    TEST_CHECK(stse_platform_ecc_sign(pMapping->key_type, priv_key, digest, sizeof(digest), signature) == STSE_OK);
+    TEST_CHECK(stse_platform_ecc_verify(pMapping->key_type, pub_key, digest, sizeof(digest), signature) == STSE_OK);
+    TEST_CHECK(cmox_stub_ecc_impl == *pMapping->pImpl);
+    signature[0] ^= 0x01;
+    TEST_CHECK(stse_platform_ecc_verify(pMapping->key_type, pub_key, digest, sizeof(digest), signature) != STSE_OK);
+
+    /* - Batch verification reports each item result */
+    TEST_CHECK(stse_platform_ecc_sign(pMapping->key_type, priv_key, digest, sizeof(digest), good_signature) == STSE_OK);
+    items[0] = (stse_platform_ecc_verify_item_t){pMapping->key_type, pub_key, digest, sizeof(digest), good_signature, STSE_OK};
+    items[1] = (stse_platform_ecc_verify_item_t){pMapping->key_type, pub_key, digest, sizeof(digest), signature, STSE_OK};
+    TEST_CHECK(stse_platform_ecc_verify_batch(items, 1) == STSE_OK);
+    TEST_CHECK(stse_platform_ecc_verify_batch(items, 2) == STSE_PLATFORM_ECC_VERIFY_ERROR);
+    TEST_CHECK(items[0].result == STSE_OK);
+    TEST_CHECK(items[1].result == STSE_PLATFORM_ECC_VERIFY_ERROR);
+}
+
+static PLAT_UI8 test_math_buffer_zero[STSE_PLATFORM_ECC_MATH_BUFFER_SIZE];
+
+static void test_engine_ran(stse_platform_ecc_engine_t *pEngine, PLAT_UI8 cleared) {
+    TEST_CHECK(cmox_stub_ecc_buffer == pEngine->math_buffer);
+    TEST_CHECK(pEngine->constructed);
+    TEST_CHECK((memcmp(pEngine->math_buffer, test_math_buffer_zero, sizeof(test_math_buffer_zero)) == 0) == cleared);
+}
+
+static void test_engines(void) {
+    stse_platform_ecc_engine_t engines[2];
+    PLAT_UI8 priv_key[2][32];
+    PLAT_UI8 pub_key[2][64];
+    PLAT_UI8 signature[2][64];
+    PLAT_UI8 secret[2][32];
+    PLAT_UI8 digest[32] = {0xA5, 0x5A};
+    PLAT_UI8 i;
+
+    memset(engines, 0, sizeof(engines));
+    stse_platform_ecc_engine_init(&engines[0]);
+    stse_platform_ecc_engine_init(&engines[1]);
+
+    /* - Operations alternating between the engines */
+    for (i = 0; i < 2; i++) {
+        TEST_CHECK(stse_platform_ecc_engine_generate_key_pair(&engines[i], STSE_ECC_KT_NIST_P_256, priv_key[i], pub_key[i]) == STSE_OK);
+        test_engine_ran(&engines[i], 1);
+    }
+    for (i = 0; i < 2; i++) {
+        TEST_CHECK(stse_platform_ecc_engine_sign(&engines[i], STSE_ECC_KT_NIST_P_256, priv_key[i], digest, sizeof(digest), signature[i]) == STSE_OK);
+        test_engine_ran(&engines[i], 1);
+    }
+    for (i = 0; i < 2; i++) {
+        TEST_CHECK(stse_platform_ecc_engine_verify(&engines[i], STSE_ECC_KT_NIST_P_256, pub_key[1 - i], digest, sizeof(digest), signature[1 - i]) == STSE_OK);
+        test_engine_ran(&engines[i], 0);
+    }
+    TEST_CHECK(memcmp(engines[1].math_buffer, test_math_buffer_zero, sizeof(test_math_buffer_zero)) != 0);
+    for (i = 0; i < 2; i++) {
+        TEST_CHECK(stse_platform_ecc_engine_ecdh(&engines[i], STSE_ECC_KT_NIST_P_256, pub_key[1 - i], priv_key[i], secret[i]) == STSE_OK);
+        test_engine_ran(&engines[i], 1);
+    }
+
+    /* - Verification of the signature of the other engine fails on a wrong digest */
+    digest[0] ^= 0x01;
+    TEST_CHECK(stse_platform_ecc_engine_verify(&engines[0], STSE_ECC_KT_NIST_P_256, pub_key[1], digest, sizeof(digest), signature[1]) != STSE_OK);
+
+    for (i = 0; i < 2; i++) {
+        TEST_CHECK(stse_platform_ecc_engine_deinit(&engines[i]) == STSE_OK);
+        TEST_CHECK(!engines[i].constructed);
+        TEST_CHECK_MEM(engines[i].math_buffer, test_math_buffer_zero, sizeof(test_math_buffer_zero));
+    }
+}
+
+#ifdef STSE_CONF_PLATFORM_ECC_KEY_POOL
+static PLAT_UI8 test_pool_zero[STSE_PLATFORM_ECC_POOL_PRIV_KEY_SIZE + STSE_PLATFORM_ECC_POOL_PUB_KEY_SIZE];
+
+static void test_pool(void) {
+    PLAT_UI8 priv_key[STSE_PLATFORM_ECC_POOL_PRIV_KEY_SIZE];
+    PLAT_UI8 pub_key[STSE_PLATFORM_ECC_POOL_PUB_KEY_SIZE];
+    PLAT_UI8 slot_key[2][STSE_PLATFORM_ECC_POOL_PRIV_KEY_SIZE];
+    PLAT_UI8 *pSlot[2];
+    PLAT_UI8 signature[132];
+    PLAT_UI8 digest[32] = {0x5A};
+    stse_platform_ecc_pool_stats_t start, stats;
+    PLAT_UI8 priv_key_length = 32U; /* NIST P-256 */
+    PLAT_UI8 i;
+
+    stse_platform_ecc_pool_flush();
+    stse_platform_ecc_pool_get_stats(&start);
+    TEST_CHECK(stse_platform_ecc_pool_level() == 0);
+
+    /* - Refill one slot per call, slots located by the stand-in key generation output */
+    TEST_CHECK(stse_platform_ecc_pool_refill(0) == STSE_OK);
+    TEST_CHECK(stse_platform_ecc_pool_level() == 0);
+    for (i = 0; i < 2; i++) {
+        TEST_CHECK(stse_platform_ecc_pool_refill(1) == STSE_OK);
+        pSlot[i] = cmox_stub_ecc_priv_key;
+        memcpy(slot_key[i], pSlot[i], priv_key_length);
+    }
+    TEST_CHECK(stse_platform_ecc_pool_level() == 2);
+    TEST_CHECK(memcmp(slot_key[0], slot_key[1], priv_key_length) != 0);
+
+    /* - Pool hit : key pair handed out once, slot zeroized */
+    for (i = 0; i < 2; i++) {
+        cmox_stub_ecc_priv_key = NULL;
+        TEST_CHECK(stse_platform_ecc_generate_key_pair(STSE_PLATFORM_ECC_POOL_KEY_TYPE, priv_key, pub_key) == STSE_OK);
+        TEST_CHECK(cmox_stub_ecc_priv_key == NULL);
+        TEST_CHECK_MEM(priv_key, slot_key[i], priv_key_length);
+        TEST_CHECK_MEM(pSlot[i], test_pool_zero, sizeof(test_pool_zero));
+        TEST_CHECK(stse_platform_ecc_sign(STSE_PLATFORM_ECC_POOL_KEY_TYPE, priv_key, digest, sizeof(digest), signature) == STSE_OK);
+        TEST_CHECK(stse_platform_ecc_verify(STSE_PLATFORM_ECC_POOL_KEY_TYPE, pub_key, digest, sizeof(digest), signature) == STSE_OK);
+    }
+    TEST_CHECK(stse_platform_ecc_pool_level() == 0);
+
+    /* - Pool miss : key pair generated on request */
+    TEST_CHECK(stse_platform_ecc_generate_key_pair(STSE_PLATFORM_ECC_POOL_KEY_TYPE, priv_key, pub_key) == STSE_OK);
+    TEST_CHECK(cmox_stub_ecc_priv_key == priv_key);
+
+    stse_platform_ecc_pool_get_stats(&stats);
+    TEST_CHECK(stats.refills - start.refills == 2);
+    TEST_CHECK(stats.hits - start.hits == 2);
+    TEST_CHECK(stats.misses - start.misses == 1);
+
+    /* - Refill bounded by the pool size, flush zeroizes every slot */
+    TEST_CHECK(stse_platform_ecc_pool_refill(STSE_PLATFORM_ECC_POOL_SIZE + 2) == STSE_OK);
+    TEST_CHECK(stse_platform_ecc_pool_level() == STSE_PLATFORM_ECC_POOL_SIZE);
+    stse_platform_ecc_pool_get_stats(&stats);
+    TEST_CHECK(stats.refills - start.refills == 2 + STSE_PLATFORM_ECC_POOL_SIZE);
+    TEST_CHECK(memcmp(pSlot[0], test_pool_zero, sizeof(test_pool_zero)) != 0);
+    stse_platform_ecc_pool_flush();
+    TEST_CHECK(stse_platform_ecc_pool_level() == 0);
+    TEST_CHECK_MEM(pSlot[0], test_pool_zero, sizeof(test_pool_zero));
+    TEST_CHECK_MEM(pSlot[1], test_pool_zero, sizeof(test_pool_zero));
+    TEST_CHECK(stse_platform_ecc_generate_key_pair(STSE_PLATFORM_ECC_POOL_KEY_TYPE, priv_key, pub_key) == STSE_OK);
+    stse_platform_ecc_pool_get_stats(&stats);
+    TEST_CHECK(stats.misses - start.misses == 2);
+}
+#endif /* STSE_CONF_PLATFORM_ECC_KEY_POOL */
+
+#ifdef STSE_CONF_PLATFORM_ECC_VERIFY_CACHE
+static PLAT_UI32 test_cache_time;
+static PLAT_UI8 test_cache_time_masked = 1;
+
+PLAT_UI32 stse_platform_ecc_verify_cache_get_time(void) {
+    test_cache_time_masked &= (stub_primask != 0);
+    return test_cache_time;
+}
+
+/* Verify a signature of digest index, reports whether the ECC computation ran */
+static PLAT_UI8 test_cache_verify(PLAT_UI8 *pPubKey, PLAT_UI8 (*pDigests)[32], PLAT_UI8 (*pSignatures)[64], PLAT_UI8 index,
+                                  stse_ReturnCode_t expected) {
+    cmox_stub_ecc_impl = NULL;
+    TEST_CHECK(stse_platform_ecc_verify(STSE_ECC_KT_NIST_P_256, pPubKey, pDigests[index], 32, pSignatures[index]) == expected);
+    TEST_CHECK(stub_primask == 0);
+    return cmox_stub_ecc_impl != NULL;
+}
+
+static void test_cache(void) {
+    PLAT_UI8 priv_key[32];
+    PLAT_UI8 pub_key[64];
+    PLAT_UI8 digests[STSE_PLATFORM_ECC_VERIFY_CACHE_SIZE + 1][32];
+    PLAT_UI8 signatures[STSE_PLATFORM_ECC_VERIFY_CACHE_SIZE + 1][64];
+    PLAT_UI8 bad_signature[1][64];
+    stse_platform_ecc_verify_cache_stats_t start, stats;
+    PLAT_UI8 i;
+
+    stse_platform_ecc_verify_cache_invalidate();
+    stse_platform_ecc_verify_cache_get_stats(&start);
+    TEST_CHECK(stse_platform_ecc_generate_key_pair(STSE_ECC_KT_NIST_P_256, priv_key, pub_key) == STSE_OK);
+    for (i = 0; i <= STSE_PLATFORM_ECC_VERIFY_CACHE_SIZE; i++) {
+        memset(digests[i], i, sizeof(digests[i]));
+        TEST_CHECK(stse_platform_ecc_sign(STSE_ECC_KT_NIST_P_256, priv_key, digests[i], 32, signatures[i]) == STSE_OK);
+    }
+    memcpy(bad_signature[0], signatures[0], sizeof(bad_signature[0]));
+    bad_signature[0][0] ^= 0x01;
+
+    /* - Miss then hit, failed verifications not cached */
+    TEST_CHECK(test_cache_verify(pub_key, digests, signatures, 0, STSE_OK));
+    TEST_CHECK(!test_cache_verify(pub_key, digests, signatures, 0, STSE_OK));
+    TEST_CHECK(test_cache_verify(pub_key, digests, bad_signature, 0, STSE_PLATFORM_ECC_VERIFY_ERROR));
+    TEST_CHECK(test_cache_verify(pub_key, digests, bad_signature, 0, STSE_PLATFORM_ECC_VERIFY_ERROR));
+    stse_platform_ecc_verify_cache_get_stats(&stats);
+    TEST_CHECK(stats.hits - start.hits == 1);
+    TEST_CHECK(stats.misses - start.misses == 3);
+
+    /* - Full table : least recently used entry (digest 1, digest 0 being touched) evicted */
+    for (i = 1; i < STSE_PLATFORM_ECC_VERIFY_CACHE_SIZE; i++) {
+        TEST_CHECK(test_cache_verify(pub_key, digests, signatures, i, STSE_OK));
+    }
+    TEST_CHECK(!test_cache_verify(pub_key, digests, signatures, 0, STSE_OK));
+    TEST_CHECK(test_cache_verify(pub_key, digests, signatures, STSE_PLATFORM_ECC_VERIFY_CACHE_SIZE, STSE_OK));
+    stse_platform_ecc_verify_cache_get_stats(&stats);
+    TEST_CHECK(stats.evictions - start.evictions == 1);
+    TEST_CHECK(!test_cache_verify(pub_key, digests, signatures, 0, STSE_OK));
+    TEST_CHECK(!test_cache_verify(pub_key, digests, signatures, 2, STSE_OK));
+    TEST_CHECK(test_cache_verify(pub_key, digests, signatures, 1, STSE_OK));
+    TEST_CHECK(test_cache_verify(pub_key, digests, signatures, 3, STSE_OK));
+
+    /* - Max age : entries kept up to STSE_PLATFORM_ECC_VERIFY_CACHE_MAX_AGE time units */
+    test_cache_time += STSE_PLATFORM_ECC_VERIFY_CACHE_MAX_AGE;
+    TEST_CHECK(!test_cache_verify(pub_key, digests, signatures, 0, STSE_OK));
+    test_cache_time++;
+    TEST_CHECK(test_cache_verify(pub_key, digests, signatures, 0, STSE_OK));
+    stse_platform_ecc_verify_cache_get_stats(&stats);
+    TEST_CHECK(stats.expirations - start.expirations == STSE_PLATFORM_ECC_VERIFY_CACHE_SIZE);
+    TEST_CHECK(!test_cache_verify(pub_key, digests, signatures, 0, STSE_OK));
+
+    /* - Entry and full invalidation */
+    TEST_CHECK(test_cache_verify(pub_key, digests, signatures, 1, STSE_OK));
+    stse_platform_ecc_verify_cache_invalidate_entry(STSE_ECC_KT_NIST_P_256, pub_key, digests[0], 32, signatures[0]);
+    TEST_CHECK(stub_primask == 0);
+    TEST_CHECK(test_cache_verify(pub_key, digests, signatures, 0, STSE_OK));
+    TEST_CHECK(!test_cache_verify(pub_key, digests, signatures, 1, STSE_OK));
+    stse_platform_ecc_verify_cache_invalidate();
+    TEST_CHECK(test_cache_verify(pub_key, digests, signatures, 0, STSE_OK));
+    TEST_CHECK(test_cache_verify(pub_key, digests, signatures, 1, STSE_OK));
+
+    TEST_CHECK(test_cache_time_masked);
+}
+#endif /* STSE_CONF_PLATFORM_ECC_VERIFY_CACHE */
+
+int main(void) {
+    size_t i;
+
+    /* - Math buffer size derived from the enabled curves and FAST selection */
+    TEST_CHECK(STSE_PLATFORM_ECC_MATH_BUFFER_SIZE == TEST_ECC_MATH_BUFFER_SIZE);
+
+    for (i = 0; i < sizeof(ecc_mappings) / sizeof(ecc_mappings[0]); i++) {
+        test_mapping(&ecc_mappings[i]);
+    }
+    test_engines();
+#ifdef STSE_CONF_PLATFORM_ECC_KEY_POOL
+    test_pool();
+#endif /* STSE_CONF_PLATFORM_ECC_KEY_POOL */
+#ifdef STSE_CONF_PLATFORM_ECC_VERIFY_CACHE
+    test_cache();
+#endif /* STSE_CONF_PLATFORM_ECC_VERIFY_CACHE */
+
+    return test_report("test_ecc");
+}
@@ -0,0 +1,109 @@
+/* HKDF-SHA256 host tests : RFC 5869 appendix A.1 to A.3 through the extract,
+ * expand and extract_expand platform entry points, plus an expand with a PRK
+ * longer than the HMAC block (midstates derived from H(PRK)) */
+
+#include "stse_platform_hash.h"
+#include "test_host.h"
+
+typedef struct {
+    const char *pName;
+    const char *pIkm;
+    const char *pSalt;
+    const char *pInfo;
+    const char *pPrk;
+    const char *pOkm;
+} hkdf_vector_t;
+
+static const hkdf_vector_t rfc5869_vectors[] = {
+    {"A.1",
+     "0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b",
+     "000102030405060708090a0b0c",
+     "f0f1f2f3f4f5f6f7f8f9",
+     "077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5",
+     "3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf34007208d5b887185865"},
+    {"A.2",
+     "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+     "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+     "404142434445464748494a4b4c4d4e4f",
+     "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+     "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+     "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf",
+     "b0b1b2b3b4b5b6b7b8b9babbbcbdbebfc0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+     "d0d1d2d3d4d5d6d7d8d9dadbdcdddedfe0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+     "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff",
+     "06a6b88c5853361a06104c9ceb35b45cef760014904671014a193f40c15fc244",
+     "b11e398dc80327a1c8e7f78c596a49344f012eda2d4efad8a050cc4c19afa97c"
+     "59045a99cac7827271cb41c65e590e09da3275600c2f09b8367793a9aca3db71"
+     "cc30c58179ec3e87c14c01d5c1f3434f1d87"},
+    {"A.3",
+     "0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b",
+     "",
+     "",
+     "19ef24a32c717b167f33a91d6f648bdf96596776afdb6377ac434c1c293ccb04",
+     "8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d9d201395faa4b61a96c8"},
+};
+
+/* HKDF-Expand with a 131 byte PRK (0xAA, the RFC 4231 test case 6 key) :
+ * T(1) = HMAC(H(PRK) padded, info || 0x01), output cross-checked with Python
+ * hmac / hashlib */
+static const char long_prk_info[] = "Test Using Larger Than Block-Size Key - Hash Key First";
+static const char long_prk_okm[] =
+    "752477867f9ba0237e46f4886885d2b8beec264097b43cc8a906d06ada4fc120"
+    "c40ae7bd9b4f525d87fde4d252c3a101a29c04f7e89acefb2117a541ecf129d0"
+    "222a342234054e7195c2e610a3a065f7";
+
+static void test_rfc5869(const hkdf_vector_t *pVector) {
+    uint8_t ikm[80], salt[80], info[80], prk[32], okm[82];
+    uint8_t prk_out[32], okm_out[82];
+    PLAT_UI16 ikm_length = (PLAT_UI16)test_hex_decode(pVector->pIkm, ikm, sizeof(ikm));
+    PLAT_UI16 salt_length = (PLAT_UI16)test_hex_decode(pVector->pSalt, salt, sizeof(salt));
+    PLAT_UI16 info_length = (PLAT_UI16)test_hex_decode(pVector->pInfo, info, sizeof(info));
+    PLAT_UI16 okm_length = (PLAT_UI16)test_hex_decode(pVector->pOkm, okm, sizeof(okm));
+
+    test_hex_decode(pVector->pPrk, prk, sizeof(prk));
+    printf("RFC 5869 %s\n", pVector->pName);
+
+    TEST_CHECK(stse_platform_hmac_sha256_extract(salt, salt_length, ikm, ikm_length, prk_out, sizeof(prk_out)) == STSE_OK);
+    TEST_CHECK_MEM(prk_out, prk, sizeof(prk));
+
+    memset(okm_out, 0, sizeof(okm_out));
+    TEST_CHECK(stse_platform_hmac_sha256_expand(prk, sizeof(prk), info, info_length, okm_out, okm_length) == STSE_OK);
+    TEST_CHECK_MEM(okm_out, okm, okm_length);
+
+    memset(okm_out, 0, sizeof(okm_out));
+    TEST_CHECK(stse_platform_hmac_sha256_extract_expand(salt, salt_length, ikm, ikm_length, info, info_length,
+                                                        okm_out, okm_length) == STSE_OK);
+    TEST_CHECK_MEM(okm_out, okm, okm_length);
+}
+
+static void test_long_prk(void) {
+    uint8_t prk[131], okm[80], okm_out[80];
+    PLAT_UI16 okm_length = (PLAT_UI16)test_hex_decode(long_prk_okm, okm, sizeof(okm));
+
+    memset(prk, 0xAA, sizeof(prk));
+    TEST_CHECK(stse_platform_hmac_sha256_expand(prk, sizeof(prk), (PLAT_UI8 *)long_prk_info,
+                                                (PLAT_UI16)strlen(long_prk_info), okm_out, okm_length) == STSE_OK);
+    TEST_CHECK_MEM(okm_out, okm, okm_length);
+}
+
+static void test_expand_limits(void) {
+    uint8_t prk[32] = {0};
+    static uint8_t okm[(255U * 32U) + 1U];
+
+    /* - L <= 255 * HashLen */
+    TEST_CHECK(stse_platform_hmac_sha256_expand(prk, sizeof(prk), NULL, 0, okm, 255U * 32U) == STSE_OK);
+    TEST_CHECK(stse_platform_hmac_sha256_expand(prk, sizeof(prk), NULL, 0, okm, sizeof(okm)) == STSE_PLATFORM_HKDF_ERROR);
+    TEST_CHECK(stse_platform_hmac_sha256_expand(prk, sizeof(prk), NULL, 0, NULL, 32U) == STSE_PLATFORM_HKDF_ERROR);
+}
+
+int main(void) {
+    size_t i;
+
+    for (i = 0; i < sizeof(rfc5869_vectors) / sizeof(rfc5869_vectors[0]); i++) {
+        test_rfc5869(&rfc5869_vectors[i]);
+    }
+    test_long_prk();
+    test_expand_limits();
+
+    return test_report("test_hkdf");
+}
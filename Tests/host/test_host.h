@@ -0,0 +1,39 @@
+/* Minimal assertion helpers shared by the host unit tests */
+#ifndef TEST_HOST_H
+#define TEST_HOST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static unsigned test_failures;
+static unsigned test_checks;
+
+#define TEST_CHECK(cond)                                                   \
+    do {                                                                   \
+        test_checks++;                                                     \
+        if (!(cond)) {                                                     \
+            test_failures++;                                               \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                  \
+    } while (0)
+
+#define TEST_CHECK_MEM(a, b, n) TEST_CHECK(memcmp((a), (b), (n)) == 0)
+
+static inline size_t test_hex_decode(const char *pHex, uint8_t *pOut, size_t max_length) {
+    size_t length = 0;
+    unsigned int byte;
+
+    while ((pHex[0] != '\0') && (pHex[1] != '\0') && (length < max_length) && (sscanf(pHex, "%2x", &byte) == 1)) {
+        pOut[length++] = (uint8_t)byte;
+        pHex += 2;
+    }
+    return length;
+}
+
+static inline int test_report(const char *pName) {
+    printf("%s: %u checks, %u failures\n", pName, test_checks, test_failures);
+    return (test_failures == 0U) ? 0 : 1;
+}
+
+#endif /* TEST_HOST_H */
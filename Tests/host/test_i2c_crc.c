@@ -0,0 +1,180 @@
+/* I2C PAL response CRC host tests, built once per mode
+ * (STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE and STSE_CONF_PLATFORM_I2C_RECEIVE_CRC) over
+ * the I2C bus model. The core receive sequence is replayed : length read,
+ * then header / skipped length / payload / CRC fragments, then the core CRC
+ * pass over the header and payload elements.
+ * - valid frames : received data, CRC pass skipped (elements not read again)
+ * - corrupted header, payload or CRC field : receive_start succeeds (bus
+ *   errors only, core retry contract), receive_stop reports
+ *   STSE_CORE_FRAME_CRC_ERROR and the CRC pass computes the elements
+ * - frames without CRC field and NACK left to the core */
+
+#include "core/stse_platform.h"
+#include "Drivers/crc16/crc16.h"
+#include "i2c_sim.h"
+#include "stse_platform_crc.h"
+#include "stse_platform_drbg.h"
+#include "test_host.h"
+
+#define TEST_ADDR 0x20
+#define TEST_SPEED 400
+
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE)
+#define TEST_MODE "fused"
+#else
+#define TEST_MODE "receive loop"
+#endif
+
+stse_ReturnCode_t stse_platform_i2c_receive_start(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI16 frameLength);
+stse_ReturnCode_t stse_platform_i2c_receive_continue(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI8 *pData, PLAT_UI16 data_size);
+stse_ReturnCode_t stse_platform_i2c_receive_stop(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI8 *pData, PLAT_UI16 data_size);
+PLAT_UI16 stse_platform_Crc16_Calculate(PLAT_UI8 *pbuffer, PLAT_UI16 length);
+PLAT_UI16 stse_platform_Crc16_Accumulate(PLAT_UI8 *pbuffer, PLAT_UI16 length);
+
+#define TEST_PAYLOAD_MAX 700U
+
+typedef struct {
+    uint8_t frame[TEST_PAYLOAD_MAX + 5U];
+    uint16_t frame_length;
+    uint8_t header;
+    uint8_t payload[TEST_PAYLOAD_MAX];
+    uint8_t crc[2];
+} test_rsp_t;
+
+static test_rsp_t test_rsp;
+
+stse_ReturnCode_t stse_platform_drbg_generate(stse_platform_drbg_id_t drbg_id, PLAT_UI8 *pOutput, PLAT_UI32 length) {
+    memset(pOutput, 0x5A, length);
+    return STSE_OK;
+}
+
+static void test_frame_build(uint16_t payload_length) {
+    uint8_t *pFrame = test_rsp.frame;
+    uint16_t crc;
+    uint16_t i;
+
+    pFrame[0] = 0x00;
+    pFrame[1] = (uint8_t)(payload_length >> 8);
+    pFrame[2] = (uint8_t)payload_length;
+    for (i = 0; i < payload_length; i++) {
+        pFrame[3 + i] = (uint8_t)(i * 31 + payload_length);
+    }
+    crc16_Calculate(pFrame, 1);
+    crc = crc16_Accumulate(&pFrame[3], payload_length);
+    pFrame[3 + payload_length] = (uint8_t)(crc >> 8);
+    pFrame[4 + payload_length] = (uint8_t)crc;
+    test_rsp.frame_length = payload_length + 5U;
+}
+
+/* Core receive sequence, returns the PAL status and the core CRC verdict */
+static stse_ReturnCode_t test_core_receive(uint16_t payload_length, uint8_t poison, stse_ReturnCode_t *pCrc_verdict) {
+    stse_ReturnCode_t ret;
+    uint8_t length[2];
+    PLAT_UI16 crc;
+
+    /* - Response length (no CRC field) */
+    sim_i2c_respond(test_rsp.frame, test_rsp.frame_length);
+    ret = stse_platform_i2c_receive_start(0, TEST_ADDR, TEST_SPEED, 3);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+    stse_platform_i2c_receive_continue(0, TEST_ADDR, TEST_SPEED, &test_rsp.header, 1);
+    ret = stse_platform_i2c_receive_stop(0, TEST_ADDR, TEST_SPEED, length, 2);
+    if ((ret != STSE_OK) || (((uint16_t)length[0] << 8 | length[1]) != payload_length)) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
+    /* - Whole frame */
+    sim_i2c_respond(test_rsp.frame, test_rsp.frame_length);
+    ret = stse_platform_i2c_receive_start(0, TEST_ADDR, TEST_SPEED, payload_length + 5U);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+    stse_platform_i2c_receive_continue(0, TEST_ADDR, TEST_SPEED, &test_rsp.header, 1);
+    stse_platform_i2c_receive_continue(0, TEST_ADDR, TEST_SPEED, NULL, 2);
+    stse_platform_i2c_receive_continue(0, TEST_ADDR, TEST_SPEED, test_rsp.payload, payload_length);
+    ret = stse_platform_i2c_receive_stop(0, TEST_ADDR, TEST_SPEED, test_rsp.crc, 2);
+
+    /* - Core CRC pass (payload copy altered when poisoned) */
+    if (poison && payload_length != 0) {
+        test_rsp.payload[0] ^= 0xFF;
+    }
+    stse_platform_Crc16_Calculate(&test_rsp.header, 1);
+    crc = stse_platform_Crc16_Accumulate(test_rsp.payload, payload_length);
+    *pCrc_verdict = (crc == ((PLAT_UI16)test_rsp.crc[0] << 8 | test_rsp.crc[1])) ? STSE_OK : STSE_CORE_FRAME_CRC_ERROR;
+    if (poison && payload_length != 0) {
+        test_rsp.payload[0] ^= 0xFF;
+    }
+
+    return ret;
+}
+
+static void test_valid(uint16_t payload_length) {
+    stse_ReturnCode_t verdict = STSE_OK;
+    uint8_t command[4] = {0x01, 0x02, 0x03, 0x04};
+    uint16_t expected;
+
+    sim_i2c_reset();
+    test_frame_build(payload_length);
+
+    TEST_CHECK(test_core_receive(payload_length, 1, &verdict) == STSE_OK);
+    TEST_CHECK(verdict == STSE_OK);
+    TEST_CHECK(test_rsp.header == test_rsp.frame[0]);
+    TEST_CHECK_MEM(test_rsp.payload, &test_rsp.frame[3], payload_length);
+    TEST_CHECK_MEM(test_rsp.crc, &test_rsp.frame[3 + payload_length], 2);
+
+    /* - Next frame CRC computed (command header at the response header address too) */
+    crc16_Calculate(&test_rsp.header, 1);
+    expected = crc16_Accumulate(command, 4);
+    TEST_CHECK(stse_platform_Crc16_Calculate(&test_rsp.header, 1) == crc16_Calculate(&test_rsp.header, 1));
+    TEST_CHECK(stse_platform_Crc16_Accumulate(command, 4) == expected);
+}
+
+static void test_corrupted(uint16_t payload_length, uint16_t offset) {
+    stse_ReturnCode_t verdict = STSE_OK;
+
+    sim_i2c_reset();
+    test_frame_build(payload_length);
+    test_rsp.frame[offset] ^= 0x10;
+
+    TEST_CHECK(test_core_receive(payload_length, 0, &verdict) == STSE_CORE_FRAME_CRC_ERROR);
+    TEST_CHECK(verdict == STSE_CORE_FRAME_CRC_ERROR);
+}
+
+static void test_bus_errors(void) {
+    uint8_t data[3];
+
+    /* - NACK : start error, retried by the core */
+    sim_i2c_reset();
+    sim_i2c_respond(NULL, 0);
+    TEST_CHECK(stse_platform_i2c_receive_start(0, TEST_ADDR, TEST_SPEED, 3) == STSE_PLATFORM_BUS_ACK_ERROR);
+
+    /* - Frame shorter than header, length and CRC fields : not checked */
+    test_frame_build(0);
+    test_rsp.frame[4] ^= 0xFF;
+    sim_i2c_respond(test_rsp.frame, 4);
+    TEST_CHECK(stse_platform_i2c_receive_start(0, TEST_ADDR, TEST_SPEED, 4) == STSE_OK);
+    stse_platform_i2c_receive_continue(0, TEST_ADDR, TEST_SPEED, data, 1);
+    TEST_CHECK(stse_platform_i2c_receive_stop(0, TEST_ADDR, TEST_SPEED, data, 3) == STSE_OK);
+}
+
+int main(void) {
+    static const uint16_t lengths[] = {0, 1, 15, 16, 17, 64, 300, TEST_PAYLOAD_MAX};
+    uint8_t i;
+
+    crc16_Init();
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        test_valid(lengths[i]);
+        /* - Corrupted header, first and last payload bytes, CRC field */
+        test_corrupted(lengths[i], 0);
+        if (lengths[i] != 0) {
+            test_corrupted(lengths[i], 3);
+            test_corrupted(lengths[i], 2 + lengths[i]);
+        }
+        test_corrupted(lengths[i], 4 + lengths[i]);
+    }
+    test_bus_errors();
+
+    printf("Response CRC : %s\n", TEST_MODE);
+    return test_report("test_i2c_crc");
+}
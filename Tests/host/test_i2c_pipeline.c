@@ -0,0 +1,276 @@
+/* I2C PAL pipelined receive host tests, built once per response CRC mode
+ * (STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE and STSE_CONF_PLATFORM_I2C_RECEIVE_CRC)
+ * over the I2C bus model running the interrupt driven read in the background.
+ * The core receive sequence is replayed with a response area armed :
+ * - digest of the area equal to the one of the received payload, event
+ *   interrupt per byte across NBYTES reloads
+ * - timing : hashing charged to the simulated time (TEST_HASH_NS per byte) is
+ *   hidden behind the bus transfer, only the last chunk is left once the last
+ *   byte lands
+ * - length read, NACK and timeout retried by the core keep the area armed,
+ *   frames with a CRC error produce no digest
+ * - signature verification of the area, Ed25519 rejected */
+
+#include "core/stse_platform.h"
+#include "Drivers/crc16/crc16.h"
+#include "drivers/i2c/I2C.h"
+#include "i2c_sim.h"
+#include "stse_platform_crc.h"
+#include "stse_platform_drbg.h"
+#include "stse_platform_i2c.h"
+#include "test_host.h"
+
+#define TEST_ADDR 0x20
+#define TEST_SPEED 400
+#define TEST_HASH_NS 400U
+#define TEST_SIGNATURE_SIZE 64U
+
+#if defined(STSE_CONF_PLATFORM_CRC16_FUSED_RECEIVE)
+#define TEST_MODE "fused"
+#else
+#define TEST_MODE "receive loop"
+#endif
+
+stse_ReturnCode_t stse_platform_i2c_receive_start(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI16 frameLength);
+stse_ReturnCode_t stse_platform_i2c_receive_continue(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI8 *pData, PLAT_UI16 data_size);
+stse_ReturnCode_t stse_platform_i2c_receive_stop(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI8 *pData, PLAT_UI16 data_size);
+
+extern void (*cmox_stub_hash_hook)(size_t length);
+
+#define TEST_PAYLOAD_MAX 700U
+
+static struct {
+    uint8_t frame[TEST_PAYLOAD_MAX + 5U];
+    uint16_t frame_length;
+    uint8_t header;
+    uint8_t payload[TEST_PAYLOAD_MAX];
+    uint8_t crc[2];
+} test_rsp;
+
+stse_ReturnCode_t stse_platform_drbg_generate(stse_platform_drbg_id_t drbg_id, PLAT_UI8 *pOutput, PLAT_UI32 length) {
+    static uint8_t seed;
+
+    while (length-- > 0) {
+        *pOutput++ = (uint8_t)(seed++ * 13U + 7U);
+    }
+    return STSE_OK;
+}
+
+static void test_hash_hook(size_t length) {
+    sim_i2c_cpu((uint64_t)length * TEST_HASH_NS);
+}
+
+static void test_frame_build(const uint8_t *pPayload, uint16_t payload_length) {
+    uint8_t *pFrame = test_rsp.frame;
+    uint16_t crc;
+
+    pFrame[0] = 0x00;
+    pFrame[1] = (uint8_t)(payload_length >> 8);
+    pFrame[2] = (uint8_t)payload_length;
+    memcpy(&pFrame[3], pPayload, payload_length);
+    crc16_Calculate(pFrame, 1);
+    crc = crc16_Accumulate(&pFrame[3], payload_length);
+    pFrame[3 + payload_length] = (uint8_t)(crc >> 8);
+    pFrame[4 + payload_length] = (uint8_t)crc;
+    test_rsp.frame_length = payload_length + 5U;
+}
+
+static void test_payload_build(uint8_t *pPayload, uint16_t payload_length) {
+    uint16_t i;
+
+    for (i = 0; i < payload_length; i++) {
+        pPayload[i] = (uint8_t)(i * 29 + payload_length);
+    }
+}
+
+/* Core receive sequence : length read, full frame read retried on bus errors
+ * (the first nacks attempts not acknowledged), then the frame elements */
+static stse_ReturnCode_t test_core_receive(uint16_t payload_length, uint8_t nacks) {
+    stse_ReturnCode_t ret;
+    uint8_t length[2];
+    uint8_t attempt;
+
+    sim_i2c_respond(test_rsp.frame, test_rsp.frame_length);
+    ret = stse_platform_i2c_receive_start(0, TEST_ADDR, TEST_SPEED, 3);
+    if (ret != STSE_OK) {
+        return ret;
+    }
+    stse_platform_i2c_receive_continue(0, TEST_ADDR, TEST_SPEED, &test_rsp.header, 1);
+    ret = stse_platform_i2c_receive_stop(0, TEST_ADDR, TEST_SPEED, length, 2);
+    if ((ret != STSE_OK) || (((uint16_t)length[0] << 8 | length[1]) != payload_length)) {
+        return STSE_PLATFORM_BUFFER_ERR;
+    }
+
+    for (attempt = 0;; attempt++) {
+        if (attempt < nacks) {
+            sim_i2c_respond(NULL, 0);
+        } else {
+            sim_i2c_respond(test_rsp.frame, test_rsp.frame_length);
+        }
+        ret = stse_platform_i2c_receive_start(0, TEST_ADDR, TEST_SPEED, payload_length + 5U);
+        if ((ret != STSE_PLATFORM_BUS_ACK_ERROR) || (attempt >= nacks)) {
+            break;
+        }
+    }
+    if (ret != STSE_OK) {
+        return ret;
+    }
+    stse_platform_i2c_receive_continue(0, TEST_ADDR, TEST_SPEED, &test_rsp.header, 1);
+    stse_platform_i2c_receive_continue(0, TEST_ADDR, TEST_SPEED, NULL, 2);
+    stse_platform_i2c_receive_continue(0, TEST_ADDR, TEST_SPEED, test_rsp.payload, payload_length);
+    return stse_platform_i2c_receive_stop(0, TEST_ADDR, TEST_SPEED, test_rsp.crc, 2);
+}
+
+static void test_digest(const uint8_t *pData, uint16_t length, uint8_t *pDigest) {
+    stse_platform_hash_stream_t stream;
+    PLAT_UI16 digest_length = 32;
+
+    TEST_CHECK(stse_platform_hash_stream_init(&stream, STSE_SHA_256) == STSE_OK);
+    TEST_CHECK(stse_platform_hash_stream_append(&stream, pData, length) == STSE_OK);
+    TEST_CHECK(stse_platform_hash_stream_finish(&stream, pDigest, &digest_length) == STSE_OK);
+}
+
+static void test_pipelined(uint16_t payload_length) {
+    uint8_t payload[TEST_PAYLOAD_MAX];
+    uint8_t expected[32], digest[STSE_PLATFORM_I2C_DIGEST_MAX_SIZE];
+    PLAT_UI16 digest_length = sizeof(digest);
+    uint64_t rx_ns, buffered_ns, pipelined_ns;
+
+    test_payload_build(payload, payload_length);
+    test_frame_build(payload, payload_length);
+
+    /* - Buffered : frame received, then hashed */
+    sim_i2c_reset();
+    TEST_CHECK(test_core_receive(payload_length, 0) == STSE_OK);
+    rx_ns = sim_i2c_now_ns;
+    cmox_stub_hash_hook = test_hash_hook;
+    test_digest(test_rsp.payload, payload_length, expected);
+    cmox_stub_hash_hook = NULL;
+    buffered_ns = sim_i2c_now_ns;
+    TEST_CHECK(buffered_ns - rx_ns == (uint64_t)payload_length * TEST_HASH_NS);
+
+    /* - Pipelined : payload hashed while it is received */
+    sim_i2c_reset();
+    cmox_stub_hash_hook = test_hash_hook;
+    TEST_CHECK(stse_platform_i2c_receive_hash_arm(3, payload_length, STSE_SHA_256) == STSE_OK);
+    TEST_CHECK(test_core_receive(payload_length, 0) == STSE_OK);
+    pipelined_ns = sim_i2c_now_ns;
+    cmox_stub_hash_hook = NULL;
+    TEST_CHECK(sim_i2c_irqs == test_rsp.frame_length);
+    TEST_CHECK_MEM(test_rsp.payload, payload, payload_length);
+    TEST_CHECK(stse_platform_i2c_receive_hash_get(digest, &digest_length) == STSE_OK);
+    TEST_CHECK(digest_length == 32);
+    TEST_CHECK_MEM(digest, expected, 32);
+
+    /* - Address byte and the last chunk at most on top of the bus transfer */
+    TEST_CHECK(pipelined_ns <= rx_ns + sim_i2c_byte_ns + STSE_PLATFORM_I2C_PIPELINE_CHUNK_SIZE * TEST_HASH_NS + 2U * sim_i2c_poll_ns);
+    printf("%4u bytes : buffered %llu us, pipelined %llu us\n", payload_length,
+           (unsigned long long)(buffered_ns / 1000), (unsigned long long)(pipelined_ns / 1000));
+
+    /* - One digest per arm */
+    digest_length = sizeof(digest);
+    TEST_CHECK(stse_platform_i2c_receive_hash_get(digest, &digest_length) == STSE_PLATFORM_HASH_ERROR);
+}
+
+static void test_retries(void) {
+    uint8_t payload[300];
+    uint8_t expected[32], digest[32];
+    PLAT_UI16 digest_length = sizeof(digest);
+    uint64_t start_ns;
+
+    test_payload_build(payload, sizeof(payload));
+    test_frame_build(payload, sizeof(payload));
+    test_digest(&payload[10], 200, expected);
+
+    /* - Core retries on NACK */
+    sim_i2c_reset();
+    TEST_CHECK(stse_platform_i2c_receive_hash_arm(13, 200, STSE_SHA_256) == STSE_OK);
+    TEST_CHECK(test_core_receive(sizeof(payload), 3) == STSE_OK);
+    TEST_CHECK(stse_platform_i2c_receive_hash_get(digest, &digest_length) == STSE_OK);
+    TEST_CHECK_MEM(digest, expected, 32);
+
+    /* - Stalled transfer aborted on timeout, then read again */
+    sim_i2c_reset();
+    TEST_CHECK(stse_platform_i2c_receive_hash_arm(13, 200, STSE_SHA_256) == STSE_OK);
+    sim_i2c_respond(test_rsp.frame, test_rsp.frame_length);
+    sim_i2c_byte_ns = 10000000;
+    start_ns = sim_i2c_now_ns;
+    TEST_CHECK(stse_platform_i2c_receive_start(0, TEST_ADDR, TEST_SPEED, test_rsp.frame_length) == STSE_PLATFORM_BUS_ACK_ERROR);
+    TEST_CHECK(sim_i2c_now_ns - start_ns >= (uint64_t)STSE_PLATFORM_I2C_RECEIVE_TIMEOUT_MS * 1000000);
+    TEST_CHECK(sim_i2c_now_ns - start_ns < (uint64_t)STSE_PLATFORM_I2C_RECEIVE_TIMEOUT_MS * 1000000 + sim_i2c_byte_ns);
+    TEST_CHECK(i2c_read_it_status() == I2C_XFER_ERROR);
+    sim_i2c_byte_ns = 22500;
+    digest_length = sizeof(digest);
+    TEST_CHECK(test_core_receive(sizeof(payload), 0) == STSE_OK);
+    TEST_CHECK(stse_platform_i2c_receive_hash_get(digest, &digest_length) == STSE_OK);
+    TEST_CHECK_MEM(digest, expected, 32);
+
+    /* - CRC error : no digest */
+    sim_i2c_reset();
+    test_rsp.frame[100] ^= 0x01;
+    TEST_CHECK(stse_platform_i2c_receive_hash_arm(13, 200, STSE_SHA_256) == STSE_OK);
+    TEST_CHECK(test_core_receive(sizeof(payload), 0) == STSE_CORE_FRAME_CRC_ERROR);
+    digest_length = sizeof(digest);
+    TEST_CHECK(stse_platform_i2c_receive_hash_get(digest, &digest_length) == STSE_PLATFORM_HASH_ERROR);
+
+    /* - Frame received without arm : blocking read, no digest */
+    test_rsp.frame[100] ^= 0x01;
+    sim_i2c_reset();
+    TEST_CHECK(test_core_receive(sizeof(payload), 0) == STSE_OK);
+    TEST_CHECK(sim_i2c_irqs == 0);
+    TEST_CHECK(stse_platform_i2c_receive_hash_get(digest, &digest_length) == STSE_PLATFORM_HASH_ERROR);
+
+    /* - Area beyond the frame : frame read without hashing, arm kept */
+    sim_i2c_reset();
+    TEST_CHECK(stse_platform_i2c_receive_hash_arm(13, 400, STSE_SHA_256) == STSE_OK);
+    TEST_CHECK(test_core_receive(sizeof(payload), 0) == STSE_OK);
+    TEST_CHECK(sim_i2c_irqs == 0);
+    TEST_CHECK(stse_platform_i2c_receive_hash_get(digest, &digest_length) == STSE_PLATFORM_HASH_ERROR);
+}
+
+static void test_verify(void) {
+    uint8_t payload[200 + TEST_SIGNATURE_SIZE];
+    uint8_t priv_key[32], pub_key[64], digest[32];
+
+    test_payload_build(payload, 200);
+    test_digest(payload, 200, digest);
+    TEST_CHECK(stse_platform_ecc_generate_key_pair(STSE_ECC_KT_NIST_P_256, priv_key, pub_key) == STSE_OK);
+    TEST_CHECK(stse_platform_ecc_sign(STSE_ECC_KT_NIST_P_256, priv_key, digest, 32, &payload[200]) == STSE_OK);
+
+    /* - Signed area followed by its signature */
+    test_frame_build(payload, sizeof(payload));
+    sim_i2c_reset();
+    TEST_CHECK(stse_platform_i2c_receive_hash_arm(3, 200, STSE_SHA_256) == STSE_OK);
+    TEST_CHECK(test_core_receive(sizeof(payload), 0) == STSE_OK);
+    TEST_CHECK(stse_platform_i2c_receive_verify(STSE_ECC_KT_NIST_P_256, pub_key, &test_rsp.payload[200]) == STSE_OK);
+
+    /* - Altered signed byte */
+    payload[5] ^= 0x80;
+    test_frame_build(payload, sizeof(payload));
+    sim_i2c_reset();
+    TEST_CHECK(stse_platform_i2c_receive_hash_arm(3, 200, STSE_SHA_256) == STSE_OK);
+    TEST_CHECK(test_core_receive(sizeof(payload), 0) == STSE_OK);
+    TEST_CHECK(stse_platform_i2c_receive_verify(STSE_ECC_KT_NIST_P_256, pub_key, &test_rsp.payload[200]) != STSE_OK);
+
+    /* - Ed25519 rejected, arm ended */
+    TEST_CHECK(stse_platform_i2c_receive_hash_arm(3, 200, STSE_SHA_256) == STSE_OK);
+    TEST_CHECK(stse_platform_i2c_receive_verify(STSE_ECC_KT_ED25519, pub_key, &test_rsp.payload[200]) == STSE_PLATFORM_INVALID_PARAMETER);
+    sim_i2c_reset();
+    TEST_CHECK(test_core_receive(sizeof(payload), 0) == STSE_OK);
+    TEST_CHECK(sim_i2c_irqs == 0);
+}
+
+int main(void) {
+    static const uint16_t lengths[] = {1, 64, 300, TEST_PAYLOAD_MAX};
+    uint8_t i;
+
+    crc16_Init();
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        test_pipelined(lengths[i]);
+    }
+    test_retries();
+    test_verify();
+
+    printf("Response CRC : %s\n", TEST_MODE);
+    return test_report("test_i2c_pipeline");
+}
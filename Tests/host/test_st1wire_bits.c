@@ -0,0 +1,118 @@
+/* ST1Wire bit level host tests (fake GPIO bus model, see st1wire_sim.h) :
+ * - host bytes sent with the long / short pulse widths of the speed profile
+ *   on the specialized bus 0 line
+ * - device bytes decoded from the relative high / low durations
+ * - acknowledge and receive timeouts bound by the us timer : same outcome and
+ *   same elapsed time whatever the duration of one polling loop iteration */
+
+#include "st1wire.h"
+#include "st1wire_sim.h"
+#include "test_host.h"
+
+#define TEST_PIN ST1WIRE_PLATFORM_BUS0_PIN
+
+static const uint8_t test_frame[] = {0xA5, 0x3C, 0x00, 0xFF};
+
+static void test_line_specialization(void) {
+    st1wire_platform_line_t line;
+
+    /* - Single bus build : constant bus 0 line, whatever the bus index */
+    st1wire_platform_line_get(3, &line);
+    TEST_CHECK(line.port == GPIOA);
+    TEST_CHECK(line.set_mask == (1UL << TEST_PIN));
+    TEST_CHECK(line.clear_mask == (1UL << (TEST_PIN + 16)));
+    TEST_CHECK(line.idr_mask == (1UL << TEST_PIN));
+    TEST_CHECK(line.mode_mask == (0b11UL << (TEST_PIN * 2)));
+    TEST_CHECK(line.mode_out == (0b01UL << (TEST_PIN * 2)));
+}
+
+static void test_send(uint8_t speed, uint32_t poll_ns) {
+    const st1wire_timing_t *pTiming = st1wire_timing_get(0, 0, speed);
+    static const uint8_t frame_ack = 0x20;
+
+    sim_reset();
+    sim_poll_ns = poll_ns;
+    sim_expect_timing(pTiming->long_pulse, pTiming->short_pulse);
+    sim_device_attach(TEST_PIN, 1);
+    sim_device_timing(TEST_PIN, pTiming->long_pulse, pTiming->short_pulse, 4, pTiming->ack_pulse);
+    sim_device_queue(TEST_PIN, &frame_ack, 1);
+
+    TEST_CHECK(st1wire_SendFrame(0, 0, speed, (uint8_t *)test_frame, sizeof(test_frame)) == ST1WIRE_OK);
+    TEST_CHECK(sim_host_byte_count[TEST_PIN] == 2 + sizeof(test_frame));
+    TEST_CHECK(sim_host_bytes[TEST_PIN][0] == 0x00);
+    TEST_CHECK(sim_host_bytes[TEST_PIN][1] == sizeof(test_frame));
+    TEST_CHECK_MEM(&sim_host_bytes[TEST_PIN][2], test_frame, sizeof(test_frame));
+    TEST_CHECK(sim_timing_errors == 0);
+}
+
+static void test_receive(uint8_t speed, uint32_t poll_ns) {
+    const st1wire_timing_t *pTiming = st1wire_timing_get(0, 0, speed);
+    static const uint8_t answer[] = {0x20, 0x00, 0x03, 0x81, 0x42, 0x7E};
+    uint8_t frame[8] = {0};
+    uint16_t frame_length = 0;
+
+    sim_reset();
+    sim_poll_ns = poll_ns;
+    sim_device_attach(TEST_PIN, 1);
+    sim_device_timing(TEST_PIN, pTiming->long_pulse, pTiming->short_pulse, 4, pTiming->ack_pulse);
+    sim_device_queue(TEST_PIN, answer, sizeof(answer));
+
+    TEST_CHECK(st1wire_ReceiveFrame(0, 0, speed, frame, sizeof(frame), &frame_length) == ST1WIRE_OK);
+    TEST_CHECK(frame_length == 3);
+    TEST_CHECK_MEM(frame, &answer[3], 3);
+}
+
+static uint64_t test_ack_timeout(uint32_t poll_ns) {
+    sim_reset();
+    sim_poll_ns = poll_ns;
+
+    /* - No device on the line : no acknowledge of the length byte */
+    TEST_CHECK(st1wire_SendFrame(0, 0, 1, (uint8_t *)test_frame, sizeof(test_frame)) == ST1WIRE_BUS_ACK_ERROR);
+    return sim_now_ns;
+}
+
+static uint64_t test_receive_timeout(uint32_t poll_ns) {
+    static const uint8_t answer[] = {0x20, 0x00, 0x03, 0x81};
+    uint8_t frame[8];
+    uint16_t frame_length = 0;
+
+    sim_reset();
+    sim_poll_ns = poll_ns;
+    sim_device_attach(TEST_PIN, 1);
+    sim_device_queue(TEST_PIN, answer, sizeof(answer));
+
+    /* - Device silent after the first payload byte */
+    TEST_CHECK(st1wire_ReceiveFrame(0, 0, 0, frame, sizeof(frame), &frame_length) == ST1WIRE_BUS_RECEIVE_TIMEOUT);
+    return sim_now_ns;
+}
+
+static uint64_t test_distance(uint64_t a, uint64_t b) {
+    return (a > b) ? a - b : b - a;
+}
+
+int main(void) {
+    static const uint32_t poll_ns[] = {10, 250, 1000};
+    uint64_t ack_timeout_ns[3], receive_timeout_ns[3];
+    uint8_t i;
+
+    st1wire_init();
+    test_line_specialization();
+
+    for (i = 0; i < 3; i++) {
+        test_send(0, poll_ns[i]);
+        test_send(1, poll_ns[i]);
+        test_receive(0, poll_ns[i]);
+        test_receive(1, poll_ns[i]);
+        ack_timeout_ns[i] = test_ack_timeout(poll_ns[i]);
+        receive_timeout_ns[i] = test_receive_timeout(poll_ns[i]);
+    }
+
+    /* - Timeouts elapse in time, not in loop iterations */
+    for (i = 1; i < 3; i++) {
+        TEST_CHECK(test_distance(ack_timeout_ns[i], ack_timeout_ns[0]) < 8000);
+        TEST_CHECK(test_distance(receive_timeout_ns[i], receive_timeout_ns[0]) < 8000);
+    }
+    TEST_CHECK(receive_timeout_ns[0] > (uint64_t)ST1WIRE_RECEIVE_TIMEOUT * 1000);
+
+    return test_report("test_st1wire_bits");
+}
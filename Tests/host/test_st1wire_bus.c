@@ -0,0 +1,124 @@
+/* ST1Wire bus table host tests (ST1WIRE_PLATFORM_BUS_COUNT = 3) :
+ * - only the configured lines are initialized, unknown bus indexes fall back
+ *   on bus 0
+ * - broadcast groups : single BSRR write per edge with the pins of all the
+ *   grouped lines, IDR sampled once and mapped back to bus indexes, groups
+ *   spanning unconfigured buses rejected
+ * - lockstep broadcast frame over the fake GPIO bus model : same bytes and
+ *   pulse widths on every line, acknowledge mask per line */
+
+#include "st1wire.h"
+#include "st1wire_sim.h"
+#include "test_host.h"
+
+#define TEST_PIN(bus) ((bus) == 0 ? ST1WIRE_PLATFORM_BUS0_PIN : (bus) == 1 ? ST1WIRE_PLATFORM_BUS1_PIN \
+                                                                           : ST1WIRE_PLATFORM_BUS2_PIN)
+
+static void test_init(void) {
+    uint8_t bus;
+
+    sim_reset();
+    st1wire_init();
+
+    /* - Configured lines : open-drain outputs */
+    for (bus = 0; bus < ST1WIRE_PLATFORM_BUS_COUNT; bus++) {
+        TEST_CHECK(((GPIOA->MODER >> (TEST_PIN(bus) * 2)) & 0b11) == 0b01);
+        TEST_CHECK(GPIOA->OTYPER & (1UL << TEST_PIN(bus)));
+    }
+    /* - Bus 3 line (Arduino SPI MISO) left untouched */
+    TEST_CHECK(((GPIOA->MODER >> (ST1WIRE_PLATFORM_BUS3_PIN * 2)) & 0b11) == 0);
+    TEST_CHECK((GPIOA->OTYPER & (1UL << ST1WIRE_PLATFORM_BUS3_PIN)) == 0);
+}
+
+static void test_lines(void) {
+    st1wire_platform_line_t line;
+
+    st1wire_platform_line_get(2, &line);
+    TEST_CHECK(line.set_mask == (1UL << ST1WIRE_PLATFORM_BUS2_PIN));
+    TEST_CHECK(line.clear_mask == (1UL << (ST1WIRE_PLATFORM_BUS2_PIN + 16)));
+    TEST_CHECK(line.mode_out == (0b01UL << (ST1WIRE_PLATFORM_BUS2_PIN * 2)));
+    st1wire_platform_line_get(ST1WIRE_PLATFORM_BUS_COUNT, &line);
+    TEST_CHECK(line.set_mask == (1UL << ST1WIRE_PLATFORM_BUS0_PIN));
+}
+
+static void test_group_masks(void) {
+    st1wire_platform_group_t group;
+    uint32_t pins = (1UL << ST1WIRE_PLATFORM_BUS0_PIN) | (1UL << ST1WIRE_PLATFORM_BUS2_PIN);
+
+    /* - Rejected groups */
+    TEST_CHECK(st1wire_platform_group_init(0, &group) == 0);
+    TEST_CHECK(st1wire_platform_group_init(0b1000, &group) == 0);
+    TEST_CHECK(st1wire_platform_group_init(0b1011, &group) == 0);
+    TEST_CHECK(group.bus_mask == 0 && group.pin_mask == 0);
+
+    /* - Buses 0 and 2 */
+    TEST_CHECK(st1wire_platform_group_init(0b101, &group) == 1);
+    TEST_CHECK(group.port == GPIOA);
+    TEST_CHECK(group.bus_mask == 0b101);
+    TEST_CHECK(group.pin_mask == pins);
+
+    /* - One BSRR write drives all the lines of the group */
+    GPIOA->BSRR = 0;
+    st1wire_platform_group_set(&group);
+    TEST_CHECK(GPIOA->BSRR == pins);
+    st1wire_platform_group_clear(&group);
+    TEST_CHECK(GPIOA->BSRR == (pins << 16));
+    GPIOA->BSRR = 0;
+
+    /* - Output / input mode of the group lines only */
+    GPIOA->MODER = 0;
+    st1wire_platform_group_out(&group);
+    TEST_CHECK(GPIOA->MODER == ((0b01UL << (ST1WIRE_PLATFORM_BUS0_PIN * 2)) | (0b01UL << (ST1WIRE_PLATFORM_BUS2_PIN * 2))));
+    GPIOA->MODER |= 0b01UL << (ST1WIRE_PLATFORM_BUS1_PIN * 2);
+    st1wire_platform_group_in(&group);
+    TEST_CHECK(GPIOA->MODER == (0b01UL << (ST1WIRE_PLATFORM_BUS1_PIN * 2)));
+
+    /* - IDR levels mapped back to bus indexes */
+    GPIOA->IDR = 1UL << ST1WIRE_PLATFORM_BUS2_PIN | 1UL << ST1WIRE_PLATFORM_BUS1_PIN;
+    TEST_CHECK(st1wire_platform_group_get(&group) == 0b100);
+    GPIOA->IDR = 0xFFFF;
+    TEST_CHECK(st1wire_platform_group_get(&group) == 0b101);
+}
+
+static void test_broadcast(uint32_t devices, uint32_t expected_ack) {
+    static const uint8_t frame[] = {0x12, 0xC3, 0x5A};
+    static const uint8_t frame_ack = 0x20;
+    const st1wire_timing_t *pTiming = st1wire_timing_get(ST1WIRE_BROADCAST_TIMING_BUS, 0, 0);
+    uint32_t ack_mask = 0xFFFFFFFF;
+    uint8_t bus;
+
+    sim_reset();
+    st1wire_init();
+    sim_expect_timing(pTiming->long_pulse, pTiming->short_pulse);
+    for (bus = 0; bus < ST1WIRE_PLATFORM_BUS_COUNT; bus++) {
+        if (devices & (1UL << bus)) {
+            sim_device_attach(TEST_PIN(bus), 1);
+            sim_device_queue(TEST_PIN(bus), &frame_ack, 1);
+        }
+    }
+
+    TEST_CHECK(st1wire_SendFrameBroadcast(0b111, 0, 0, (uint8_t *)frame, sizeof(frame), &ack_mask) ==
+               ((expected_ack == 0b111) ? ST1WIRE_OK : ST1WIRE_BUS_ACK_ERROR));
+    TEST_CHECK(ack_mask == expected_ack);
+    TEST_CHECK(sim_timing_errors == 0);
+
+    /* - Same bytes received on every acknowledging line */
+    for (bus = 0; bus < ST1WIRE_PLATFORM_BUS_COUNT; bus++) {
+        if (expected_ack & (1UL << bus)) {
+            TEST_CHECK(sim_host_byte_count[TEST_PIN(bus)] == 2 + sizeof(frame));
+            TEST_CHECK(sim_host_bytes[TEST_PIN(bus)][1] == sizeof(frame));
+            TEST_CHECK_MEM(&sim_host_bytes[TEST_PIN(bus)][2], frame, sizeof(frame));
+        }
+    }
+}
+
+int main(void) {
+    test_init();
+    test_lines();
+    test_group_masks();
+    test_broadcast(0b111, 0b111);
+    /* - Bus 1 without device : dropped from the group at its first byte */
+    test_broadcast(0b101, 0b101);
+
+    return test_report("test_st1wire_bus");
+}
@@ -0,0 +1,135 @@
+/* ST1Wire PAL frame host tests, built once per PAL mode (buffered and
+ * STSE_PLATFORM_ST1WIRE_STREAMING) over the fake GPIO bus model :
+ * - fragments sent through send_start / continue / stop (NULL fragments sent
+ *   as zeros) produce the bus trace of st1wire_SendFrame on the whole frame
+ * - fragments received through receive_start / continue / stop (NULL
+ *   fragments discarded) produce the bus trace and data of
+ *   st1wire_ReceiveFrame
+ * - missing acknowledge reported as STSE_PLATFORM_BUS_ACK_ERROR */
+
+#include "core/stse_platform.h"
+#include "st1wire.h"
+#include "st1wire_sim.h"
+#include "test_host.h"
+
+#define TEST_PIN ST1WIRE_PLATFORM_BUS0_PIN
+#define TEST_SPEED 0
+
+stse_ReturnCode_t stse_platform_st1wire_send_start(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI16 FrameLength);
+stse_ReturnCode_t stse_platform_st1wire_send_continue(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI8 *pData, PLAT_UI16 data_size);
+stse_ReturnCode_t stse_platform_st1wire_send_stop(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI8 *pData, PLAT_UI16 data_size);
+stse_ReturnCode_t stse_platform_st1wire_receive_start(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI16 frameLength);
+stse_ReturnCode_t stse_platform_st1wire_receive_continue(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI8 *pData, PLAT_UI16 data_size);
+stse_ReturnCode_t stse_platform_st1wire_receive_stop(PLAT_UI8 busID, PLAT_UI8 devAddr, PLAT_UI16 speed, PLAT_UI8 *pData, PLAT_UI16 data_size);
+
+static const uint8_t test_header[] = {0x11, 0x22, 0x33};
+static const uint8_t test_payload[] = {0x44, 0x55};
+static const uint8_t test_frame[] = {0x11, 0x22, 0x33, 0x00, 0x00, 0x44, 0x55};
+static const uint8_t test_answer[] = {0x20, 0x00, 0x06, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5};
+
+static sim_edge_t test_reference[SIM_TRACE_MAX];
+static size_t test_reference_count;
+
+static void test_bus_setup(uint8_t ack, const uint8_t *pAnswer, size_t answer_length) {
+    sim_reset();
+    st1wire_init();
+    if (ack) {
+        sim_device_attach(TEST_PIN, 1);
+        sim_device_queue(TEST_PIN, pAnswer, answer_length);
+    }
+}
+
+static void test_reference_save(void) {
+    memcpy(test_reference, sim_trace, sim_trace_count * sizeof(sim_trace[0]));
+    test_reference_count = sim_trace_count;
+}
+
+static int test_trace_matches(void) {
+    size_t i;
+
+    if (sim_trace_count != test_reference_count) {
+        return 0;
+    }
+    for (i = 0; i < sim_trace_count; i++) {
+        if ((sim_trace[i].time_ns != test_reference[i].time_ns) ||
+            (sim_trace[i].pin != test_reference[i].pin) ||
+            (sim_trace[i].level != test_reference[i].level)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static stse_ReturnCode_t test_pal_send(void) {
+    stse_ReturnCode_t ret;
+
+    ret = stse_platform_st1wire_send_start(0, 0, TEST_SPEED, sizeof(test_frame));
+    if (ret == STSE_OK) {
+        ret = stse_platform_st1wire_send_continue(0, 0, TEST_SPEED, (PLAT_UI8 *)test_header, sizeof(test_header));
+    }
+    if (ret == STSE_OK) {
+        ret = stse_platform_st1wire_send_continue(0, 0, TEST_SPEED, NULL, 2);
+    }
+    if (ret == STSE_OK) {
+        ret = stse_platform_st1wire_send_stop(0, 0, TEST_SPEED, (PLAT_UI8 *)test_payload, sizeof(test_payload));
+    }
+    return ret;
+}
+
+static void test_send(void) {
+    static const uint8_t frame_ack = 0x20;
+
+    /* - Reference : whole frame sent by the driver */
+    test_bus_setup(1, &frame_ack, 1);
+    TEST_CHECK(st1wire_SendFrame(0, 0, TEST_SPEED, (uint8_t *)test_frame, sizeof(test_frame)) == ST1WIRE_OK);
+    test_reference_save();
+
+    /* - Same bus trace from the PAL fragments */
+    test_bus_setup(1, &frame_ack, 1);
+    TEST_CHECK(test_pal_send() == STSE_OK);
+    TEST_CHECK(sim_host_byte_count[TEST_PIN] == 2 + sizeof(test_frame));
+    TEST_CHECK_MEM(&sim_host_bytes[TEST_PIN][2], test_frame, sizeof(test_frame));
+    TEST_CHECK(test_trace_matches());
+
+    /* - No device */
+    test_bus_setup(0, NULL, 0);
+    TEST_CHECK(test_pal_send() == STSE_PLATFORM_BUS_ACK_ERROR);
+}
+
+static void test_receive(void) {
+    uint8_t reference[16] = {0};
+    uint8_t header[2] = {0};
+    uint8_t payload[3] = {0};
+    uint16_t length = 0;
+
+    /* - Reference : whole frame received by the driver */
+    test_bus_setup(1, test_answer, sizeof(test_answer));
+    TEST_CHECK(st1wire_ReceiveFrame(0, 0, TEST_SPEED, reference, sizeof(reference), &length) == ST1WIRE_OK);
+    TEST_CHECK(length == 6);
+    test_reference_save();
+
+    /* - Same bus trace and data from the PAL fragments */
+    test_bus_setup(1, test_answer, sizeof(test_answer));
+    TEST_CHECK(stse_platform_st1wire_receive_start(0, 0, TEST_SPEED, sizeof(reference)) == STSE_OK);
+    TEST_CHECK(stse_platform_st1wire_receive_continue(0, 0, TEST_SPEED, header, sizeof(header)) == STSE_OK);
+    TEST_CHECK(stse_platform_st1wire_receive_continue(0, 0, TEST_SPEED, NULL, 1) == STSE_OK);
+    TEST_CHECK(stse_platform_st1wire_receive_stop(0, 0, TEST_SPEED, payload, sizeof(payload)) == STSE_OK);
+    TEST_CHECK_MEM(header, &reference[0], sizeof(header));
+    TEST_CHECK_MEM(payload, &reference[3], sizeof(payload));
+    TEST_CHECK(test_trace_matches());
+
+    /* - No device */
+    test_bus_setup(0, NULL, 0);
+    TEST_CHECK(stse_platform_st1wire_receive_start(0, 0, TEST_SPEED, sizeof(reference)) == STSE_PLATFORM_BUS_ACK_ERROR);
+}
+
+int main(void) {
+    test_send();
+    test_receive();
+
+#ifdef STSE_PLATFORM_ST1WIRE_STREAMING
+    return test_report("test_st1wire_stream (streaming)");
+#else
+    return test_report("test_st1wire_stream (buffered)");
+#endif
+}
@@ -0,0 +1,148 @@
+/* ST1Wire timing profile host tests :
+ * - per device profiles (bus, device, speed), default timings otherwise,
+ *   profile table exhaustion and release
+ * - calibration : each parameter lowered by its step down to the last value
+ *   the probe accepts, then widened by ST1WIRE_CALIBRATION_MARGIN_PERCENT
+ *   (rounded up, capped to the default value) */
+
+#include "st1wire.h"
+#include "st1wire_sim.h"
+#include "test_host.h"
+
+/* Smallest values the simulated device accepts */
+typedef struct {
+    uint16_t long_pulse;
+    uint16_t inter_byte_delay;
+    uint16_t inter_frame_delay;
+    unsigned probes;
+} test_device_t;
+
+static st1wire_ReturnCode_t test_probe(uint8_t bus_addr, uint8_t dev_addr, uint8_t speed, void *pCtx) {
+    test_device_t *pDevice = pCtx;
+    const st1wire_timing_t *pTiming = st1wire_timing_get(bus_addr, dev_addr, speed);
+
+    pDevice->probes++;
+    if ((pTiming->long_pulse < pDevice->long_pulse) ||
+        (pTiming->inter_byte_delay < pDevice->inter_byte_delay) ||
+        (pTiming->inter_frame_delay < pDevice->inter_frame_delay)) {
+        return ST1WIRE_BUS_ACK_ERROR;
+    }
+    return ST1WIRE_OK;
+}
+
+/* Expected calibration result of one parameter */
+static uint16_t test_expected(uint16_t value, uint16_t floor, uint16_t minimum, uint16_t step) {
+    uint32_t margin;
+
+    while ((value >= floor + step) && (value - step >= minimum)) {
+        value -= step;
+    }
+    margin = ((uint32_t)value * ST1WIRE_CALIBRATION_MARGIN_PERCENT + 99) / 100;
+    return (uint16_t)(value + margin);
+}
+
+static uint16_t test_capped(uint16_t value, uint16_t max) {
+    return (value > max) ? max : value;
+}
+
+static void test_profiles(void) {
+    const st1wire_timing_t *pSlow = st1wire_timing_get(0, 0x10, 0);
+    const st1wire_timing_t *pFast = st1wire_timing_get(0, 0x10, 1);
+    st1wire_timing_t timing = *pSlow;
+    uint8_t i;
+
+    /* - Default timings of the speed when no profile is set */
+    TEST_CHECK(pSlow->long_pulse == ST1WIRE_2C_LONG_PULSE);
+    TEST_CHECK(pSlow->inter_byte_delay == ST1WIRE_2C_INTER_BYTE_DELAY);
+    TEST_CHECK(pSlow->inter_frame_delay == ST1WIRE_2C_INTER_FRAME_DELAY);
+    TEST_CHECK(pFast->long_pulse == ST1WIRE_3C_LONG_PULSE);
+    TEST_CHECK(pFast->start_pulse == ST1WIRE_3C_START_PULSE);
+
+    /* - Profile bound to its bus, device and speed only */
+    timing.long_pulse = 11;
+    TEST_CHECK(st1wire_timing_set(1, 0x10, 0, &timing) == ST1WIRE_OK);
+    TEST_CHECK(st1wire_timing_get(1, 0x10, 0)->long_pulse == 11);
+    TEST_CHECK(st1wire_timing_get(0, 0x10, 0)->long_pulse == ST1WIRE_2C_LONG_PULSE);
+    TEST_CHECK(st1wire_timing_get(1, 0x11, 0)->long_pulse == ST1WIRE_2C_LONG_PULSE);
+    TEST_CHECK(st1wire_timing_get(1, 0x10, 1)->long_pulse == ST1WIRE_3C_LONG_PULSE);
+
+    /* - Update in place, then table exhaustion */
+    timing.long_pulse = 12;
+    TEST_CHECK(st1wire_timing_set(1, 0x10, 0, &timing) == ST1WIRE_OK);
+    TEST_CHECK(st1wire_timing_get(1, 0x10, 0)->long_pulse == 12);
+    for (i = 1; i < ST1WIRE_TIMING_PROFILE_COUNT; i++) {
+        TEST_CHECK(st1wire_timing_set(2, i, 0, &timing) == ST1WIRE_OK);
+    }
+    TEST_CHECK(st1wire_timing_set(3, 0x10, 0, &timing) == ST1WIRE_INVALID_PARAMETER);
+
+    /* - Released profiles fall back on the defaults and free their slot */
+    TEST_CHECK(st1wire_timing_set(1, 0x10, 0, NULL) == ST1WIRE_OK);
+    TEST_CHECK(st1wire_timing_get(1, 0x10, 0)->long_pulse == ST1WIRE_2C_LONG_PULSE);
+    TEST_CHECK(st1wire_timing_set(1, 0x10, 0, NULL) == ST1WIRE_OK);
+    TEST_CHECK(st1wire_timing_set(3, 0x10, 0, &timing) == ST1WIRE_OK);
+    TEST_CHECK(st1wire_timing_set(3, 0x10, 0, NULL) == ST1WIRE_OK);
+    for (i = 1; i < ST1WIRE_TIMING_PROFILE_COUNT; i++) {
+        TEST_CHECK(st1wire_timing_set(2, i, 0, NULL) == ST1WIRE_OK);
+    }
+}
+
+static void test_calibrate(uint8_t speed, const test_device_t *pLimits) {
+    const st1wire_timing_t defaults = *st1wire_timing_get(0, 0x20, speed);
+    test_device_t device = *pLimits;
+    st1wire_timing_t tuned;
+
+    TEST_CHECK(st1wire_calibrate(0, 0x20, speed, test_probe, &device, &tuned) == ST1WIRE_OK);
+    TEST_CHECK(device.probes > ST1WIRE_CALIBRATION_PROBE_COUNT);
+
+    /* - Reliable minimum plus margin, capped to the default value */
+    TEST_CHECK(tuned.long_pulse == test_capped(test_expected(defaults.long_pulse, defaults.short_pulse + 1, pLimits->long_pulse, ST1WIRE_CALIBRATION_PULSE_STEP), defaults.long_pulse));
+    TEST_CHECK(tuned.inter_byte_delay == test_capped(test_expected(defaults.inter_byte_delay, 0, pLimits->inter_byte_delay, ST1WIRE_CALIBRATION_INTER_BYTE_STEP), defaults.inter_byte_delay));
+    TEST_CHECK(tuned.inter_frame_delay == test_capped(test_expected(defaults.inter_frame_delay, 0, pLimits->inter_frame_delay, ST1WIRE_CALIBRATION_INTER_FRAME_STEP), defaults.inter_frame_delay));
+    TEST_CHECK(tuned.short_pulse == defaults.short_pulse);
+    TEST_CHECK(tuned.ack_pulse == defaults.ack_pulse);
+    TEST_CHECK(tuned.start_pulse == defaults.start_pulse);
+
+    /* - Tuned profile stored for the device */
+    TEST_CHECK(memcmp(st1wire_timing_get(0, 0x20, speed), &tuned, sizeof(tuned)) == 0);
+    TEST_CHECK(st1wire_timing_set(0, 0x20, speed, NULL) == ST1WIRE_OK);
+}
+
+static void test_calibrate_errors(void) {
+    test_device_t deaf = {0xFFFF, 0, 0, 0};
+    st1wire_timing_t timing = *st1wire_timing_get(0, 0, 0);
+    uint8_t i;
+
+    TEST_CHECK(st1wire_calibrate(0, 0x20, 0, NULL, NULL, NULL) == ST1WIRE_INVALID_PARAMETER);
+
+    /* - Device not answering with the default timings : no profile kept */
+    TEST_CHECK(st1wire_calibrate(0, 0x20, 0, test_probe, &deaf, &timing) == ST1WIRE_CALIBRATION_ERROR);
+    TEST_CHECK(deaf.probes == 1);
+    TEST_CHECK(st1wire_timing_get(0, 0x20, 0) == st1wire_timing_get(0, 0, 0));
+
+    /* - No profile slot left for the device */
+    for (i = 0; i < ST1WIRE_TIMING_PROFILE_COUNT; i++) {
+        TEST_CHECK(st1wire_timing_set(2, i, 0, &timing) == ST1WIRE_OK);
+    }
+    deaf.long_pulse = 0;
+    TEST_CHECK(st1wire_calibrate(0, 0x20, 0, test_probe, &deaf, &timing) == ST1WIRE_INVALID_PARAMETER);
+    for (i = 0; i < ST1WIRE_TIMING_PROFILE_COUNT; i++) {
+        TEST_CHECK(st1wire_timing_set(2, i, 0, NULL) == ST1WIRE_OK);
+    }
+}
+
+int main(void) {
+    static const test_device_t slow_device = {9, 60, 333, 0};
+    static const test_device_t fast_device = {3, 5, 0, 0};
+    static const test_device_t limit_device = {ST1WIRE_2C_LONG_PULSE, ST1WIRE_2C_INTER_BYTE_DELAY, ST1WIRE_2C_INTER_FRAME_DELAY, 0};
+
+    sim_reset();
+    st1wire_init();
+
+    test_profiles();
+    test_calibrate(0, &slow_device);
+    test_calibrate(1, &fast_device);
+    test_calibrate(0, &limit_device);
+    test_calibrate_errors();
+
+    return test_report("test_st1wire_timing");
+}